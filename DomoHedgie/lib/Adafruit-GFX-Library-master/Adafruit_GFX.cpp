@@ -193,8 +193,23 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 }
 
 // Bresenham's algorithm - thx wikpedia
+// Each run of pixels along the major axis goes out as one drawFastHLine()
+// or drawFastVLine(), so a subclass that fills those through an address
+// window sets up one per run rather than one per pixel.  The pixels are
+// the same as plotting the line point by point.
 void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
  uint16_t color) {
+  if (x0 == x1) {
+    if (y0 > y1) _swap_int16_t(y0, y1);
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    return;
+  }
+  if (y0 == y1) {
+    if (x0 > x1) _swap_int16_t(x0, x1);
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    return;
+  }
+
   int16_t steep = abs(y1 - y0) > abs(x1 - x0);
   if (steep) {
     _swap_int16_t(x0, y0);
@@ -219,20 +234,31 @@ void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     ystep = -1;
   }
 
-  for (; x0<=x1; x0++) {
-    if (steep) {
-      drawPixel(y0, x0, color);
-    } else {
-      drawPixel(x0, y0, color);
-    }
+  // Pixels start to x0 are in the current run
+  for (int16_t start = x0; x0<=x1; x0++) {
     err -= dy;
-    if (err < 0) {
-      y0 += ystep;
-      err += dx;
+    if ((err < 0) || (x0 == x1)) {
+      if (steep) {
+        drawFastVLine(y0, start, x0 - start + 1, color);
+      } else {
+        drawFastHLine(start, y0, x0 - start + 1, color);
+      }
+      start = x0 + 1;
+      y0   += ystep;
+      err  += dx;
     }
   }
 }
 
+// Connected line segments through n points, (x[0], y[0]) first
+void Adafruit_GFX::drawPolyline(const int16_t *x, const int16_t *y,
+ uint16_t n, uint16_t color) {
+  if (n == 1) drawPixel(x[0], y[0], color);
+  for (uint16_t i=1; i<n; i++) {
+    drawLine(x[i-1], y[i-1], x[i], y[i], color);
+  }
+}
+
 // Draw a rectangle
 void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
  uint16_t color) {
@@ -242,16 +268,17 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
   drawFastVLine(x+w-1, y, h, color);
 }
 
+// drawLine() is built on these two, so they must not call it back
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y,
  int16_t h, uint16_t color) {
   // Update in subclasses if desired!
-  drawLine(x, y, x, y+h-1, color);
+  for (int16_t i=0; i<h; i++) drawPixel(x, y+i, color);
 }
 
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y,
  int16_t w, uint16_t color) {
   // Update in subclasses if desired!
-  drawLine(x, y, x+w-1, y, color);
+  for (int16_t i=0; i<w; i++) drawPixel(x+i, y, color);
 }
 
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
@@ -558,21 +585,16 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
     c -= pgm_read_byte(&gfxFont->first);
     GFXglyph *glyph  = &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
-    uint8_t  *bitmap = (uint8_t *)pgm_read_pointer(&gfxFont->bitmap);
 
-    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
     uint8_t  w  = pgm_read_byte(&glyph->width),
              h  = pgm_read_byte(&glyph->height),
              xa = pgm_read_byte(&glyph->xAdvance);
     int8_t   xo = pgm_read_byte(&glyph->xOffset),
              yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t  xx, yy, bits, bit = 0;
-    int16_t  xo16, yo16;
-
-    if(size > 1) {
-      xo16 = xo;
-      yo16 = yo;
-    }
+    uint8_t  xx, yy, n;
+    int16_t  xo16 = xo, yo16 = yo;
+    boolean  on;
+    GFXglyphRuns runs;
 
     // Todo: Add character clipping here
 
@@ -592,19 +614,18 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     // displays supporting setAddrWindow() and pushColors()), but haven't
     // implemented this yet.
 
+    // Lit pixels go out one horizontal run at a time.
+    runs.begin(gfxFont, glyph);
     for(yy=0; yy<h; yy++) {
-      for(xx=0; xx<w; xx++) {
-        if(!(bit++ & 7)) {
-          bits = pgm_read_byte(&bitmap[bo++]);
-        }
-        if(bits & 0x80) {
+      for(xx=0; xx<w; xx+=n) {
+        n = runs.next(&on);
+        if(on) {
           if(size == 1) {
-            drawPixel(x+xo+xx, y+yo+yy, color);
+            drawFastHLine(x+xo+xx, y+yo+yy, n, color);
           } else {
-            fillRect(x+(xo16+xx)*size, y+(yo16+yy)*size, size, size, color);
+            fillRect(x+(xo16+xx)*size, y+(yo16+yy)*size, n*size, size, color);
           }
         }
-        bits <<= 1;
       }
     }
 
@@ -881,6 +902,61 @@ void Adafruit_GFX::invertDisplay(boolean i) {
   // Do nothing, must be subclassed if supported by hardware
 }
 
+/***************************************************************************/
+// glyph run reader for custom fonts
+
+void GFXglyphRuns::begin(const GFXfont *font, const GFXglyph *glyph) {
+  data   = (const uint8_t *)pgm_read_pointer(&font->bitmap) +
+           pgm_read_word(&glyph->bitmapOffset);
+  format = pgm_read_byte(&font->format);
+  width  = pgm_read_byte(&glyph->width);
+  x      = 0;
+  left   = 0;
+  nbits  = 0;
+  set    = 1; // First RLE run flips this to clear
+}
+
+uint8_t GFXglyphRuns::next(boolean *on) {
+  uint8_t n;
+
+  if(format == GFX_FONT_RLE) {
+    while(!left) { // Zero-length runs only happen at the start of a glyph
+      uint8_t v;
+      do {
+        if(nbits) {
+          v     = bits & 0x0F;
+          nbits = 0;
+        } else {
+          bits  = pgm_read_byte(data++);
+          v     = bits >> 4;
+          nbits = 1;
+        }
+        left += v;
+      } while(v == 15);
+      set = !set;
+    }
+    n = width - x;
+    if(left < n) n = left;
+    left -= n;
+  } else {
+    for(n=0; x+n < width; n++) {
+      if(!nbits) {
+        bits  = pgm_read_byte(data++);
+        nbits = 8;
+      }
+      boolean b = bits & 0x80;
+      if(!n)           set = b;
+      else if(b != set) break;
+      bits <<= 1;
+      nbits--;
+    }
+  }
+
+  if((x += n) >= width) x = 0;
+  *on = set;
+  return n;
+}
+
 /***************************************************************************/
 // code for the GFX button UI element
 
@@ -958,6 +1034,9 @@ boolean Adafruit_GFX_Button::justReleased() { return (!currstate && laststate);
 // boards (recomment, as the text+bitmap draw can be pokey).  GFXcanvas1
 // requires 1 bit per pixel (rounded up to nearest byte per scanline),
 // GFXcanvas16 requires 2 bytes per pixel (no scanline pad).
+// Adafruit_TFTLCD::drawCanvas() sends either kind to the panel through a
+// single address window, so a small canvas can serve as a strip that
+// text or graphics are rendered into and then blitted.
 // NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
 
 GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
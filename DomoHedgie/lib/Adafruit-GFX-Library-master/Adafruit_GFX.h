@@ -28,10 +28,14 @@ class Adafruit_GFX : public Print {
     drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color),
     fillScreen(uint16_t color),
-    invertDisplay(boolean i);
+    invertDisplay(boolean i),
+    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+      uint16_t bg, uint8_t size);
 
   // These exist only with Adafruit_GFX (no subclass overrides)
   void
+    drawPolyline(const int16_t *x, const int16_t *y, uint16_t n,
+      uint16_t color),
     drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color),
     drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
       uint16_t color),
@@ -56,8 +60,6 @@ class Adafruit_GFX : public Print {
       int16_t w, int16_t h, uint16_t color, uint16_t bg),
     drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
       int16_t w, int16_t h, uint16_t color),
-    drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
-      uint16_t bg, uint8_t size),
     setCursor(int16_t x, int16_t y),
     setTextColor(uint16_t c),
     setTextColor(uint16_t c, uint16_t bg),
@@ -104,6 +106,25 @@ class Adafruit_GFX : public Print {
     *gfxFont;
 };
 
+// Walks a custom-font glyph one run of same-valued pixels at a time, for
+// either glyph format (see gfxfont.h).  Runs never cross a row boundary.
+// The reader is a plain value: copy it at the start of a row to replay
+// that row (e.g. for text sizes > 1).
+class GFXglyphRuns {
+
+ public:
+  void    begin(const GFXfont *font, const GFXglyph *glyph);
+  uint8_t next(boolean *set); // Length of next run; *set if pixels lit
+
+ private:
+  const uint8_t *data;
+  uint16_t left;  // RLE: pixels still to come in the current run
+  uint8_t  format, width, x,
+           bits,  // Bitmap: unread bits of the current byte, MSB first
+           nbits, // Bitmap: how many; RLE: 1 if low nibble of bits unread
+           set;
+};
+
 class Adafruit_GFX_Button {
 
  public:
@@ -143,6 +164,8 @@ class GFXcanvas1 : public Adafruit_GFX {
 };
 
 class GFXcanvas16 : public Adafruit_GFX {
+
+ public:
   GFXcanvas16(uint16_t w, uint16_t h);
   ~GFXcanvas16(void);
   void      drawPixel(int16_t x, int16_t y, uint16_t color),
@@ -0,0 +1,453 @@
+const uint8_t FreeSansBold24pt7bRLEBitmaps[] PROGMEM = {
+  0x0F, 0xFF, 0xFF, 0xF8, 0x15, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x33,
+  0x43, 0x43, 0xF8, 0xFF, 0xF4, 0x07, 0x4E, 0x4E, 0x4E, 0x4E, 0x4E, 0x4E,
+  0x47, 0x15, 0x65, 0x25, 0x65, 0x25, 0x65, 0x33, 0x83, 0x43, 0x83, 0x20,
+  0x85, 0x55, 0xB5, 0x55, 0xB5, 0x55, 0xB5, 0x55, 0xB5, 0x45, 0xB5, 0x55,
+  0xB5, 0x55, 0x5F, 0xA1, 0xFA, 0x1F, 0xA1, 0xFA, 0x1F, 0xA6, 0x55, 0x5B,
+  0x55, 0x5B, 0x54, 0x5B, 0x55, 0x5B, 0x55, 0x5B, 0x55, 0x5B, 0x55, 0x56,
+  0xF9, 0x2F, 0x92, 0xF9, 0x2F, 0x92, 0xF9, 0x65, 0x45, 0xB5, 0x55, 0xB5,
+  0x55, 0xB5, 0x55, 0xB5, 0x55, 0xB5, 0x45, 0xB5, 0x55, 0xB5, 0x55, 0xB5,
+  0x55, 0x90, 0xA3, 0xF7, 0x3F, 0x4A, 0xDE, 0xAF, 0x27, 0xF4, 0x5F, 0x64,
+  0x71, 0x32, 0x92, 0x72, 0x33, 0x82, 0x63, 0x34, 0x81, 0x63, 0x35, 0x71,
+  0x63, 0x35, 0x71, 0x63, 0x3D, 0x72, 0x3D, 0x81, 0x3E, 0xBE, 0xCE, 0xEC,
+  0xF1, 0xBF, 0x1B, 0xF0, 0xCE, 0xB3, 0x29, 0xB3, 0x39, 0xA3, 0x4F, 0x03,
+  0x35, 0xE3, 0x35, 0xE3, 0x35, 0xE3, 0x34, 0x81, 0x72, 0x34, 0x72, 0x81,
+  0x32, 0x93, 0xF6, 0x4F, 0x56, 0xF3, 0x9E, 0xD9, 0xF4, 0x3F, 0x73, 0xF7,
+  0x3F, 0x73, 0xC0, 0x65, 0xF0, 0x4D, 0x9D, 0x4C, 0xCA, 0x4C, 0xDA, 0x4B,
+  0xF0, 0x84, 0xC5, 0x55, 0x84, 0xB5, 0x75, 0x64, 0xC4, 0x94, 0x64, 0xC4,
+  0x94, 0x54, 0xD4, 0x94, 0x54, 0xD5, 0x75, 0x44, 0xF0, 0x55, 0x55, 0x4F,
+  0x0F, 0x04, 0x4F, 0x2D, 0x54, 0xF3, 0xB5, 0x4F, 0x59, 0x55, 0xF7, 0x57,
+  0x4F, 0xF4, 0x47, 0x5F, 0x84, 0x59, 0xF5, 0x44, 0xDF, 0x34, 0x4D, 0xF2,
+  0x44, 0xF0, 0xF1, 0x43, 0x65, 0x5F, 0x04, 0x45, 0x75, 0xE4, 0x44, 0x94,
+  0xD4, 0x54, 0x94, 0xD4, 0x54, 0x94, 0xC4, 0x65, 0x75, 0xC4, 0x75, 0x55,
+  0xC4, 0x8F, 0x0C, 0x49, 0xDC, 0x4A, 0xCC, 0x5C, 0x9D, 0x4F, 0x05, 0x60,
+  0xA6, 0xF7, 0x9F, 0x5B, 0xF3, 0xDF, 0x1F, 0x0E, 0x82, 0x6E, 0x74, 0x5E,
+  0x74, 0x5E, 0x74, 0x5E, 0x83, 0x5F, 0x07, 0x25, 0xF1, 0xEF, 0x2C, 0xF4,
+  0xAF, 0x68, 0xF6, 0x8F, 0x5B, 0x65, 0x7D, 0x55, 0x5F, 0x05, 0x54, 0x92,
+  0x63, 0x64, 0x75, 0x62, 0x63, 0x85, 0xD4, 0x77, 0xC4, 0x78, 0xB4, 0x78,
+  0xA5, 0x79, 0x95, 0x88, 0x86, 0x96, 0xA6, 0x94, 0xC5, 0xFA, 0x6F, 0xA6,
+  0xF1, 0x18, 0x6E, 0x38, 0x6C, 0x57, 0x97, 0xF0, 0x0F, 0xFF, 0x41, 0x52,
+  0x52, 0x53, 0x34, 0x32, 0x84, 0x85, 0x75, 0x85, 0x75, 0x76, 0x75, 0x76,
+  0x76, 0x75, 0x76, 0x76, 0x66, 0x76, 0x76, 0x76, 0x66, 0x76, 0x76, 0x76,
+  0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x85, 0x86, 0x76, 0x76, 0x85,
+  0x86, 0x76, 0x85, 0x86, 0x85, 0x86, 0x85, 0x85, 0x95, 0x85, 0x95, 0x94,
+  0x10, 0x14, 0x95, 0x95, 0x85, 0x95, 0x85, 0x95, 0x85, 0x86, 0x85, 0x86,
+  0x76, 0x86, 0x76, 0x76, 0x76, 0x86, 0x76, 0x76, 0x76, 0x76, 0x76, 0x76,
+  0x76, 0x76, 0x76, 0x76, 0x75, 0x76, 0x76, 0x76, 0x75, 0x76, 0x76, 0x75,
+  0x76, 0x75, 0x76, 0x75, 0x76, 0x75, 0x76, 0x75, 0x75, 0x80, 0x63, 0xC3,
+  0xC3, 0xC3, 0x72, 0x33, 0x32, 0x1F, 0xF0, 0x2C, 0x65, 0x97, 0x87, 0x74,
+  0x14, 0x54, 0x34, 0x44, 0x34, 0x61, 0x51, 0x40, 0x95, 0xF3, 0x5F, 0x35,
+  0xF3, 0x5F, 0x35, 0xF3, 0x5F, 0x35, 0xF3, 0x59, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xF3, 0x95, 0xF3, 0x5F, 0x35, 0xF3, 0x5F, 0x35, 0xF3, 0x5F, 0x35, 0xF3,
+  0x59, 0x0F, 0xFF, 0x44, 0x34, 0x34, 0x33, 0x43, 0x31, 0x61, 0x52, 0x34,
+  0x0F, 0xFF, 0xFF, 0x30, 0x0F, 0xFF, 0x40, 0xA3, 0x94, 0x93, 0xA3, 0xA3,
+  0x93, 0xA3, 0xA3, 0x94, 0x93, 0xA3, 0xA3, 0x93, 0xA3, 0xA3, 0x94, 0x93,
+  0xA3, 0x94, 0x93, 0xA3, 0xA3, 0x93, 0xA3, 0xA3, 0x94, 0x93, 0xA3, 0xA3,
+  0x93, 0xA3, 0xA3, 0x94, 0x93, 0xA0, 0x88, 0xEC, 0xAF, 0x17, 0xF3, 0x6F,
+  0x35, 0xF5, 0x48, 0x48, 0x38, 0x68, 0x27, 0x87, 0x27, 0x87, 0x27, 0x87,
+  0x17, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE,
+  0xAE, 0xA7, 0x17, 0x87, 0x27, 0x87, 0x27, 0x87, 0x28, 0x68, 0x38, 0x48,
+  0x4F, 0x55, 0xF3, 0x6F, 0x37, 0xF1, 0xAC, 0xE8, 0x80, 0xA4, 0x95, 0x95,
+  0x86, 0x77, 0x4F, 0xFF, 0xF6, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+  0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+  0x77, 0x77, 0x77, 0x77, 0x78, 0xDD, 0x9F, 0x07, 0xF2, 0x5F, 0x43, 0xF6,
+  0x28, 0x58, 0x18, 0x7F, 0x08, 0xF0, 0x9E, 0x9E, 0x97, 0xF1, 0x7F, 0x17,
+  0xF0, 0x8F, 0x07, 0xF0, 0x8E, 0x8D, 0x9D, 0x9D, 0x8D, 0x9D, 0x8E, 0x8E,
+  0x8E, 0x8F, 0x07, 0xF0, 0x7F, 0x1F, 0x62, 0xF6, 0x1F, 0x71, 0xF7, 0x1F,
+  0x71, 0xF7, 0x78, 0xDD, 0x8F, 0x16, 0xF3, 0x4F, 0x53, 0xF5, 0x38, 0x49,
+  0x18, 0x68, 0x17, 0x87, 0x17, 0x87, 0x17, 0x87, 0xF1, 0x7F, 0x16, 0xF1,
+  0x7F, 0x07, 0xD9, 0xE8, 0xF0, 0x9E, 0xBF, 0x09, 0xF1, 0x7F, 0x18, 0xF1,
+  0x7F, 0x17, 0xF1, 0xE9, 0xE8, 0xF1, 0x78, 0x18, 0x58, 0x2F, 0x62, 0xF5,
+  0x4F, 0x36, 0xF1, 0x9D, 0xC8, 0x80, 0xB8, 0xE8, 0xD9, 0xD9, 0xCA, 0xBB,
+  0xBB, 0xA4, 0x17, 0xA4, 0x17, 0x94, 0x27, 0x84, 0x37, 0x84, 0x37, 0x74,
+  0x47, 0x73, 0x57, 0x64, 0x57, 0x63, 0x67, 0x54, 0x67, 0x44, 0x77, 0x43,
+  0x87, 0x34, 0x87, 0x3F, 0xFF, 0xFF, 0xFF, 0xFC, 0xC7, 0xF0, 0x7F, 0x07,
+  0xF0, 0x7F, 0x07, 0xF0, 0x7F, 0x07, 0x30, 0x3F, 0x44, 0xF4, 0x4F, 0x44,
+  0xF4, 0x3F, 0x53, 0xF5, 0x35, 0xF3, 0x5F, 0x35, 0xF3, 0x4F, 0x35, 0x36,
+  0x95, 0x1B, 0x6F, 0x35, 0xF4, 0x4F, 0x52, 0xF6, 0x27, 0x69, 0xF0, 0x8F,
+  0x18, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x1D, 0x9F, 0x07,
+  0x81, 0x85, 0x91, 0xF6, 0x3F, 0x54, 0xF3, 0x6F, 0x09, 0xDD, 0x79, 0x88,
+  0xDC, 0xAF, 0x07, 0xF1, 0x6F, 0x34, 0xF5, 0x38, 0x48, 0x28, 0x67, 0x27,
+  0xF1, 0x7F, 0x17, 0xF0, 0x7F, 0x17, 0x36, 0x77, 0x1A, 0x5F, 0x53, 0xF6,
+  0x2F, 0x62, 0xA4, 0x81, 0x87, 0x71, 0x87, 0xF0, 0x9E, 0x9E, 0x9E, 0x97,
+  0x16, 0x97, 0x16, 0x97, 0x17, 0x78, 0x17, 0x77, 0x38, 0x39, 0x3F, 0x45,
+  0xF3, 0x5F, 0x27, 0xF0, 0xAC, 0xD7, 0x80, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x3F, 0x16, 0xF1, 0x6F, 0x17, 0xF1, 0x6F, 0x16, 0xF1, 0x7F, 0x16, 0xF1,
+  0x7F, 0x16, 0xF1, 0x6F, 0x17, 0xF1, 0x7F, 0x16, 0xF1, 0x7F, 0x16, 0xF1,
+  0x7F, 0x17, 0xF1, 0x6F, 0x26, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x16, 0xF1,
+  0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xB0, 0x87, 0xF0, 0xCA, 0xF0, 0x8F, 0x26,
+  0xF4, 0x5F, 0x44, 0x85, 0x83, 0x78, 0x63, 0x69, 0x63, 0x6A, 0x53, 0x6A,
+  0x53, 0x69, 0x64, 0x68, 0x55, 0x75, 0x77, 0xF1, 0x9D, 0xAF, 0x17, 0xF3,
+  0x58, 0x48, 0x37, 0x87, 0x27, 0x87, 0x17, 0xAE, 0xAE, 0xAE, 0xAE, 0xAF,
+  0x08, 0xF1, 0x87, 0x28, 0x59, 0x2F, 0x73, 0xF5, 0x5F, 0x37, 0xF1, 0x9D,
+  0xE8, 0x80, 0x88, 0xEC, 0xAF, 0x08, 0xF2, 0x6F, 0x45, 0xF5, 0x39, 0x48,
+  0x37, 0x78, 0x18, 0x87, 0x17, 0xA6, 0x17, 0xA6, 0x17, 0xAE, 0xAE, 0xAE,
+  0xAF, 0x08, 0x81, 0x77, 0x91, 0x94, 0xA1, 0xF8, 0x2F, 0x73, 0xF6, 0x4C,
+  0x17, 0x5A, 0x27, 0x77, 0x36, 0xF3, 0x6F, 0x27, 0xF2, 0x72, 0x77, 0x73,
+  0x85, 0x83, 0xF5, 0x5F, 0x45, 0xF3, 0x7F, 0x1A, 0xCE, 0x89, 0x0F, 0xFF,
+  0x4F, 0xFF, 0xFF, 0x2F, 0xFF, 0x40, 0x0F, 0xFF, 0x4F, 0xFF, 0xFF, 0x2F,
+  0xFF, 0x44, 0x34, 0x34, 0x33, 0x42, 0x41, 0x61, 0x52, 0x34, 0xF7, 0x1F,
+  0x44, 0xF2, 0x6E, 0x9B, 0xC9, 0xE6, 0xE6, 0xE7, 0xD9, 0xBC, 0x8F, 0x05,
+  0xF3, 0x7F, 0x1A, 0xDD, 0xDD, 0xCE, 0xCE, 0xCC, 0xDA, 0xF1, 0x7F, 0x44,
+  0xF7, 0x10, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x01, 0xF7, 0x3F, 0x56, 0xF2, 0x9E,
+  0xBC, 0xEC, 0xEC, 0xDD, 0xDD, 0xBF, 0x08, 0xF2, 0x6F, 0x08, 0xCB, 0xAD,
+  0x7D, 0x7D, 0x7E, 0x8C, 0xB9, 0xE7, 0xF1, 0x4F, 0x41, 0xF7, 0x78, 0xED,
+  0x9F, 0x26, 0xF4, 0x5F, 0x53, 0xF6, 0x38, 0x59, 0x27, 0x78, 0x18, 0x8F,
+  0x0A, 0xEA, 0xEA, 0x7F, 0x27, 0xF1, 0x8F, 0x08, 0xF0, 0x9E, 0x9E, 0x9D,
+  0xAE, 0x9E, 0x8F, 0x17, 0xF1, 0x7F, 0x26, 0xF3, 0x6F, 0xFF, 0xFF, 0xF0,
+  0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x79, 0xF4, 0x9F,
+  0xF0, 0xF2, 0xF9, 0xF6, 0xF5, 0xFA, 0xF2, 0x98, 0xAE, 0x8E, 0x8C, 0x8F,
+  0x27, 0xA7, 0xF5, 0x78, 0x7F, 0x85, 0x86, 0xFA, 0x56, 0x6F, 0xB5, 0x56,
+  0xB6, 0x34, 0x45, 0x45, 0xA9, 0x15, 0x54, 0x36, 0x8F, 0x25, 0x43, 0x58,
+  0x64, 0x77, 0x41, 0x67, 0x66, 0x67, 0x41, 0x58, 0x58, 0x57, 0x41, 0x57,
+  0x59, 0x48, 0xA7, 0x4A, 0x48, 0x97, 0x5A, 0x48, 0x97, 0x4B, 0x48, 0x97,
+  0x4B, 0x38, 0xA6, 0x5A, 0x48, 0xA6, 0x5A, 0x48, 0x41, 0x56, 0x5A, 0x38,
+  0x51, 0x56, 0x59, 0x48, 0x42, 0x65, 0x58, 0x57, 0x53, 0x55, 0x66, 0x66,
+  0x54, 0x56, 0x64, 0x83, 0x74, 0x65, 0xFC, 0x66, 0x5C, 0x1C, 0x77, 0x5A,
+  0x39, 0xA7, 0x66, 0x75, 0xD7, 0xFF, 0x77, 0xFF, 0x78, 0xFF, 0x6A, 0xC2,
+  0xF5, 0xF9, 0xF6, 0xF7, 0xF8, 0xF4, 0xFD, 0xBF, 0x10, 0xC9, 0xF8, 0x9F,
+  0x89, 0xF7, 0xBF, 0x6B, 0xF6, 0xBF, 0x5D, 0xF4, 0xDF, 0x46, 0x16, 0xF3,
+  0x71, 0x7F, 0x27, 0x17, 0xF2, 0x63, 0x6F, 0x17, 0x37, 0xF0, 0x73, 0x7E,
+  0x75, 0x6E, 0x75, 0x7D, 0x66, 0x7C, 0x77, 0x7B, 0x77, 0x7B, 0x68, 0x7A,
+  0x79, 0x79, 0xF8, 0x9F, 0x88, 0xFA, 0x7F, 0xA6, 0xFB, 0x6F, 0xC5, 0x7D,
+  0x74, 0x7E, 0x74, 0x7F, 0x07, 0x37, 0xF0, 0x72, 0x7F, 0x17, 0x27, 0xF2,
+  0x71, 0x7F, 0x27, 0x0F, 0x48, 0xF7, 0x5F, 0x84, 0xF9, 0x3F, 0xA2, 0xFA,
+  0x27, 0xA9, 0x17, 0xB8, 0x17, 0xC7, 0x17, 0xC7, 0x17, 0xC7, 0x17, 0xB7,
+  0x27, 0xA8, 0x2F, 0x93, 0xF8, 0x4F, 0x66, 0xF8, 0x4F, 0x93, 0xFA, 0x27,
+  0xB8, 0x17, 0xC7, 0x17, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xCF, 0x0B, 0x81,
+  0xFB, 0x1F, 0xA2, 0xFA, 0x2F, 0x93, 0xF7, 0x5F, 0x48, 0xB9, 0xF3, 0xF0,
+  0xEF, 0x3A, 0xF6, 0x8F, 0x87, 0xF9, 0x5A, 0x69, 0x49, 0xA8, 0x38, 0xB8,
+  0x28, 0xD7, 0x28, 0xE7, 0x17, 0xF0, 0x71, 0x7F, 0x77, 0xF8, 0x7F, 0x87,
+  0xF8, 0x7F, 0x87, 0xF8, 0x7F, 0x87, 0xF8, 0x7F, 0x87, 0xF8, 0x7F, 0x97,
+  0xF8, 0x7F, 0x07, 0x17, 0xF0, 0x71, 0x8D, 0x82, 0x8C, 0x73, 0x9A, 0x84,
+  0xA6, 0x96, 0xF9, 0x6F, 0x88, 0xF6, 0xBF, 0x3D, 0xF0, 0xF3, 0x9A, 0x0F,
+  0x3A, 0xF6, 0x7F, 0x76, 0xF8, 0x5F, 0x94, 0xFA, 0x37, 0x9A, 0x27, 0xB8,
+  0x27, 0xC8, 0x17, 0xC8, 0x17, 0xD7, 0x17, 0xD7, 0x17, 0xEE, 0xEE, 0xEE,
+  0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xD7, 0x17, 0xD7, 0x17, 0xC8,
+  0x17, 0xC8, 0x17, 0xB8, 0x27, 0x9A, 0x2F, 0xA3, 0xF9, 0x4F, 0x85, 0xF7,
+  0x6F, 0x67, 0xF3, 0xA0, 0x0F, 0x91, 0xF9, 0x1F, 0x91, 0xF9, 0x1F, 0x91,
+  0xF9, 0x17, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3,
+  0xF8, 0x2F, 0x82, 0xF8, 0x2F, 0x82, 0xF8, 0x2F, 0x82, 0x7F, 0x37, 0xF3,
+  0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x3F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xF0, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF1, 0xF2, 0x7F,
+  0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0xF7, 0x2F, 0x72, 0xF7,
+  0x2F, 0x72, 0xF7, 0x2F, 0x72, 0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F,
+  0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F, 0x27, 0xF2, 0x7F,
+  0x27, 0xF2, 0x7F, 0x20, 0xC9, 0xF4, 0xF0, 0xEF, 0x4B, 0xF6, 0x9F, 0x87,
+  0xFA, 0x5A, 0x7A, 0x48, 0xB8, 0x38, 0xD7, 0x37, 0xF0, 0x71, 0x8F, 0x07,
+  0x17, 0xF9, 0x7F, 0x87, 0xF9, 0x7F, 0x97, 0xF9, 0x7B, 0xF5, 0xBF, 0x5B,
+  0xF5, 0xBF, 0x5B, 0xF5, 0xBF, 0x6F, 0x26, 0x17, 0xF2, 0x61, 0x7F, 0x26,
+  0x18, 0xF0, 0x72, 0x8E, 0x72, 0x9C, 0x83, 0x9A, 0x93, 0xB5, 0xC4, 0xFC,
+  0x5F, 0x51, 0x56, 0xF4, 0x24, 0x7F, 0x23, 0x49, 0xD5, 0x4C, 0x8B, 0x07,
+  0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE,
+  0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBD, 0xED, 0xED, 0xED, 0xED, 0xED,
+  0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0x70, 0x0F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xD0, 0xF0, 0x7F, 0x07, 0xF0, 0x7F,
+  0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F,
+  0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F, 0x07, 0xF0, 0x7F,
+  0x07, 0xF0, 0x7F, 0x0E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8F, 0x06, 0xF2, 0x49,
+  0x1F, 0x52, 0xF5, 0x3F, 0x35, 0xF1, 0x7E, 0xB8, 0x70, 0x07, 0xD8, 0x27,
+  0xC8, 0x37, 0xB8, 0x47, 0xA8, 0x57, 0x99, 0x57, 0x89, 0x67, 0x88, 0x77,
+  0x78, 0x87, 0x68, 0x97, 0x58, 0xA7, 0x48, 0xB7, 0x38, 0xC7, 0x28, 0xD7,
+  0x18, 0xEF, 0x0F, 0x0F, 0x1E, 0xF1, 0xEF, 0x2D, 0xF3, 0xCA, 0x18, 0xB9,
+  0x38, 0xA8, 0x48, 0xA7, 0x68, 0x97, 0x78, 0x87, 0x88, 0x77, 0x89, 0x67,
+  0x98, 0x67, 0xA8, 0x57, 0xB8, 0x47, 0xB9, 0x37, 0xC8, 0x37, 0xD8, 0x27,
+  0xE8, 0x17, 0xE9, 0x07, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F,
+  0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F,
+  0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F,
+  0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x1F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x30, 0x0B, 0xBF, 0x7B, 0xF7, 0xBF, 0x7B, 0xF7, 0xAF, 0x99,
+  0xF9, 0x9F, 0x99, 0xF9, 0x9F, 0xA7, 0xF5, 0x15, 0x75, 0x1E, 0x15, 0x75,
+  0x1E, 0x15, 0x75, 0x1E, 0x15, 0x66, 0x1E, 0x16, 0x55, 0x2E, 0x25, 0x55,
+  0x2E, 0x25, 0x55, 0x2E, 0x25, 0x55, 0x2E, 0x26, 0x35, 0x3E, 0x35, 0x35,
+  0x3E, 0x35, 0x35, 0x3E, 0x35, 0x35, 0x3E, 0x36, 0x25, 0x3E, 0x45, 0x15,
+  0x4E, 0x45, 0x15, 0x4E, 0x45, 0x15, 0x4E, 0x45, 0x15, 0x4E, 0x4A, 0x5E,
+  0x59, 0x5E, 0x59, 0x5E, 0x59, 0x5E, 0x59, 0x5E, 0x67, 0x6E, 0x67, 0x67,
+  0x07, 0xEF, 0x0D, 0xF1, 0xCF, 0x1C, 0xF2, 0xBF, 0x2B, 0xF3, 0xAF, 0x49,
+  0xF4, 0x9F, 0x58, 0xF5, 0x8E, 0x16, 0x7E, 0x17, 0x6E, 0x26, 0x6E, 0x27,
+  0x5E, 0x36, 0x5E, 0x46, 0x4E, 0x47, 0x3E, 0x56, 0x3E, 0x57, 0x2E, 0x66,
+  0x2E, 0x76, 0x1E, 0x7F, 0x68, 0xF5, 0x8F, 0x59, 0xF4, 0xAF, 0x3A, 0xF3,
+  0xBF, 0x2B, 0xF2, 0xCF, 0x1D, 0xF0, 0xDF, 0x0E, 0x70, 0xC9, 0xF6, 0xF0,
+  0xF1, 0xF3, 0xEF, 0x6B, 0xF8, 0x9F, 0xA7, 0xA7, 0xA6, 0x8A, 0x95, 0x8D,
+  0x84, 0x7F, 0x07, 0x38, 0xF0, 0x82, 0x7F, 0x27, 0x27, 0xF2, 0x71, 0x8F,
+  0x2F, 0x0F, 0x4E, 0xF4, 0xEF, 0x4E, 0xF4, 0xEF, 0x4E, 0xF4, 0xEF, 0x4E,
+  0xF4, 0xF0, 0xF2, 0x81, 0x7F, 0x27, 0x27, 0xF2, 0x72, 0x8F, 0x08, 0x37,
+  0xF0, 0x74, 0x8D, 0x85, 0x8B, 0x86, 0xA7, 0xA7, 0xFA, 0x9F, 0x8B, 0xF6,
+  0xDF, 0x4F, 0x1F, 0x0F, 0x69, 0xC0, 0x0F, 0x47, 0xF7, 0x4F, 0x83, 0xF9,
+  0x2F, 0xA1, 0xFA, 0x17, 0x99, 0x17, 0xBF, 0x0C, 0xEC, 0xEC, 0xEC, 0xEC,
+  0xEC, 0xEB, 0xF0, 0x99, 0x1F, 0xA1, 0xF9, 0x2F, 0x92, 0xF8, 0x3F, 0x65,
+  0xF4, 0x77, 0xF4, 0x7F, 0x47, 0xF4, 0x7F, 0x47, 0xF4, 0x7F, 0x47, 0xF4,
+  0x7F, 0x47, 0xF4, 0x7F, 0x47, 0xF4, 0x7F, 0x40, 0xC9, 0xF6, 0xF0, 0xF1,
+  0xF3, 0xEF, 0x6B, 0xF8, 0x9F, 0xA7, 0xA7, 0xA6, 0x8B, 0x85, 0x8D, 0x84,
+  0x7F, 0x07, 0x38, 0xF0, 0x82, 0x7F, 0x27, 0x27, 0xF2, 0x71, 0x8F, 0x2F,
+  0x0F, 0x4E, 0xF4, 0xEF, 0x4E, 0xF4, 0xEF, 0x4E, 0xF4, 0xEF, 0x4E, 0xF4,
+  0xF0, 0xC1, 0x48, 0x17, 0xB3, 0x37, 0x27, 0xA5, 0x27, 0x28, 0x8F, 0x03,
+  0x79, 0xD4, 0x89, 0xC5, 0x89, 0xA6, 0xA7, 0xA7, 0xFB, 0x8F, 0xB8, 0xFB,
+  0x8F, 0xB9, 0xF0, 0x26, 0xD9, 0x64, 0xFF, 0x02, 0x30, 0x0F, 0x67, 0xF8,
+  0x5F, 0xA3, 0xFA, 0x3F, 0xB2, 0xFB, 0x27, 0xB9, 0x17, 0xC8, 0x17, 0xD7,
+  0x17, 0xD7, 0x17, 0xD7, 0x17, 0xD7, 0x17, 0xD7, 0x17, 0xC7, 0x27, 0xB8,
+  0x2F, 0xA3, 0xF9, 0x4F, 0x76, 0xF8, 0x5F, 0x94, 0xFA, 0x37, 0xA8, 0x37,
+  0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27,
+  0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27, 0xC7, 0x27, 0xC8, 0x17, 0xD8, 0x8A,
+  0xF1, 0xF0, 0xBF, 0x48, 0xF6, 0x6F, 0x84, 0xFA, 0x39, 0x6A, 0x28, 0xA9,
+  0x17, 0xC8, 0x17, 0xD7, 0x17, 0xD7, 0x17, 0xF6, 0x8F, 0x5A, 0xF4, 0xDF,
+  0x0F, 0x3B, 0xF5, 0x9F, 0x69, 0xF6, 0xAF, 0x4E, 0xEF, 0x4A, 0xF5, 0x8F,
+  0x58, 0xF6, 0xEE, 0xEE, 0xED, 0xF1, 0xC7, 0x29, 0x89, 0x2F, 0xB3, 0xF9,
+  0x5F, 0x77, 0xF5, 0xAF, 0x1F, 0x0A, 0x90, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFC, 0xA7, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5,
+  0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5,
+  0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5,
+  0x7F, 0x57, 0xF5, 0x7F, 0x57, 0xF5, 0x7A, 0x07, 0xDE, 0xDE, 0xDE, 0xDE,
+  0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE,
+  0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDF, 0x0B, 0x81,
+  0x89, 0x82, 0x97, 0x93, 0xF8, 0x4F, 0x85, 0xF6, 0x7F, 0x4A, 0xF0, 0xF0,
+  0x99, 0x07, 0xF0, 0xEF, 0x07, 0x17, 0xD7, 0x27, 0xD7, 0x27, 0xD7, 0x37,
+  0xC6, 0x47, 0xB7, 0x47, 0xB7, 0x57, 0xA6, 0x67, 0x97, 0x76, 0x97, 0x76,
+  0x96, 0x87, 0x77, 0x96, 0x77, 0x96, 0x76, 0xA7, 0x66, 0xB6, 0x57, 0xB6,
+  0x56, 0xC7, 0x46, 0xD6, 0x36, 0xE6, 0x36, 0xE6, 0x36, 0xF0, 0x62, 0x5F,
+  0x16, 0x16, 0xF1, 0x61, 0x6F, 0x2B, 0xF3, 0xBF, 0x3B, 0xF4, 0x9F, 0x59,
+  0xF5, 0x9F, 0x67, 0xF7, 0x7F, 0x77, 0xB0, 0x08, 0xA7, 0xAF, 0x1A, 0x7A,
+  0x81, 0x79, 0x8A, 0x72, 0x79, 0x99, 0x72, 0x79, 0x99, 0x73, 0x78, 0x98,
+  0x83, 0x78, 0x98, 0x74, 0x77, 0xB7, 0x74, 0x77, 0x51, 0x57, 0x75, 0x67,
+  0x51, 0x57, 0x66, 0x76, 0x51, 0x56, 0x76, 0x76, 0x51, 0x56, 0x77, 0x65,
+  0x62, 0x55, 0x77, 0x65, 0x53, 0x55, 0x68, 0x65, 0x53, 0x55, 0x68, 0x74,
+  0x53, 0x54, 0x79, 0x64, 0x54, 0x53, 0x6A, 0x63, 0x64, 0x53, 0x6A, 0x63,
+  0x55, 0x53, 0x6B, 0x62, 0x55, 0x53, 0x6B, 0x62, 0x55, 0x52, 0x6C, 0x62,
+  0x56, 0x51, 0x6C, 0x61, 0x57, 0x51, 0x6D, 0x51, 0x57, 0x51, 0x6D, 0xB7,
+  0x51, 0x5E, 0xB7, 0xBF, 0x0A, 0x8A, 0xF0, 0x99, 0x9F, 0x19, 0x99, 0xF1,
+  0x99, 0x9F, 0x28, 0xA8, 0xF2, 0x8A, 0x7F, 0x37, 0xB7, 0xF4, 0x6B, 0x79,
+  0x18, 0xC8, 0x29, 0xA8, 0x48, 0xA8, 0x58, 0x88, 0x68, 0x87, 0x88, 0x68,
+  0x88, 0x58, 0xA8, 0x48, 0xB7, 0x38, 0xC8, 0x27, 0xE7, 0x18, 0xF0, 0xEF,
+  0x1D, 0xF3, 0xCF, 0x3B, 0xF5, 0x9F, 0x78, 0xF6, 0x9F, 0x6A, 0xF4, 0xBF,
+  0x4C, 0xF2, 0xEF, 0x0F, 0x0F, 0x07, 0x18, 0xD7, 0x38, 0xB8, 0x47, 0xB7,
+  0x58, 0x98, 0x68, 0x78, 0x78, 0x78, 0x88, 0x58, 0x98, 0x58, 0xA8, 0x38,
+  0xB9, 0x19, 0xC8, 0x10, 0x08, 0xDF, 0x1C, 0x82, 0x8B, 0x82, 0x8A, 0x84,
+  0x89, 0x85, 0x79, 0x76, 0x78, 0x87, 0x77, 0x78, 0x76, 0x89, 0x75, 0x7A,
+  0x74, 0x8B, 0x73, 0x7C, 0x73, 0x7D, 0x71, 0x7E, 0x71, 0x7F, 0x0D, 0xF1,
+  0xDF, 0x2B, 0xF3, 0xAF, 0x59, 0xF6, 0x7F, 0x77, 0xF7, 0x7F, 0x77, 0xF7,
+  0x7F, 0x77, 0xF7, 0x7F, 0x77, 0xF7, 0x7F, 0x77, 0xF7, 0x7F, 0x77, 0xF7,
+  0x7F, 0x77, 0xB0, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xF6, 0xF3, 0x8F, 0x28,
+  0xF2, 0x8F, 0x28, 0xF2, 0x9F, 0x28, 0xF2, 0x8F, 0x28, 0xF2, 0x8F, 0x29,
+  0xF2, 0x8F, 0x28, 0xF2, 0x8F, 0x28, 0xF2, 0x9F, 0x28, 0xF2, 0x8F, 0x28,
+  0xF2, 0x8F, 0x29, 0xF2, 0x8F, 0x28, 0xF2, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x60, 0x0F, 0xFF, 0xF2, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47,
+  0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47,
+  0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47, 0x47,
+  0x4F, 0xFF, 0xA0, 0x03, 0xB4, 0xB3, 0xB3, 0xB4, 0xB3, 0xB3, 0xB4, 0xB3,
+  0xB3, 0xB4, 0xB3, 0xB3, 0xB3, 0xC3, 0xB3, 0xB3, 0xC3, 0xB3, 0xB3, 0xC3,
+  0xB3, 0xB3, 0xB4, 0xB3, 0xB3, 0xB4, 0xB3, 0xB3, 0xB4, 0xB3, 0xB3, 0xB4,
+  0xB3, 0x0F, 0xFF, 0xA4, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74,
+  0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74,
+  0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74, 0x74,
+  0xFF, 0xFF, 0x20, 0x86, 0xF0, 0x7F, 0x07, 0xE9, 0xD9, 0xDA, 0xB5, 0x15,
+  0xB5, 0x15, 0xA6, 0x16, 0x95, 0x35, 0x95, 0x36, 0x76, 0x45, 0x75, 0x55,
+  0x66, 0x56, 0x55, 0x75, 0x55, 0x76, 0x36, 0x85, 0x35, 0x95, 0x35, 0x96,
+  0x15, 0xB5, 0x10, 0x0F, 0xFF, 0xFF, 0xFF, 0x70, 0x06, 0x45, 0x55, 0x54,
+  0x64, 0x63, 0x64, 0x79, 0xCE, 0x9F, 0x26, 0xF4, 0x4F, 0x54, 0xF6, 0x37,
+  0x68, 0x36, 0x87, 0xF2, 0x7F, 0x18, 0xEA, 0x8F, 0x15, 0xF4, 0x4F, 0x53,
+  0x95, 0x72, 0x87, 0x72, 0x78, 0x72, 0x77, 0x82, 0x77, 0x82, 0x85, 0x92,
+  0xF7, 0x3F, 0x63, 0xF6, 0x4C, 0x18, 0x49, 0x48, 0x56, 0xD0, 0x07, 0xF3,
+  0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3,
+  0x74, 0x68, 0x72, 0xA6, 0x71, 0xD4, 0xF7, 0x3F, 0x73, 0xF8, 0x2A, 0x59,
+  0x19, 0x78, 0x18, 0x97, 0x18, 0x9F, 0x0B, 0xEB, 0xEB, 0xEB, 0xEB, 0xEB,
+  0xF0, 0x9F, 0x19, 0x71, 0x97, 0x81, 0xA5, 0x91, 0xF8, 0x2F, 0x73, 0xF7,
+  0x37, 0x1D, 0x47, 0x2A, 0xF2, 0x68, 0x88, 0xDD, 0x8F, 0x16, 0xF3, 0x4F,
+  0x53, 0xF5, 0x29, 0x58, 0x18, 0x77, 0x17, 0x9D, 0xF1, 0x7F, 0x17, 0xF1,
+  0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x27, 0x96, 0x18, 0x77, 0x19,
+  0x58, 0x2F, 0x53, 0xF5, 0x4F, 0x36, 0xF1, 0x9D, 0xC8, 0x70, 0xF3, 0x7F,
+  0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x78,
+  0x64, 0x76, 0xA2, 0x74, 0xD1, 0x73, 0xF7, 0x3F, 0x72, 0xF8, 0x19, 0x5A,
+  0x18, 0x79, 0x17, 0x9F, 0x19, 0xF0, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBF,
+  0x09, 0x81, 0x79, 0x81, 0x87, 0x91, 0x95, 0xA2, 0xF8, 0x2F, 0x83, 0xF7,
+  0x4D, 0x17, 0x6A, 0x27, 0x86, 0xB0, 0x87, 0xF0, 0xBB, 0xF0, 0x8F, 0x26,
+  0xF4, 0x58, 0x47, 0x48, 0x76, 0x37, 0x86, 0x37, 0x95, 0x27, 0xA6, 0x17,
+  0xA6, 0x1F, 0x81, 0xF8, 0x1F, 0x81, 0xF8, 0x17, 0xF2, 0x7F, 0x27, 0xF3,
+  0x79, 0x71, 0x78, 0x73, 0x85, 0x83, 0xF5, 0x5F, 0x37, 0xF1, 0xAC, 0xE8,
+  0x80, 0x77, 0x59, 0x4A, 0x4A, 0x3B, 0x38, 0x67, 0x77, 0x77, 0x77, 0x4D,
+  0x1D, 0x1D, 0x1D, 0x47, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+  0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x40,
+  0x85, 0x47, 0x5A, 0x27, 0x4C, 0x17, 0x3D, 0x17, 0x2F, 0x72, 0xF7, 0x19,
+  0x4A, 0x18, 0x69, 0x17, 0x8F, 0x18, 0xF0, 0xAE, 0xAE, 0xAE, 0xAE, 0xAE,
+  0xAE, 0x9F, 0x18, 0x81, 0x86, 0x91, 0x94, 0xA2, 0xF7, 0x2F, 0x73, 0xF6,
+  0x4C, 0x17, 0x5A, 0x27, 0x76, 0x47, 0xF2, 0x7F, 0x27, 0xF2, 0x71, 0x78,
+  0x81, 0x77, 0x82, 0x94, 0x93, 0xF5, 0x5F, 0x37, 0xF0, 0xC9, 0x80, 0x07,
+  0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17,
+  0xF1, 0x74, 0x75, 0x73, 0xA3, 0x71, 0xD2, 0x71, 0xE1, 0xF7, 0x1F, 0xF3,
+  0x4F, 0x27, 0xF1, 0x8E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E,
+  0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x97, 0x0F, 0xFC, 0xF6, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xFF,
+  0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+  0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+  0x37, 0x37, 0x37, 0x37, 0x37, 0x3F, 0xFF, 0x11, 0x91, 0x73, 0x07, 0xF1,
+  0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1, 0x7F, 0x17, 0xF1,
+  0x78, 0x71, 0x77, 0x72, 0x76, 0x82, 0x75, 0x83, 0x74, 0x84, 0x74, 0x75,
+  0x73, 0x76, 0x72, 0x77, 0x71, 0x78, 0xE9, 0xF0, 0x8F, 0x08, 0xF1, 0x7F,
+  0x26, 0x91, 0x76, 0x82, 0x85, 0x74, 0x75, 0x75, 0x74, 0x75, 0x83, 0x76,
+  0x73, 0x76, 0x82, 0x77, 0x72, 0x77, 0x81, 0x78, 0x71, 0x78, 0x80, 0x0F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xD0, 0x07, 0x46, 0x86, 0x57,
+  0x2A, 0x4A, 0x37, 0x1C, 0x2C, 0x2F, 0xF5, 0x1F, 0xF5, 0x1F, 0xFF, 0x05,
+  0xA4, 0xF1, 0x78, 0x6E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E,
+  0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E,
+  0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E, 0x87, 0x7E,
+  0x87, 0x77, 0x07, 0x47, 0x57, 0x2B, 0x37, 0x1D, 0x2F, 0x71, 0xF7, 0x1F,
+  0xF3, 0x4F, 0x27, 0xF0, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E,
+  0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x97, 0x98, 0xED, 0xBF,
+  0x18, 0xF3, 0x6F, 0x54, 0xF6, 0x39, 0x59, 0x28, 0x78, 0x27, 0x97, 0x18,
+  0x9F, 0x0B, 0xEB, 0xEB, 0xEB, 0xEB, 0xEB, 0xF0, 0x98, 0x17, 0x97, 0x28,
+  0x78, 0x29, 0x59, 0x3F, 0x65, 0xF5, 0x6F, 0x38, 0xF1, 0xAD, 0xF0, 0x88,
+  0x07, 0x46, 0x87, 0x2A, 0x67, 0x1D, 0x47, 0x1E, 0x3F, 0x73, 0xF8, 0x2A,
+  0x59, 0x19, 0x78, 0x18, 0x97, 0x18, 0x9F, 0x0B, 0xEB, 0xEB, 0xEB, 0xEB,
+  0xEB, 0xF0, 0x9F, 0x19, 0x71, 0x97, 0x81, 0xA5, 0x82, 0xF8, 0x2F, 0x73,
+  0x71, 0xD4, 0x71, 0xD4, 0x72, 0xA6, 0x74, 0x68, 0x7F, 0x37, 0xF3, 0x7F,
+  0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x86,
+  0x47, 0x6A, 0x27, 0x4D, 0x17, 0x4D, 0x17, 0x3F, 0x72, 0xF8, 0x19, 0x5A,
+  0x18, 0x79, 0x17, 0x9F, 0x19, 0xF0, 0xBE, 0xBE, 0xBE, 0xBE, 0xBE, 0xBF,
+  0x09, 0x81, 0x79, 0x81, 0x87, 0x91, 0x95, 0xA2, 0xF8, 0x3F, 0x73, 0xE1,
+  0x74, 0xD1, 0x76, 0xA2, 0x78, 0x64, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3,
+  0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x7F, 0x37, 0xF3, 0x70, 0x07, 0x4B,
+  0x3C, 0x1E, 0x1F, 0xFF, 0x25, 0x87, 0x87, 0x78, 0x78, 0x78, 0x78, 0x78,
+  0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x78, 0x88,
+  0xDE, 0x9F, 0x26, 0xF4, 0x4F, 0x53, 0x86, 0x82, 0x78, 0x72, 0x78, 0x72,
+  0x9F, 0x0D, 0xBF, 0x19, 0xF3, 0x7F, 0x47, 0xF3, 0xAE, 0xDC, 0xF0, 0x9F,
+  0x2E, 0xA7, 0x17, 0x97, 0x18, 0x68, 0x2F, 0x73, 0xF5, 0x5F, 0x37, 0xF1,
+  0xBA, 0x70, 0x27, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x3F, 0xFF, 0x32,
+  0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75, 0x75,
+  0x75, 0x75, 0x75, 0x75, 0xA2, 0xA3, 0x94, 0x85, 0x70, 0x07, 0x9E, 0x9E,
+  0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E, 0x9E,
+  0x9E, 0x9E, 0x9E, 0x8F, 0x17, 0xF2, 0x4F, 0xF3, 0x1F, 0x71, 0xE1, 0x72,
+  0xD1, 0x73, 0xB2, 0x75, 0x7B, 0x17, 0xA7, 0x17, 0xA6, 0x27, 0x97, 0x36,
+  0x97, 0x37, 0x86, 0x47, 0x77, 0x56, 0x77, 0x57, 0x66, 0x67, 0x66, 0x76,
+  0x57, 0x77, 0x46, 0x96, 0x46, 0x96, 0x46, 0x96, 0x36, 0xB6, 0x26, 0xB6,
+  0x26, 0xB6, 0x16, 0xDC, 0xDC, 0xDB, 0xF0, 0xAF, 0x0A, 0xF0, 0x9F, 0x28,
+  0xF2, 0x79, 0x06, 0x87, 0x7E, 0x77, 0x7E, 0x77, 0x76, 0x26, 0x69, 0x66,
+  0x26, 0x69, 0x57, 0x27, 0x59, 0x57, 0x27, 0x59, 0x56, 0x46, 0x54, 0x14,
+  0x56, 0x46, 0x45, 0x15, 0x37, 0x47, 0x35, 0x15, 0x36, 0x66, 0x35, 0x15,
+  0x36, 0x66, 0x35, 0x15, 0x36, 0x66, 0x25, 0x34, 0x36, 0x66, 0x25, 0x35,
+  0x16, 0x86, 0x15, 0x35, 0x16, 0x86, 0x15, 0x35, 0x16, 0x86, 0x14, 0x45,
+  0x15, 0xAA, 0x5A, 0xAA, 0x5A, 0xAA, 0x5A, 0xA9, 0x69, 0xC8, 0x69, 0xC8,
+  0x78, 0xC8, 0x77, 0xE7, 0x77, 0x70, 0x08, 0x88, 0x18, 0x68, 0x37, 0x67,
+  0x48, 0x48, 0x57, 0x47, 0x77, 0x27, 0x87, 0x18, 0x9E, 0xBC, 0xCC, 0xDA,
+  0xF0, 0x8F, 0x18, 0xF0, 0x9F, 0x0A, 0xDC, 0xBD, 0xBE, 0x97, 0x27, 0x78,
+  0x27, 0x77, 0x47, 0x58, 0x48, 0x38, 0x67, 0x37, 0x78, 0x18, 0x88, 0x17,
+  0xA7, 0x17, 0xA7, 0x17, 0xA6, 0x37, 0x96, 0x37, 0x87, 0x37, 0x86, 0x57,
+  0x76, 0x57, 0x67, 0x66, 0x66, 0x77, 0x56, 0x77, 0x56, 0x86, 0x46, 0x96,
+  0x46, 0x97, 0x36, 0xA6, 0x26, 0xB6, 0x26, 0xB7, 0x16, 0xC6, 0x15, 0xDC,
+  0xDC, 0xEA, 0xF0, 0xAF, 0x0A, 0xF1, 0x8F, 0x28, 0xF3, 0x7F, 0x36, 0xF4,
+  0x6F, 0x46, 0xF3, 0x6F, 0x37, 0xEA, 0xF0, 0xAF, 0x09, 0xF1, 0x8F, 0x26,
+  0xF0, 0x1F, 0x51, 0xF5, 0x1F, 0x51, 0xF5, 0x1F, 0x51, 0xF5, 0xC9, 0xB9,
+  0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xCF,
+  0xFF, 0xFF, 0xFF, 0xF6, 0x76, 0x67, 0x58, 0x58, 0x49, 0x46, 0x75, 0x85,
+  0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x76,
+  0x48, 0x57, 0x67, 0x68, 0x86, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85,
+  0x85, 0x85, 0x85, 0x85, 0x85, 0x86, 0x79, 0x58, 0x58, 0x67, 0x76, 0x0F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xB0, 0x06, 0x77, 0x68, 0x58, 0x59, 0x76,
+  0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85,
+  0x85, 0x86, 0x88, 0x67, 0x67, 0x58, 0x46, 0x75, 0x85, 0x85, 0x85, 0x85,
+  0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x76, 0x49, 0x48, 0x58, 0x57,
+  0x66, 0x70, 0x35, 0xE9, 0xCA, 0x7F, 0x14, 0x84, 0xF1, 0x7A, 0xC8, 0xF0,
+  0x53 };
+
+const GFXglyph FreeSansBold24pt7bRLEGlyphs[] PROGMEM = {
+  {     0,   0,   0,  13,    0,    1 },   // 0x20 ' '
+  {     0,   7,  34,  16,    5,  -33 },   // 0x21 '!'
+  {    17,  18,  12,  22,    2,  -33 },   // 0x22 '"'
+  {    36,  26,  33,  26,    0,  -31 },   // 0x23 '#'
+  {    98,  25,  40,  26,    1,  -34 },   // 0x24 '$'
+  {   171,  39,  34,  42,    1,  -32 },   // 0x25 '%'
+  {   264,  30,  35,  34,    3,  -33 },   // 0x26 '&'
+  {   332,   7,  12,  12,    3,  -33 },   // 0x27 '''
+  {   340,  13,  44,  16,    2,  -33 },   // 0x28 '('
+  {   385,  13,  44,  16,    1,  -33 },   // 0x29 ')'
+  {   430,  15,  15,  18,    1,  -33 },   // 0x2A '*'
+  {   452,  23,  22,  27,    2,  -21 },   // 0x2B '+'
+  {   481,   7,  15,  12,    2,   -6 },   // 0x2C ','
+  {   492,  13,   6,  16,    1,  -15 },   // 0x2D '-'
+  {   496,   7,   7,  12,    2,   -6 },   // 0x2E '.'
+  {   499,  13,  34,  13,    0,  -32 },   // 0x2F '/'
+  {   534,  24,  35,  26,    1,  -33 },   // 0x30 '0'
+  {   585,  14,  33,  26,    4,  -32 },   // 0x31 '1'
+  {   616,  23,  34,  26,    2,  -33 },   // 0x32 '2'
+  {   662,  23,  35,  26,    2,  -33 },   // 0x33 '3'
+  {   714,  22,  33,  26,    2,  -32 },   // 0x34 '4'
+  {   763,  23,  34,  26,    2,  -32 },   // 0x35 '5'
+  {   815,  23,  35,  26,    2,  -33 },   // 0x36 '6'
+  {   871,  23,  33,  26,    1,  -32 },   // 0x37 '7'
+  {   918,  24,  35,  26,    1,  -33 },   // 0x38 '8'
+  {   974,  24,  35,  26,    1,  -33 },   // 0x39 '9'
+  {  1030,   7,  25,  12,    2,  -24 },   // 0x3A ':'
+  {  1038,   7,  33,  12,    2,  -24 },   // 0x3B ';'
+  {  1054,  23,  23,  27,    2,  -22 },   // 0x3C '<'
+  {  1082,  23,  18,  27,    2,  -19 },   // 0x3D '='
+  {  1098,  23,  23,  27,    2,  -22 },   // 0x3E '>'
+  {  1126,  24,  35,  29,    3,  -34 },   // 0x3F '?'
+  {  1174,  43,  41,  46,    1,  -34 },   // 0x40 '@'
+  {  1293,  32,  34,  33,    0,  -33 },   // 0x41 'A'
+  {  1359,  27,  34,  33,    4,  -33 },   // 0x42 'B'
+  {  1413,  30,  36,  34,    2,  -34 },   // 0x43 'C'
+  {  1475,  28,  34,  34,    4,  -33 },   // 0x44 'D'
+  {  1528,  25,  34,  31,    4,  -33 },   // 0x45 'E'
+  {  1576,  24,  34,  30,    4,  -33 },   // 0x46 'F'
+  {  1624,  31,  36,  36,    2,  -34 },   // 0x47 'G'
+  {  1691,  27,  34,  35,    4,  -33 },   // 0x48 'H'
+  {  1726,   7,  34,  15,    4,  -33 },   // 0x49 'I'
+  {  1735,  22,  35,  27,    1,  -33 },   // 0x4A 'J'
+  {  1785,  30,  34,  34,    4,  -33 },   // 0x4B 'K'
+  {  1851,  23,  34,  29,    4,  -33 },   // 0x4C 'L'
+  {  1899,  33,  34,  41,    4,  -33 },   // 0x4D 'M'
+  {  1980,  28,  34,  35,    4,  -33 },   // 0x4E 'N'
+  {  2037,  33,  36,  37,    2,  -34 },   // 0x4F 'O'
+  {  2106,  26,  34,  32,    4,  -33 },   // 0x50 'P'
+  {  2156,  33,  37,  37,    2,  -34 },   // 0x51 'Q'
+  {  2229,  28,  34,  34,    4,  -33 },   // 0x52 'R'
+  {  2291,  28,  36,  32,    2,  -34 },   // 0x53 'S'
+  {  2347,  27,  34,  30,    2,  -33 },   // 0x54 'T'
+  {  2395,  27,  35,  35,    4,  -33 },   // 0x55 'U'
+  {  2437,  29,  34,  31,    1,  -33 },   // 0x56 'V'
+  {  2503,  43,  34,  45,    1,  -33 },   // 0x57 'W'
+  {  2616,  30,  34,  32,    1,  -33 },   // 0x58 'X'
+  {  2680,  29,  34,  30,    1,  -33 },   // 0x59 'Y'
+  {  2739,  26,  34,  29,    1,  -33 },   // 0x5A 'Z'
+  {  2785,  11,  43,  16,    3,  -33 },   // 0x5B '['
+  {  2823,  14,  34,  13,   -1,  -32 },   // 0x5C '\'
+  {  2857,  11,  43,  16,    1,  -33 },   // 0x5D ']'
+  {  2895,  22,  20,  27,    3,  -32 },   // 0x5E '^'
+  {  2931,  28,   4,  26,   -1,    6 },   // 0x5F '_'
+  {  2936,   9,   7,  12,    1,  -35 },   // 0x60 '`'
+  {  2943,  24,  26,  27,    2,  -24 },   // 0x61 'a'
+  {  2986,  25,  35,  29,    3,  -33 },   // 0x62 'b'
+  {  3042,  23,  26,  26,    2,  -24 },   // 0x63 'c'
+  {  3082,  25,  35,  29,    2,  -33 },   // 0x64 'd'
+  {  3138,  24,  26,  27,    2,  -24 },   // 0x65 'e'
+  {  3181,  14,  34,  16,    1,  -33 },   // 0x66 'f'
+  {  3216,  24,  36,  29,    2,  -24 },   // 0x67 'g'
+  {  3275,  23,  34,  28,    3,  -33 },   // 0x68 'h'
+  {  3320,   7,  34,  13,    3,  -33 },   // 0x69 'i'
+  {  3329,  10,  45,  13,    0,  -33 },   // 0x6A 'j'
+  {  3370,  23,  34,  27,    3,  -33 },   // 0x6B 'k'
+  {  3431,   7,  34,  13,    3,  -33 },   // 0x6C 'l'
+  {  3440,  36,  25,  42,    3,  -24 },   // 0x6D 'm'
+  {  3494,  23,  25,  29,    3,  -24 },   // 0x6E 'n'
+  {  3525,  25,  26,  29,    2,  -24 },   // 0x6F 'o'
+  {  3564,  25,  36,  29,    3,  -24 },   // 0x70 'p'
+  {  3623,  25,  36,  29,    2,  -24 },   // 0x71 'q'
+  {  3682,  15,  25,  18,    3,  -24 },   // 0x72 'r'
+  {  3707,  24,  26,  26,    1,  -24 },   // 0x73 's'
+  {  3746,  12,  32,  16,    2,  -30 },   // 0x74 't'
+  {  3777,  23,  26,  29,    3,  -24 },   // 0x75 'u'
+  {  3809,  25,  25,  25,    0,  -24 },   // 0x76 'v'
+  {  3854,  35,  25,  37,    1,  -24 },   // 0x77 'w'
+  {  3930,  24,  25,  26,    1,  -24 },   // 0x78 'x'
+  {  3971,  25,  36,  26,    0,  -24 },   // 0x79 'y'
+  {  4033,  21,  25,  24,    1,  -24 },   // 0x7A 'z'
+  {  4060,  13,  43,  18,    2,  -33 },   // 0x7B '{'
+  {  4103,   4,  44,  13,    5,  -33 },   // 0x7C '|'
+  {  4110,  13,  43,  18,    3,  -33 },   // 0x7D '}'
+  {  4154,  21,   8,  23,    1,  -14 } }; // 0x7E '~'
+
+const GFXfont FreeSansBold24pt7bRLE PROGMEM = {
+  (uint8_t  *)FreeSansBold24pt7bRLEBitmaps,
+  (GFXglyph *)FreeSansBold24pt7bRLEGlyphs,
+  0x20, 0x7E, 56, GFX_FONT_RLE };
+
+// Approx. 4838 bytes
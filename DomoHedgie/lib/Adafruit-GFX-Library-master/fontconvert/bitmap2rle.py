@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Re-encodes a bitmap font header made by fontconvert as an RLE font
+# (GFX_FONT_RLE, see gfxfont.h), for fonts whose outline source isn't at
+# hand.  Output is the same as 'fontconvert -r' on the original outline:
+#   ./bitmap2rle.py ../Fonts/FreeSans18pt7b.h > ../Fonts/FreeSans18pt7bRLE.h
+
+import re
+import sys
+
+def main(path):
+    src = open(path).read()
+
+    name  = re.search(r'const GFXfont (\w+) PROGMEM', src).group(1)
+    table = re.search(r'Bitmaps\[\] PROGMEM = \{(.*?)\};', src, re.S).group(1)
+    data  = [int(b, 16) for b in re.findall(r'0x[0-9A-Fa-f]{2}', table)]
+    table = re.search(r'Glyphs\[\] PROGMEM = \{(.*?)\};', src, re.S).group(1)
+    glyphs = [[int(v) for v in g] for g in
+              re.findall(r'\{\s*' + r',\s*'.join([r'(-?\d+)'] * 6) + r'\s*\}', table)]
+    first, last, yAdvance = re.search(
+        r'\(GFXglyph \*\)\w+,\s*0x([0-9A-F]+), 0x([0-9A-F]+), (\d+) \}', src).groups()
+    first, last = int(first, 16), int(last, 16)
+
+    out, nibbles = [], []
+    for g in glyphs:
+        offset, width, height = g[0], g[1], g[2]
+        g[0] = len(out)
+        run, lit = 0, 0
+        for i in range(width * height):
+            pixel = (data[offset + i // 8] >> (7 - (i & 7))) & 1
+            if pixel != lit:
+                nibbles += [15] * (run // 15) + [run % 15]
+                run, lit = 0, pixel
+            run += 1
+        if run:
+            nibbles += [15] * (run // 15) + [run % 15]
+        if len(nibbles) & 1:
+            nibbles.append(0)
+        out += [(nibbles[i] << 4) | nibbles[i + 1]
+                for i in range(0, len(nibbles), 2)]
+        nibbles = []
+
+    rle = name + 'RLE'
+    lines = ['const uint8_t %sBitmaps[] PROGMEM = {' % rle]
+    rows = [', '.join('0x%02X' % b for b in out[i:i + 12])
+            for i in range(0, len(out), 12)]
+    lines.append('  ' + ',\n  '.join(rows) + ' };')
+    lines.append('')
+    lines.append('const GFXglyph %sGlyphs[] PROGMEM = {' % rle)
+    for c, g in zip(range(first, last + 1), glyphs):
+        entry = '  { %5d, %3d, %3d, %3d, %4d, %4d }' % tuple(g)
+        char  = " '%c'" % c if ' ' <= chr(c) <= '~' else ''
+        if c < last:
+            lines.append(entry + ',   // 0x%02X%s' % (c, char))
+        else:
+            lines.append(entry + ' }; // 0x%02X%s' % (c, char))
+    lines.append('')
+    lines.append('const GFXfont %s PROGMEM = {' % rle)
+    lines.append('  (uint8_t  *)%sBitmaps,' % rle)
+    lines.append('  (GFXglyph *)%sGlyphs,' % rle)
+    lines.append('  0x%02X, 0x%02X, %s, GFX_FONT_RLE };' % (first, last, yAdvance))
+    lines.append('')
+    lines.append('// Approx. %d bytes' % (len(out) + (last - first + 1) * 7 + 8))
+    sys.stdout.write('\n'.join(lines) + '\n')
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.stderr.write('Usage: %s font.h\n' % sys.argv[0])
+        sys.exit(1)
+    main(sys.argv[1])
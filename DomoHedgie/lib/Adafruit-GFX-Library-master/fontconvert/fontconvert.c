@@ -8,6 +8,13 @@ fonts to be used with the Adafruit_GFX Arduino library.
 For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
   ./fontconvert ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7b.h
 
+With -r, glyphs are run-length encoded (GFX_FONT_RLE, see gfxfont.h) and
+'RLE' is appended to the font name:
+  ./fontconvert -r ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7bRLE.h
+RLE pays off for large and bold fonts, where runs are long; small, thin
+fonts usually come out bigger than the plain bitmap, so compare the
+'Approx. bytes' line of both before switching.
+
 REQUIRES FREETYPE LIBRARY.  www.freetype.org
 
 Currently this only extracts the printable 7-bit ASCII chars of a font.
@@ -18,6 +25,8 @@ See notes at end for glyph nomenclature & other tidbits.
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <ctype.h>
 #include <stdint.h>
 #include <ft2build.h>
@@ -26,29 +35,65 @@ See notes at end for glyph nomenclature & other tidbits.
 
 #define DPI 141 // Approximate res. of Adafruit 2.8" TFT
 
+// Write one byte of the bitmap table, formatted 12 to a line
+void enbyte(uint8_t value) {
+	static uint8_t row = 0, firstCall = 1;
+	if(!firstCall) { // Format output table nicely
+		if(++row >= 12) {        // Last entry on line?
+			printf(",\n  "); //   Newline format output
+			row = 0;         //   Reset row counter
+		} else {                 // Not end of line
+			printf(", ");    //   Simple comma delim
+		}
+	}
+	printf("0x%02X", value); // Write byte value
+	firstCall = 0;           // Formatting flag
+}
+
 // Accumulate bits for output, with periodic hexadecimal byte write
 void enbit(uint8_t value) {
-	static uint8_t row = 0, sum = 0, bit = 0x80, firstCall = 1;
+	static uint8_t sum = 0, bit = 0x80;
 	if(value) sum |= bit;    // Set bit if needed
 	if(!(bit >>= 1)) {       // Advance to next bit, end of byte reached?
-		if(!firstCall) { // Format output table nicely
-			if(++row >= 12) {        // Last entry on line?
-				printf(",\n  "); //   Newline format output
-				row = 0;         //   Reset row counter
-			} else {                 // Not end of line
-				printf(", ");    //   Simple comma delim
-			}
-		}
-		printf("0x%02X", sum); // Write byte value
-		sum       = 0;         // Clear for next byte
-		bit       = 0x80;      // Reset bit counter
-		firstCall = 0;         // Formatting flag
+		enbyte(sum);     // Write byte value
+		sum = 0;         // Clear for next byte
+		bit = 0x80;      // Reset bit counter
 	}
 }
 
+// Accumulate 4-bit values, high nibble first.  Returns number of bytes
+// written; pass flush != 0 to write out a pending high nibble.
+int ennibble(uint8_t value, uint8_t flush) {
+	static uint8_t sum = 0, high = 1;
+	if(flush) {
+		if(high) return 0;
+		enbyte(sum);
+		high = 1;
+		return 1;
+	}
+	if(high) {
+		sum  = value << 4;
+		high = 0;
+		return 0;
+	}
+	enbyte(sum | value);
+	high = 1;
+	return 1;
+}
+
+// Write one RLE run: 15 per nibble while it lasts, then the remainder
+int enrun(int length) {
+	int bytes = 0;
+	while(length >= 15) {
+		bytes  += ennibble(15, 0);
+		length -= 15;
+	}
+	return bytes + ennibble(length, 0);
+}
+
 int main(int argc, char *argv[]) {
 	int                i, j, err, size, first=' ', last='~',
-	                   bitmapOffset = 0, x, y, byte;
+	                   bitmapOffset = 0, x, y, byte, rle = 0, run, set;
 	char              *fontName, c, *ptr;
 	FT_Library         library;
 	FT_Face            face;
@@ -59,14 +104,21 @@ int main(int argc, char *argv[]) {
 	uint8_t            bit;
 
 	// Parse command line.  Valid syntaxes are:
-	//   fontconvert [filename] [size]
-	//   fontconvert [filename] [size] [last char]
-	//   fontconvert [filename] [size] [first char] [last char]
+	//   fontconvert [-r] [filename] [size]
+	//   fontconvert [-r] [filename] [size] [last char]
+	//   fontconvert [-r] [filename] [size] [first char] [last char]
 	// Unless overridden, default first and last chars are
-	// ' ' (space) and '~', respectively
+	// ' ' (space) and '~', respectively.  -r selects RLE glyphs.
+
+	if((argc > 1) && !strcmp(argv[1], "-r")) {
+		rle = 1;
+		argv[1] = argv[0];
+		argv++;
+		argc--;
+	}
 
 	if(argc < 3) {
-		fprintf(stderr, "Usage: %s fontfile size [first] [last]\n",
+		fprintf(stderr, "Usage: %s [-r] fontfile size [first] [last]\n",
 		  argv[0]);
 		return 1;
 	}
@@ -105,7 +157,7 @@ int main(int argc, char *argv[]) {
 	if(!ptr) ptr = &fontName[strlen(fontName)]; // If none, append
 	// Insert font size and 7/8 bit.  fontName was alloc'd w/extra
 	// space to allow this, we're not sprintfing into Forbidden Zone.
-	sprintf(ptr, "%dpt%db", size, (last > 127) ? 8 : 7);
+	sprintf(ptr, "%dpt%db%s", size, (last > 127) ? 8 : 7, rle ? "RLE" : "");
 	// Space and punctuation chars in name replaced w/ underscores.  
 	for(i=0; (c=fontName[i]); i++) {
 		if(isspace(c) || ispunct(c)) fontName[i] = '_';
@@ -174,22 +226,45 @@ int main(int argc, char *argv[]) {
 		table[j].xOffset      = g->left;
 		table[j].yOffset      = 1 - g->top;
 
-		for(y=0; y < bitmap->rows; y++) {
-			for(x=0;x < bitmap->width; x++) {
-				byte = x / 8;
-				bit  = 0x80 >> (x & 7);
-				enbit(bitmap->buffer[
-				  y * bitmap->pitch + byte] & bit);
+		if(rle) {
+			// Runs alternate clear/set starting with clear and
+			// run on from one row into the next; a glyph that
+			// starts with a set pixel begins with a zero run.
+			// Pad last nibble so each glyph is byte-aligned.
+			run = set = 0;
+			for(y=0; y < bitmap->rows; y++) {
+				for(x=0;x < bitmap->width; x++) {
+					byte = x / 8;
+					bit  = 0x80 >> (x & 7);
+					if(!(bitmap->buffer[y * bitmap->pitch +
+					  byte] & bit) != !set) {
+						bitmapOffset += enrun(run);
+						run = 0;
+						set = !set;
+					}
+					run++;
+				}
+			}
+			if(run) bitmapOffset += enrun(run);
+			bitmapOffset += ennibble(0, 1);
+		} else {
+			for(y=0; y < bitmap->rows; y++) {
+				for(x=0;x < bitmap->width; x++) {
+					byte = x / 8;
+					bit  = 0x80 >> (x & 7);
+					enbit(bitmap->buffer[
+					  y * bitmap->pitch + byte] & bit);
+				}
 			}
-		}
 
-		// Pad end of char bitmap to next byte boundary if needed
-		int n = (bitmap->width * bitmap->rows) & 7;
-		if(n) { // Pixel count not an even multiple of 8?
-			n = 8 - n; // # bits to next multiple
-			while(n--) enbit(0);
+			// Pad end of char bitmap to next byte boundary if needed
+			int n = (bitmap->width * bitmap->rows) & 7;
+			if(n) { // Pixel count not an even multiple of 8?
+				n = 8 - n; // # bits to next multiple
+				while(n--) enbit(0);
+			}
+			bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
 		}
-		bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
 
 		FT_Done_Glyph(glyph);
 	}
@@ -222,10 +297,15 @@ int main(int argc, char *argv[]) {
 	printf("const GFXfont %s PROGMEM = {\n", fontName);
 	printf("  (uint8_t  *)%sBitmaps,\n", fontName);
 	printf("  (GFXglyph *)%sGlyphs,\n", fontName);
-	printf("  0x%02X, 0x%02X, %ld };\n\n",
-	  first, last, face->size->metrics.height >> 6);
+	if(rle) {
+		printf("  0x%02X, 0x%02X, %ld, GFX_FONT_RLE };\n\n",
+		  first, last, face->size->metrics.height >> 6);
+	} else {
+		printf("  0x%02X, 0x%02X, %ld };\n\n",
+		  first, last, face->size->metrics.height >> 6);
+	}
 	printf("// Approx. %d bytes\n",
-	  bitmapOffset + (last - first + 1) * 7 + 7);
+	  bitmapOffset + (last - first + 1) * 7 + 8);
 	// Size estimate is based on AVR struct and pointer sizes;
 	// actual size may vary.
 
@@ -3,6 +3,14 @@
 // To use a font in your Arduino sketch, #include the corresponding .h
 // file and pass address of GFXfont struct to setFont().  Pass NULL to
 // revert to 'classic' fixed-space bitmap font.
+//
+// Glyph images come in one of two formats, chosen per font by fontconvert:
+// GFX_FONT_BITMAP packs one bit per pixel, row by row; GFX_FONT_RLE (made
+// with 'fontconvert -r') stores the same pixels as run lengths.  RLE runs
+// alternate between clear and set, starting with clear, and carry on from
+// one row into the next.  Each run is one or more 4-bit values, high nibble
+// first, added together: 15 means 'add 15 and keep reading', 0-14 ends the
+// run.  Either way each glyph starts on a byte boundary at bitmapOffset.
 
 #ifndef _GFXFONT_H_
 #define _GFXFONT_H_
@@ -19,6 +27,10 @@ typedef struct { // Data stored for FONT AS A WHOLE:
 	GFXglyph *glyph;       // Glyph array
 	uint8_t   first, last; // ASCII extents
 	uint8_t   yAdvance;    // Newline distance (y axis)
+	uint8_t   format;      // GFX_FONT_BITMAP (0, older fonts) or GFX_FONT_RLE
 } GFXfont;
 
+#define GFX_FONT_BITMAP 0
+#define GFX_FONT_RLE    1
+
 #endif // _GFXFONT_H_
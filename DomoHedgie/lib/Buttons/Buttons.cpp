@@ -0,0 +1,115 @@
+#include "Buttons.h"
+
+// Button flags
+#define BUTTON_KNOWN 0x01 // Level seen at least once
+#define BUTTON_DOWN  0x02 // Reported pressed
+#define BUTTON_LONG  0x04 // No (more) BUTTON_LONG_PRESS for this press
+#define BUTTON_QUIET 0x08 // Pressed from the start: no events until up
+
+Buttons::Buttons(void) :
+  edgeHead(0), edgeTail(0), overrun(false), eventHead(0), eventTail(0) {
+  memset(buttons, 0, sizeof(buttons));
+}
+
+void Buttons::begin(uint8_t id, uint8_t pin) {
+  if(id >= BUTTONS_MAX) return;
+  Button *b  = &buttons[id];
+  b->inReg   = portInputRegister(digitalPinToPort(pin));
+  b->bitMask = digitalPinToBitMask(pin);
+  b->flags   = 0;
+  pinMode(pin, INPUT);
+  level(id, (*b->inReg & b->bitMask) ? HIGH : LOW);
+}
+
+void Buttons::edge(uint8_t id) {
+  const Button *b = &buttons[id];
+  uint8_t l = (*b->inReg & b->bitMask) ? HIGH : LOW;
+  uint8_t h = edgeHead;
+  if((uint8_t)(h - edgeTail) >= BUTTONS_EDGES) {
+    overrun = true;
+    return;
+  }
+  volatile Edge *e = &edges[h & (BUTTONS_EDGES - 1)];
+  e->button = id;
+  e->level  = l;
+  e->time   = millis();
+  edgeHead  = h + 1;
+}
+
+void Buttons::level(uint8_t id, uint8_t level) {
+  if(id >= BUTTONS_MAX) return;
+  Button *b = &buttons[id];
+  if(!(b->flags & BUTTON_KNOWN)) {
+    b->flags |= BUTTON_KNOWN;
+    if(level == LOW) b->flags |= BUTTON_DOWN | BUTTON_LONG | BUTTON_QUIET;
+    b->raw = level;
+    return;
+  }
+  if(level != b->raw) {
+    b->raw     = level;
+    b->changed = millis();
+  }
+}
+
+void Buttons::tick(void) {
+  while(edgeTail != edgeHead) {
+    volatile Edge *e = &edges[edgeTail & (BUTTONS_EDGES - 1)];
+    Button *b  = &buttons[e->button];
+    b->raw     = e->level;
+    b->changed = e->time;
+    edgeTail++;
+  }
+  // Read after the edges, so that none is later than 'now'
+  uint16_t now = millis();
+  if(overrun) {
+    // Edges were lost: the pins say where the buttons are now
+    overrun = false;
+    for(uint8_t i=0; i<BUTTONS_MAX; i++) {
+      Button *b = &buttons[i];
+      if(!b->inReg) continue;
+      uint8_t l = (*b->inReg & b->bitMask) ? HIGH : LOW;
+      if(l != b->raw) {
+        b->raw     = l;
+        b->changed = now;
+      }
+    }
+  }
+
+  for(uint8_t i=0; i<BUTTONS_MAX; i++) {
+    Button *b = &buttons[i];
+    if(!(b->flags & BUTTON_KNOWN)) continue;
+    boolean down = (b->raw == LOW);
+    if(down != !!(b->flags & BUTTON_DOWN)) {
+      if((uint16_t)(now - b->changed) < BUTTONS_DEBOUNCE) continue;
+      if(down) {
+        b->flags  |= BUTTON_DOWN;
+        b->flags  &= ~BUTTON_LONG;
+        b->pressed = now;
+        queue(i, BUTTON_PRESS);
+      } else {
+        if(!(b->flags & BUTTON_QUIET)) queue(i, BUTTON_RELEASE);
+        b->flags &= ~(BUTTON_DOWN | BUTTON_QUIET);
+      }
+    } else if(down && !(b->flags & BUTTON_LONG) &&
+              ((uint16_t)(now - b->pressed) >= BUTTONS_LONG_PRESS)) {
+      b->flags |= BUTTON_LONG;
+      queue(i, BUTTON_LONG_PRESS);
+    }
+  }
+}
+
+void Buttons::queue(uint8_t id, uint8_t type) {
+  // Full: the oldest event goes, the latest state matters more
+  if((uint8_t)(eventHead - eventTail) >= BUTTONS_EVENTS) eventTail++;
+  ButtonEvent *e = &events[eventHead & (BUTTONS_EVENTS - 1)];
+  e->button = id;
+  e->type   = type;
+  eventHead++;
+}
+
+boolean Buttons::read(ButtonEvent *event) {
+  if(eventTail == eventHead) return false;
+  *event = events[eventTail & (BUTTONS_EVENTS - 1)];
+  eventTail++;
+  return true;
+}
@@ -0,0 +1,93 @@
+// Push buttons debounced outside their interrupts.
+//
+// A button on an interrupt pin has its interrupt attached on CHANGE and
+// forwarded to edge(), e.g.
+//   void enterEdge() { buttons.edge(ENTER_BUTTON); }
+// which only reads the pin and queues the level with a timestamp, in a
+// single-producer/single-consumer ring shared by all the buttons (AVR
+// interrupts do not nest, so one edge() runs at a time).  Buttons that
+// cannot interrupt (behind a multiplexer, say) are read by the sketch and
+// handed to level() instead.  tick(), run every few ms from loop(), takes
+// the edges in and reports a button once it has been steady for
+// BUTTONS_DEBOUNCE ms: BUTTON_PRESS, BUTTON_LONG_PRESS once it has been
+// held BUTTONS_LONG_PRESS ms, and BUTTON_RELEASE.  read() then hands the
+// events out in order.
+//
+// Buttons are active low.  One found pressed at begin() (or at its first
+// level()) gives no events until it has been released.
+
+#ifndef _BUTTONS_H_
+#define _BUTTONS_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#define BUTTONS_MAX        4
+#define BUTTONS_EDGES      16   // Entries in the edge ring, a power of 2
+#define BUTTONS_EVENTS     8    // Entries in the event queue, a power of 2
+#define BUTTONS_DEBOUNCE   20   // ms a level must hold to count
+#define BUTTONS_LONG_PRESS 1000 // ms held before BUTTON_LONG_PRESS
+
+#define BUTTON_PRESS      1
+#define BUTTON_LONG_PRESS 2
+#define BUTTON_RELEASE    3
+
+typedef struct {
+  uint8_t button;
+  uint8_t type;   // BUTTON_PRESS, BUTTON_LONG_PRESS or BUTTON_RELEASE
+} ButtonEvent;
+
+class Buttons {
+
+ public:
+
+  Buttons(void);
+
+  // Button 'id' (below BUTTONS_MAX) on 'pin', whose interrupt calls
+  // edge(id).  Call before attaching the interrupt.
+  void     begin(uint8_t id, uint8_t pin);
+
+  void     edge(uint8_t id);      // Call from the button's interrupt
+
+  // Level of a button the sketch reads itself, as often as tick() runs
+  void     level(uint8_t id, uint8_t level);
+
+  // Debounces what came in since the last call and queues the events
+  void     tick(void);
+
+  // Takes the oldest event; false if there is none.
+  boolean  read(ButtonEvent *event);
+
+ private:
+
+  typedef struct {
+    volatile uint8_t *inReg;       // NULL: polled through level()
+    uint8_t           bitMask;
+    uint8_t           flags;
+    uint8_t           raw;         // Last level seen
+    uint16_t          changed;     // millis() of the last edge
+    uint16_t          pressed;     // millis() when reported pressed
+  } Button;
+
+  typedef struct {
+    uint8_t  button;
+    uint8_t  level;
+    uint16_t time;
+  } Edge;
+
+  void     queue(uint8_t id, uint8_t type);
+
+  Button            buttons[BUTTONS_MAX];
+  // edge() writes only 'edgeHead', tick() only 'edgeTail'
+  volatile Edge     edges[BUTTONS_EDGES];
+  volatile uint8_t  edgeHead, edgeTail;
+  // Set by edge() when the ring was full: tick() reads the pins instead
+  volatile boolean  overrun;
+  ButtonEvent       events[BUTTONS_EVENTS];
+  uint8_t           eventHead, eventTail;
+};
+
+#endif // _BUTTONS_H_
@@ -1,133 +1,249 @@
-//
-//    FILE: dht22.cpp
-// VERSION: 0.1.00
-// PURPOSE: DHT22 Temperature & Humidity Sensor library for Arduino
-//
-// DATASHEET: 
-//
-// HISTORY:
-// 0.1.0 by Rob Tillaart (01/04/2011)
-// inspired by DHT11 library
-//
-
-#include "dht.h"
-
-#define TIMEOUT 10000
-
-/////////////////////////////////////////////////////
-//
-// PUBLIC
-//
-
-
-// return values:
-//  0 : OK
-// -1 : checksum error
-// -2 : timeout
-int dht::read11(uint8_t pin)
-{
-	// READ VALUES
-	int rv = read(pin);
-	if (rv != 0) return rv;
-
-	// CONVERT AND STORE
-	humidity    = bits[0];  // bit[1] == 0;
-	temperature = bits[2];  // bits[3] == 0;
-
-	// TEST CHECKSUM
-	uint8_t sum = bits[0] + bits[2]; // bits[1] && bits[3] both 0
-	if (bits[4] != sum) return -1;
-
-	return 0;
-}
-
-// return values:
-//  0 : OK
-// -1 : checksum error
-// -2 : timeout
-int dht::read22(uint8_t pin)
-{
-	// READ VALUES
-	int rv = read(pin);
-	if (rv != 0) return rv;
-
-	// CONVERT AND STORE
-	humidity    = word(bits[0], bits[1]) * 0.1;
-
-	int sign = 1;
-	if (bits[2] & 0x80) // negative temperature
-	{
-		bits[2] = bits[2] & 0x7F;
-		sign = -1;
-	}
-	temperature = sign * word(bits[2], bits[3]) * 0.1;
-
-
-	// TEST CHECKSUM
-	uint8_t sum = bits[0] + bits[1] + bits[2] + bits[3];
-	if (bits[4] != sum) return -1;
-
-	return 0;
-}
-
-/////////////////////////////////////////////////////
-//
-// PRIVATE
-//
-
-// return values:
-//  0 : OK
-// -2 : timeout
-int dht::read(uint8_t pin)
-{
-	// INIT BUFFERVAR TO RECEIVE DATA
-	uint8_t cnt = 7;
-	uint8_t idx = 0;
-
-	// EMPTY BUFFER
-	for (int i=0; i< 5; i++) bits[i] = 0;
-
-	// REQUEST SAMPLE
-	pinMode(pin, OUTPUT);
-	digitalWrite(pin, LOW);
-	delay(20);
-	digitalWrite(pin, HIGH);
-	delayMicroseconds(40);
-	pinMode(pin, INPUT);
-
-	// GET ACKNOWLEDGE or TIMEOUT
-	unsigned int loopCnt = TIMEOUT;
-	while(digitalRead(pin) == LOW)
-		if (loopCnt-- == 0) return -2;
-
-	loopCnt = TIMEOUT;
-	while(digitalRead(pin) == HIGH)
-		if (loopCnt-- == 0) return -2;
-
-	// READ THE OUTPUT - 40 BITS => 5 BYTES
-	for (int i=0; i<40; i++)
-	{
-		loopCnt = TIMEOUT;
-		while(digitalRead(pin) == LOW)
-			if (loopCnt-- == 0) return -2;
-
-		unsigned long t = micros();
-
-		loopCnt = TIMEOUT;
-		while(digitalRead(pin) == HIGH)
-			if (loopCnt-- == 0) return -2;
-
-		if ((micros() - t) > 40) bits[idx] |= (1 << cnt);
-		if (cnt == 0)   // next byte?
-		{
-			cnt = 7;   
-			idx++;      
-		}
-		else cnt--;
-	}
-
-	return 0;
-}
-//
-// END OF FILE
-//
+//
+//    FILE: dht22.cpp
+// VERSION: 0.1.00
+// PURPOSE: DHT22 Temperature & Humidity Sensor library for Arduino
+//
+// DATASHEET: 
+//
+// HISTORY:
+// 0.1.0 by Rob Tillaart (01/04/2011)
+// inspired by DHT11 library
+// 0.1.01 non-blocking DHT11 reading driven by pin change interrupts
+//
+
+#include "dht.h"
+
+#define TIMEOUT 10000
+
+// Non-blocking reading
+#define DHT_START_MS 18    // Host start signal, DHT11 needs at least 18 ms
+#define DHT_FRAME_US 10000 // Response plus 40 bits take about 4-5 ms
+#define DHT_ONE_US   40    // High pulses longer than this are 1 bits
+#define DHT_FALLS    42    // Falling edges: 2 of response, 40 ending bits
+
+#define DHT_IDLE      0
+#define DHT_WAITING   1    // Retry scheduled
+#define DHT_STARTING  2    // Holding the line low
+#define DHT_RECEIVING 3    // edge() decoding the response
+#define DHT_RECEIVED  4    // All 40 bits in
+
+/////////////////////////////////////////////////////
+//
+// PUBLIC
+//
+
+
+// return values:
+//  0 : OK
+// -1 : checksum error
+// -2 : timeout
+int dht::read11(uint8_t pin)
+{
+	// READ VALUES
+	int rv = read(pin);
+	if (rv != 0) return rv;
+
+	// CONVERT AND STORE
+	humidity    = bits[0];  // bit[1] == 0;
+	temperature = bits[2];  // bits[3] == 0;
+
+	// TEST CHECKSUM
+	uint8_t sum = bits[0] + bits[2]; // bits[1] && bits[3] both 0
+	if (bits[4] != sum) return -1;
+
+	return 0;
+}
+
+// return values:
+//  0 : OK
+// -1 : checksum error
+// -2 : timeout
+int dht::read22(uint8_t pin)
+{
+	// READ VALUES
+	int rv = read(pin);
+	if (rv != 0) return rv;
+
+	// CONVERT AND STORE
+	humidity    = word(bits[0], bits[1]) * 0.1;
+
+	int sign = 1;
+	if (bits[2] & 0x80) // negative temperature
+	{
+		bits[2] = bits[2] & 0x7F;
+		sign = -1;
+	}
+	temperature = sign * word(bits[2], bits[3]) * 0.1;
+
+
+	// TEST CHECKSUM
+	uint8_t sum = bits[0] + bits[1] + bits[2] + bits[3];
+	if (bits[4] != sum) return -1;
+
+	return 0;
+}
+
+void dht::begin(uint8_t pin)
+{
+	_pin     = pin;
+	_inReg   = portInputRegister(digitalPinToPort(pin));
+	_bitMask = digitalPinToBitMask(pin);
+	_state   = DHT_IDLE;
+	pinMode(pin, INPUT);
+}
+
+void dht::request(uint8_t attempts, unsigned long retryDelay)
+{
+	if (_state != DHT_IDLE || attempts == 0) return;
+	_attempts   = attempts;
+	_retryDelay = retryDelay;
+	startAttempt();
+}
+
+bool dht::ready(void)
+{
+	return _state == DHT_IDLE;
+}
+
+// return values:
+//  1 : busy, nothing to report
+//  0 : OK
+// -1 : checksum error
+// -2 : timeout
+int dht::poll(void)
+{
+	switch (_state)
+	{
+	case DHT_WAITING:
+		if (millis() - _since >= _retryDelay) startAttempt();
+		break;
+
+	case DHT_STARTING:
+		if (millis() - _since > DHT_START_MS)
+		{
+			// Release the line and listen; the sensor answers 20-40 us later
+			for (int i=0; i< 5; i++) bits[i] = 0;
+			_falls = 0;
+			_since = micros();
+			_state = DHT_RECEIVING;
+			digitalWrite(_pin, HIGH);
+			pinMode(_pin, INPUT);
+		}
+		break;
+
+	case DHT_RECEIVING:
+		if (micros() - _since > DHT_FRAME_US) return endAttempt(DHTLIB_ERROR_TIMEOUT);
+		break;
+
+	case DHT_RECEIVED:
+		{
+			uint8_t sum = bits[0] + bits[2]; // bits[1] && bits[3] both 0
+			if (bits[4] != sum) return endAttempt(DHTLIB_ERROR_CHECKSUM);
+			humidity    = bits[0];
+			temperature = bits[2];
+			return endAttempt(DHTLIB_OK);
+		}
+	}
+	return DHTLIB_BUSY;
+}
+
+// Times each high pulse from its rising to its falling edge.  The first
+// two falling edges end the sensor's 80 us response; each one after that
+// ends a data bit.
+void dht::edge(void)
+{
+	if (_state != DHT_RECEIVING) return;
+	unsigned long now = micros();
+	if (*_inReg & _bitMask)
+	{
+		_risen = now;
+		return;
+	}
+	if (_falls >= 2)
+	{
+		uint8_t i = _falls - 2;
+		if (now - _risen > DHT_ONE_US) bits[i >> 3] |= 0x80 >> (i & 7);
+	}
+	if (++_falls == DHT_FALLS) _state = DHT_RECEIVED;
+}
+
+/////////////////////////////////////////////////////
+//
+// PRIVATE
+//
+
+void dht::startAttempt(void)
+{
+	pinMode(_pin, OUTPUT);
+	digitalWrite(_pin, LOW);
+	_since = millis();
+	_state = DHT_STARTING;
+}
+
+int dht::endAttempt(int result)
+{
+	_state = DHT_IDLE;
+	if (result != DHTLIB_OK && --_attempts > 0)
+	{
+		_since = millis();
+		_state = DHT_WAITING;
+	}
+	return result;
+}
+
+// return values:
+//  0 : OK
+// -2 : timeout
+int dht::read(uint8_t pin)
+{
+	// INIT BUFFERVAR TO RECEIVE DATA
+	uint8_t cnt = 7;
+	uint8_t idx = 0;
+
+	// EMPTY BUFFER
+	for (int i=0; i< 5; i++) bits[i] = 0;
+
+	// REQUEST SAMPLE
+	pinMode(pin, OUTPUT);
+	digitalWrite(pin, LOW);
+	delay(20);
+	digitalWrite(pin, HIGH);
+	delayMicroseconds(40);
+	pinMode(pin, INPUT);
+
+	// GET ACKNOWLEDGE or TIMEOUT
+	unsigned int loopCnt = TIMEOUT;
+	while(digitalRead(pin) == LOW)
+		if (loopCnt-- == 0) return -2;
+
+	loopCnt = TIMEOUT;
+	while(digitalRead(pin) == HIGH)
+		if (loopCnt-- == 0) return -2;
+
+	// READ THE OUTPUT - 40 BITS => 5 BYTES
+	for (int i=0; i<40; i++)
+	{
+		loopCnt = TIMEOUT;
+		while(digitalRead(pin) == LOW)
+			if (loopCnt-- == 0) return -2;
+
+		unsigned long t = micros();
+
+		loopCnt = TIMEOUT;
+		while(digitalRead(pin) == HIGH)
+			if (loopCnt-- == 0) return -2;
+
+		if ((micros() - t) > 40) bits[idx] |= (1 << cnt);
+		if (cnt == 0)   // next byte?
+		{
+			cnt = 7;   
+			idx++;      
+		}
+		else cnt--;
+	}
+
+	return 0;
+}
+//
+// END OF FILE
+//
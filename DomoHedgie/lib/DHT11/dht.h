@@ -1,38 +1,65 @@
-// 
-//    FILE: dht.h
-// VERSION: 0.1.00
-// PURPOSE: DHT Temperature & Humidity Sensor library for Arduino
-//
-//     URL: http://arduino.cc/playground/Main/DHTLib
-//
-// HISTORY:
-// see dht.cpp file
-// 
-
-#ifndef dht_h
-#define dht_h
-
-#if ARDUINO >= 100
- #include "Arduino.h"
-#else
- #include "WProgram.h"
-#endif
-
-#define DHT_LIB_VERSION "0.1.00"
-
-class dht
-{
-public:
-	int read11(uint8_t pin);
-    int read22(uint8_t pin);
-	double humidity;
-	double temperature;
-
-private:
-	uint8_t bits[5];  // buffer to receive data
-	int read(uint8_t pin);
-};
-#endif
-//
-// END OF FILE
-//
+// 
+//    FILE: dht.h
+// VERSION: 0.1.00
+// PURPOSE: DHT Temperature & Humidity Sensor library for Arduino
+//
+//     URL: http://arduino.cc/playground/Main/DHTLib
+//
+// HISTORY:
+// see dht.cpp file
+// 
+
+#ifndef dht_h
+#define dht_h
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#define DHT_LIB_VERSION "0.1.01"
+
+#define DHTLIB_OK              0
+#define DHTLIB_ERROR_CHECKSUM -1
+#define DHTLIB_ERROR_TIMEOUT  -2
+#define DHTLIB_BUSY            1
+
+class dht
+{
+public:
+	int read11(uint8_t pin);
+    int read22(uint8_t pin);
+	double humidity;
+	double temperature;
+
+	// Non-blocking DHT11 reading.  The sketch enables the pin change
+	// interrupt of the data pin and forwards it to edge(), e.g.
+	//   ISR(PCINT1_vect) { DHT.edge(); }
+	// then calls request() to start a reading and poll() from loop().
+	// poll() returns DHTLIB_BUSY until an attempt ends, then that attempt's
+	// result once; failed attempts are retried after retryDelay ms until
+	// 'attempts' have been made.  humidity/temperature are only updated by
+	// a good reading.
+	void begin(uint8_t pin);
+	void request(uint8_t attempts = 1, unsigned long retryDelay = 0);
+	int  poll(void);
+	bool ready(void);  // No request in progress
+	void edge(void);   // Call from the pin change ISR
+
+private:
+	volatile uint8_t bits[5];  // buffer to receive data
+	int read(uint8_t pin);
+
+	uint8_t  _pin, _bitMask, _attempts;
+	volatile uint8_t *_inReg;
+	volatile uint8_t  _state, _falls;
+	volatile unsigned long _risen;
+	unsigned long _since, _retryDelay;
+	void startAttempt(void);
+	int  endAttempt(int result);
+};
+#endif
+//
+// END OF FILE
+//
@@ -0,0 +1,70 @@
+#include "EventLog.h"
+
+EventLog::EventLog(uint32_t (*clock)(void)) :
+  clock(clock), head(0), count(0), sent(0), lost(0), lostTotal(0) {
+}
+
+boolean EventLog::put(uint8_t system, uint8_t code, uint16_t arg,
+  uint32_t value) {
+  if(count == EVENT_LOG_CAPACITY) return false;
+  LogEvent *e = &ring[(head + count) % EVENT_LOG_CAPACITY];
+  e->time   = clock();
+  e->system = system;
+  e->code   = code;
+  e->arg    = arg;
+  e->value  = value;
+  count++;
+  return true;
+}
+
+void EventLog::log(uint8_t system, uint8_t code, uint16_t arg,
+  uint32_t value) {
+  if(!put(system, code, arg, value)) {
+    lost++;
+    lostTotal++;
+  }
+}
+
+// Frame of the oldest record
+void EventLog::encode(void) {
+  const LogEvent *e = &ring[head];
+  uint8_t *f = frame;
+  *f++ = EVENT_LOG_SYNC0;
+  *f++ = EVENT_LOG_SYNC1;
+  for(uint8_t i=0; i<32; i+=8) *f++ = e->time >> i;
+  *f++ = e->system;
+  *f++ = e->code;
+  for(uint8_t i=0; i<16; i+=8) *f++ = e->arg >> i;
+  for(uint8_t i=0; i<32; i+=8) *f++ = e->value >> i;
+  uint8_t sum = 0;
+  for(uint8_t i=2; i<2+EVENT_LOG_RECORD_SIZE; i++) sum += frame[i];
+  *f = sum;
+}
+
+size_t EventLog::drain(HardwareSerial &port) {
+  size_t written = 0;
+  for(;;) {
+    if(lost && put(EVENT_LOG_SYSTEM, EVENT_LOG_DROPPED, 0, lost)) lost = 0;
+    if(!count) break;
+    int room = port.availableForWrite();
+    if(room <= 0) break;
+    if(!sent) encode();
+    while(room-- && (sent < EVENT_LOG_FRAME_SIZE)) {
+      port.write(frame[sent++]);
+      written++;
+    }
+    if(sent < EVENT_LOG_FRAME_SIZE) break;
+    sent = 0;
+    head = (head + 1) % EVENT_LOG_CAPACITY;
+    count--;
+  }
+  return written;
+}
+
+uint8_t EventLog::pending(void) const {
+  return count;
+}
+
+uint32_t EventLog::dropped(void) const {
+  return lostTotal;
+}
@@ -0,0 +1,56 @@
+// Binary event log with a RAM ring buffer.
+//
+// log() stores a fixed-size record (see EventLogFormat.h) and returns at
+// once: no String building, no RTC read (the timestamp comes from the
+// clock function given to the constructor) and no waiting on the serial
+// port.  drain() sends queued records as binary frames, only as many
+// bytes as the port's TX buffer takes without blocking, so it can run
+// from loop() as often as convenient.  When the ring is full new events
+// are dropped and counted; the count goes out as an EVENT_LOG_DROPPED
+// record as soon as drain() has made room.
+//
+// Not interrupt safe: log from loop() code only.
+
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "EventLogFormat.h"
+
+#ifndef EVENT_LOG_CAPACITY
+ #define EVENT_LOG_CAPACITY 16 // Records, 12 bytes each
+#endif
+
+class EventLog {
+
+ public:
+
+  EventLog(uint32_t (*clock)(void));
+
+  void     log(uint8_t system, uint8_t code, uint16_t arg = 0,
+               uint32_t value = 0);
+
+  // Writes what fits in the port's TX buffer; returns bytes written.
+  size_t   drain(HardwareSerial &port);
+
+  uint8_t  pending(void) const;
+  uint32_t dropped(void) const; // Since start
+
+ private:
+
+  boolean  put(uint8_t system, uint8_t code, uint16_t arg, uint32_t value);
+  void     encode(void);
+
+  uint32_t (*clock)(void);
+  LogEvent  ring[EVENT_LOG_CAPACITY];
+  uint8_t   head, count, sent; // Oldest record, records, its bytes sent
+  uint8_t   frame[EVENT_LOG_FRAME_SIZE]; // Oldest record, being sent
+  uint32_t  lost, lostTotal;   // Not yet reported, since start
+};
+
+#endif // _EVENT_LOG_H_
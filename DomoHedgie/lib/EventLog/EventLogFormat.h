@@ -0,0 +1,34 @@
+// Wire format of EventLog records, shared by the library and host-side
+// decoders (plain C, no Arduino headers).
+//
+// Every record goes out as one frame:
+//
+//   0xA5 0x5A | time (4) | system | code | arg (2) | value (4) | sum
+//
+// multi-byte fields little-endian, 'sum' the 8-bit sum of the 12 record
+// bytes.  Anything between frames is plain text printed by other code, so
+// a decoder copies bytes through until it finds a frame whose sum checks.
+
+#ifndef _EVENT_LOG_FORMAT_H_
+#define _EVENT_LOG_FORMAT_H_
+
+#include <stdint.h>
+
+#define EVENT_LOG_SYNC0        0xA5
+#define EVENT_LOG_SYNC1        0x5A
+#define EVENT_LOG_RECORD_SIZE  12
+#define EVENT_LOG_FRAME_SIZE   (2 + EVENT_LOG_RECORD_SIZE + 1)
+
+// Reserved for the log itself: 'value' events were lost to a full buffer
+#define EVENT_LOG_SYSTEM       0
+#define EVENT_LOG_DROPPED      0
+
+typedef struct {
+  uint32_t time;   // Seconds since 1970-01-01, local time
+  uint8_t  system; // Subsystem that logged it
+  uint8_t  code;   // Event, per subsystem
+  uint16_t arg;    // Small payload (mode, index...)
+  uint32_t value;  // Large payload (counter, timestamp...)
+} LogEvent;
+
+#endif // _EVENT_LOG_FORMAT_H_
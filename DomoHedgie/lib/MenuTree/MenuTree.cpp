@@ -0,0 +1,326 @@
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#endif
+#include "MenuTree.h"
+#include <TextWidget.h>
+#include <TextFormat.h>
+
+#define NONE 0xFF // Blank row, no page shown, no marker
+
+// Selection marker, within the gutter of its row
+#define MARKER_X 5
+#define MARKER_Y 6
+#define MARKER_W 8
+#define MARKER_H 14
+
+// Key of a page line, to tell whether it changed
+static uint16_t hash(const char *s) {
+  uint16_t k = 5381;
+  while(*s) k = (k * 33) ^ (uint8_t)*s++;
+  return k;
+}
+
+MenuTree::MenuTree(Adafruit_GFX *gfx, const GFXfont *font,
+  const GFXfont *titleFont, const MenuHandlers *handlers, uint16_t color,
+  uint16_t bg, uint16_t accent) :
+  gfx(gfx), font(font), titleFont(titleFont), handlers(handlers),
+  color(color), bg(bg), accent(accent), x(0), y(0), w(0), h(0), rows(0),
+  depth(0), page(NONE), marker(NONE), isOpen(false), edit(false), edited(0) {
+  stack[0].list     = NULL;
+  stack[0].selected = stack[0].top = 0;
+}
+
+void MenuTree::begin(const MenuList *root, int16_t x, int16_t y, int16_t w,
+  int16_t h) {
+  this->x = x;
+  this->y = y;
+  this->w = w;
+  this->h = h;
+  rows = (h - MENU_TREE_TITLE) / MENU_TREE_ROW;
+  if(rows > MENU_TREE_ROWS) rows = MENU_TREE_ROWS;
+  stack[0].list     = root;
+  stack[0].selected = stack[0].top = 0;
+}
+
+void MenuTree::open(void) {
+  if(isOpen) return;
+  isOpen = true;
+  depth  = 0;
+  page   = NONE;
+  edit   = false;
+  paintAll();
+}
+
+void MenuTree::close(void) {
+  isOpen = false;
+  edit   = false;
+}
+
+boolean MenuTree::shown(void) const {
+  return isOpen;
+}
+
+uint8_t MenuTree::selection(void) const {
+  return stack[depth].selected;
+}
+
+uint8_t MenuTree::level(void) const {
+  return depth;
+}
+
+boolean MenuTree::editing(void) const {
+  return edit;
+}
+
+void MenuTree::list(MenuList *l) const {
+  memcpy_P(l, stack[depth].list, sizeof(MenuList));
+}
+
+void MenuTree::entry(uint8_t index, MenuEntry *e) const {
+  MenuList l;
+  list(&l);
+  memcpy_P(e, &l.entries[index], sizeof(MenuEntry));
+}
+
+int16_t MenuTree::rowY(uint8_t row) const {
+  return y + MENU_TREE_TITLE + row * MENU_TREE_ROW;
+}
+
+void MenuTree::move(int8_t detents) {
+  if(!isOpen || (page != NONE) || !detents) return;
+  Level *l = &stack[depth];
+
+  if(edit) {
+    MenuEntry  e;
+    MenuNumber n;
+    entry(l->selected, &e);
+    memcpy_P(&n, e.data, sizeof(n));
+    int32_t v = edited + (int32_t)detents * n.step;
+    if(v < n.min) v = n.min;
+    if(v > n.max) v = n.max;
+    if(v == edited) return;
+    edited = v;
+    paintValue(l->selected - l->top, &e);
+    return;
+  }
+
+  MenuList items;
+  memcpy_P(&items, l->list, sizeof(items));
+  int16_t s = ((int16_t)l->selected + detents) % items.count;
+  if(s < 0) s += items.count;
+  l->selected = s;
+  l->top      = s - s % rows; // Whole pages at a time
+  paintRows();
+  paintMarker();
+}
+
+void MenuTree::enter(void) {
+  if(!isOpen || (page != NONE)) return;
+  Level    *l = &stack[depth];
+  MenuEntry e;
+  entry(l->selected, &e);
+
+  if(edit) {
+    edit = false;
+    handlers->set(e.id, edited);
+    paintValue(l->selected - l->top, &e); // As set() took it
+    return;
+  }
+
+  switch(e.type) {
+    case MENU_SUBMENU:
+      if(depth + 1 >= MENU_TREE_DEPTH) return;
+      depth++;
+      stack[depth].list     = (const MenuList *)e.data;
+      stack[depth].selected = stack[depth].top = 0;
+      paintAll();
+      break;
+    case MENU_NUMBER:
+      edit   = true;
+      edited = handlers->get(e.id);
+      paintValue(l->selected - l->top, &e);
+      break;
+    case MENU_PAGE:
+      page = l->selected;
+      paintAll();
+      break;
+    case MENU_ACTION:
+      handlers->action(e.id);
+      break;
+  }
+}
+
+boolean MenuTree::cancel(void) {
+  if(!isOpen) return false;
+  if(edit) {
+    Level    *l = &stack[depth];
+    MenuEntry e;
+    entry(l->selected, &e);
+    edit = false;
+    paintValue(l->selected - l->top, &e);
+  }
+  else if(page != NONE) {
+    page = NONE;
+    paintAll();
+  }
+  else if(depth) {
+    depth--;
+    paintAll();
+  }
+  else isOpen = false;
+  return isOpen;
+}
+
+void MenuTree::refresh(void) {
+  if(isOpen) paintRows();
+}
+
+// Title bar and a blank area, then the rows and the marker
+void MenuTree::paintAll(void) {
+  MenuList l;
+  list(&l);
+  const char *title = l.title;
+  if(page != NONE) {
+    MenuEntry e;
+    memcpy_P(&e, &l.entries[page], sizeof(e));
+    title = e.label;
+  }
+
+  gfx->fillRect(x, y, w, MENU_TREE_TITLE, accent);
+  gfx->setFont(titleFont);
+  gfx->setTextSize(1);
+  gfx->setTextColor(color);
+  gfx->setCursor(x + MENU_TREE_GUTTER, y + MENU_TREE_TITLE - 7);
+  gfx->print((const __FlashStringHelper *)title);
+  gfx->fillRect(x, y + MENU_TREE_TITLE, w, h - MENU_TREE_TITLE, bg);
+
+  for(uint8_t row=0; row<rows; row++) rowEntry[row] = NONE;
+  marker = NONE;
+  paintRows();
+  paintMarker();
+}
+
+// Brings every row in line with the list (or page) shown, painting only
+// the rows whose entry or value changed
+void MenuTree::paintRows(void) {
+  MenuList  l;
+  MenuEntry e;
+  list(&l);
+
+  if(page != NONE) {
+    char s[MENU_TREE_TEXT];
+    memcpy_P(&e, &l.entries[page], sizeof(e));
+    for(uint8_t row=0; row<rows; row++) {
+      if(handlers->page(e.id, row, s, sizeof(s))) paintLine(row, s);
+      else clearRow(row);
+    }
+    return;
+  }
+
+  Level *at = &stack[depth];
+  for(uint8_t row=0; row<rows; row++) {
+    uint8_t index = at->top + row;
+    if(index >= l.count) {
+      clearRow(row);
+      continue;
+    }
+    memcpy_P(&e, &l.entries[index], sizeof(e));
+    if(rowEntry[row] != index) paintRow(row, index, &e);
+    else if((e.type == MENU_NUMBER) && !(edit && (index == at->selected)) &&
+            (rowKey[row] != (uint16_t)handlers->get(e.id))) {
+      paintValue(row, &e);
+    }
+  }
+}
+
+void MenuTree::paintMarker(void) {
+  uint8_t want = (page == NONE) ? stack[depth].selected - stack[depth].top : NONE;
+  if(want == marker) return;
+  if(marker != NONE) {
+    gfx->fillRect(x + MARKER_X, rowY(marker) + MARKER_Y, MARKER_W, MARKER_H, bg);
+  }
+  if(want != NONE) {
+    gfx->fillRect(x + MARKER_X, rowY(want) + MARKER_Y, MARKER_W, MARKER_H, accent);
+  }
+  marker = want;
+}
+
+void MenuTree::paintRow(uint8_t row, uint8_t index, const MenuEntry *e) {
+  boolean blank = (rowEntry[row] == NONE);
+  if(!blank) {
+    gfx->fillRect(x + MENU_TREE_GUTTER, rowY(row),
+      w - MENU_TREE_GUTTER - MENU_TREE_VALUE, MENU_TREE_ROW, bg);
+  }
+  gfx->setFont(font);
+  gfx->setTextSize(1);
+  gfx->setTextColor(color);
+  gfx->setCursor(x + MENU_TREE_GUTTER, rowY(row) + MENU_TREE_BASELINE);
+  gfx->print((const __FlashStringHelper *)e->label);
+  rowEntry[row] = index;
+  paintValue(row, e, !blank);
+}
+
+// Right-aligned in the value column: a number and its unit, in the accent
+// colour while it is edited, or a submenu's '>'
+void MenuTree::paintValue(uint8_t row, const MenuEntry *e, boolean erase) {
+  char     s[MENU_TREE_TEXT];
+  uint16_t c = color;
+  int16_t  v = 0;
+
+  s[0] = 0;
+  if(e->type == MENU_NUMBER) {
+    MenuNumber n;
+    memcpy_P(&n, e->data, sizeof(n));
+    if(edit && (stack[depth].top + row == stack[depth].selected)) {
+      v = edited;
+      c = accent;
+    }
+    else v = handlers->get(e->id);
+    char *end = formatSigned(s, v);
+    if(n.unit) {
+      strncpy_P(end, n.unit, s + sizeof(s) - 1 - end);
+      s[sizeof(s) - 1] = 0;
+    }
+  }
+  else if(e->type == MENU_SUBMENU) strcpy(s, ">");
+  rowKey[row] = v;
+
+  if(erase) {
+    gfx->fillRect(x + w - MENU_TREE_VALUE, rowY(row), MENU_TREE_VALUE,
+      MENU_TREE_ROW, bg);
+  }
+  if(!s[0]) return;
+
+  int16_t  bx, by;
+  uint16_t bw, bh;
+  textBounds(font, 1, s, 0, 0, &bx, &by, &bw, &bh);
+  gfx->setFont(font);
+  gfx->setTextSize(1);
+  gfx->setTextColor(c);
+  gfx->setCursor(x + w - MENU_TREE_MARGIN - (bx + bw), rowY(row) + MENU_TREE_BASELINE);
+  gfx->print(s);
+}
+
+// A page line, across the row
+void MenuTree::paintLine(uint8_t row, const char *s) {
+  uint16_t key = hash(s);
+  if((rowEntry[row] == row) && (rowKey[row] == key)) return;
+  if(rowEntry[row] != NONE) {
+    gfx->fillRect(x + MENU_TREE_GUTTER, rowY(row), w - MENU_TREE_GUTTER,
+      MENU_TREE_ROW, bg);
+  }
+  gfx->setFont(font);
+  gfx->setTextSize(1);
+  gfx->setTextColor(color);
+  gfx->setCursor(x + MENU_TREE_GUTTER, rowY(row) + MENU_TREE_BASELINE);
+  gfx->print(s);
+  rowEntry[row] = row;
+  rowKey[row]   = key;
+}
+
+void MenuTree::clearRow(uint8_t row) {
+  if(rowEntry[row] == NONE) return;
+  gfx->fillRect(x + MENU_TREE_GUTTER, rowY(row), w - MENU_TREE_GUTTER,
+    MENU_TREE_ROW, bg);
+  rowEntry[row] = NONE;
+}
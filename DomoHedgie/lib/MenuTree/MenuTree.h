@@ -0,0 +1,153 @@
+// Menu tree described in flash and drawn incrementally on a TFT.
+//
+// The sketch declares its menus as PROGMEM tables, e.g.
+//   const char tempLabel[] PROGMEM = "Set min. temperature";
+//   const MenuNumber tempRange PROGMEM = { 23, 30, 1, celsius };
+//   const MenuEntry rootEntries[] PROGMEM = {
+//     { tempLabel, MENU_NUMBER, TEMP_ID, &tempRange }, ...
+//   };
+//   const MenuList rootMenu PROGMEM = MENU_LIST(rootTitle, rootEntries);
+// and MenuTree walks them with nothing copied to RAM but the entry being
+// looked at.  Entries open a submenu, edit a number through the sketch's
+// get()/set() handlers, show a read-only page whose lines the sketch
+// writes, or call the sketch's action() handler.
+//
+// On screen the menu is a title bar over one row per entry, a page of
+// rows at a time.  Each row remembers which entry it shows and a key of
+// its value (the number, or a hash of a page line), so only rows whose
+// content changed are repainted: turning the encoder within a page just
+// moves the selection marker in the left gutter, and editing a number
+// repaints its value column.
+
+#ifndef _MENU_TREE_H_
+#define _MENU_TREE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include <Adafruit_GFX.h>
+
+#define MENU_TREE_DEPTH    3   // Nested lists, the root one included
+#define MENU_TREE_ROWS     8   // Most rows on screen at once
+#define MENU_TREE_TEXT     24  // Longest value or page line, with the NUL
+
+// Geometry, in pixels
+#define MENU_TREE_TITLE    24  // Title bar height
+#define MENU_TREE_ROW      28  // Row height
+#define MENU_TREE_BASELINE 20  // Text baseline from the top of a row
+#define MENU_TREE_GUTTER   18  // Selection marker column on the left
+#define MENU_TREE_VALUE    150 // Value column on the right; labels must
+                               // end before it
+#define MENU_TREE_MARGIN   8   // Between the value and the right edge
+
+// Entry types, and what their data points to
+#define MENU_SUBMENU 0 // const MenuList *
+#define MENU_NUMBER  1 // const MenuNumber *
+#define MENU_PAGE    2 // Nothing; lines come from the page() handler
+#define MENU_ACTION  3 // Nothing
+
+struct MenuEntry {
+  const char *label;   // In flash
+  uint8_t     type,
+              id;      // Passed to the handlers
+  const void *data;    // In flash, see the entry types
+};
+
+struct MenuList {
+  const char      *title;   // In flash
+  const MenuEntry *entries; // In flash
+  uint8_t          count;
+};
+
+#define MENU_LIST(title, entries) \
+  { title, entries, sizeof(entries) / sizeof(entries[0]) }
+
+struct MenuNumber {
+  int16_t     min, max, step;
+  const char *unit;    // In flash, printed after the value
+};
+
+struct MenuHandlers {
+  int16_t (*get)(uint8_t id);
+  void    (*set)(uint8_t id, int16_t value);
+  // Writes line 'line' of the page into 's' (at most 'size' bytes with
+  // the NUL); false past the last line.
+  boolean (*page)(uint8_t id, uint8_t line, char *s, uint8_t size);
+  void    (*action)(uint8_t id);
+};
+
+class MenuTree {
+
+ public:
+
+  MenuTree(Adafruit_GFX *gfx, const GFXfont *font, const GFXfont *titleFont,
+    const MenuHandlers *handlers, uint16_t color, uint16_t bg,
+    uint16_t accent);
+
+  // Root list and the screen area the menu covers when open
+  void    begin(const MenuList *root, int16_t x, int16_t y, int16_t w,
+            int16_t h);
+
+  // Paints the menu at the root list, on the entry selected when it was
+  // last closed.  close() only forgets the menu is on screen: the owner
+  // repaints what was under it.
+  void    open(void),
+          close(void);
+  boolean shown(void) const;
+
+  // Moves the selection by the encoder's detents, wrapping round the
+  // list, or steps the number being edited, stopping at its limits.
+  void    move(int8_t detents);
+  // Opens the selected submenu or page, starts editing a number or keeps
+  // the edited value, or runs an action (which may close the menu).
+  void    enter(void);
+  // Drops an edit, or goes back one level; closes the menu from the root
+  // list.  Returns false once the menu is closed.
+  boolean cancel(void);
+  // Takes in numbers and page lines that changed behind the menu's back,
+  // repainting only those rows.
+  void    refresh(void);
+
+  // Selected entry of the list shown, and how deep that list is
+  uint8_t selection(void) const,
+          level(void) const;
+  boolean editing(void) const;
+
+ private:
+
+  void    list(MenuList *l) const,
+          entry(uint8_t index, MenuEntry *e) const,
+          paintAll(void),
+          paintRows(void),
+          paintMarker(void),
+          paintRow(uint8_t row, uint8_t index, const MenuEntry *e),
+          paintValue(uint8_t row, const MenuEntry *e, boolean erase = true),
+          paintLine(uint8_t row, const char *s),
+          clearRow(uint8_t row);
+  int16_t rowY(uint8_t row) const;
+
+  struct Level {
+    const MenuList *list;
+    uint8_t         selected, top;
+  };
+
+  Adafruit_GFX       *gfx;
+  const GFXfont      *font, *titleFont;
+  const MenuHandlers *handlers;
+  uint16_t            color, bg, accent;
+  int16_t             x, y, w, h;
+  uint8_t             rows,                  // Rows that fit in the area
+                      depth,                 // Index of the list shown
+                      page,                  // Entry shown as a page
+                      marker;                // Row with the marker
+  boolean             isOpen, edit;
+  int16_t             edited;                // Value being edited
+  Level               stack[MENU_TREE_DEPTH];
+  uint8_t             rowEntry[MENU_TREE_ROWS]; // Entry or line on each row
+  uint16_t            rowKey[MENU_TREE_ROWS];   // Value shown on each row
+};
+
+#endif // _MENU_TREE_H_
@@ -0,0 +1,77 @@
+#include "MuxScanner.h"
+
+MuxScanner::MuxScanner(void) :
+  inReg(NULL), bitMask(0), channel(0), bit(1), raw(0xFF), count0(0xFF),
+  count1(0xFF), debounced(0xFF), changed(0) {
+  for(uint8_t i=0; i<3; i++) {
+    selReg[i]  = NULL;
+    selMask[i] = 0;
+  }
+}
+
+void MuxScanner::begin(uint8_t s0, uint8_t s1, uint8_t s2, uint8_t z) {
+  const uint8_t pins[3] = { s0, s1, s2 };
+  for(uint8_t i=0; i<3; i++) {
+    pinMode(pins[i], OUTPUT);
+    selReg[i]  = portOutputRegister(digitalPinToPort(pins[i]));
+    selMask[i] = digitalPinToBitMask(pins[i]);
+  }
+  pinMode(z, INPUT);
+  inReg   = portInputRegister(digitalPinToPort(z));
+  bitMask = digitalPinToBitMask(z);
+
+  raw = 0;
+  for(uint8_t c=0; c<MUX_SCANNER_CHANNELS; c++) {
+    for(uint8_t i=0; i<3; i++) digitalWrite(pins[i], bitRead(c, i));
+    delayMicroseconds(5);
+    if(*inReg & bitMask) raw |= 1 << c;
+  }
+  debounced = raw;
+  changed   = 0;
+  count0    = count1 = 0xFF;
+  channel   = 0;
+  bit       = 1;
+  for(uint8_t i=0; i<3; i++) digitalWrite(pins[i], LOW);
+}
+
+void MuxScanner::select(uint8_t channel) {
+  for(uint8_t i=0; i<3; i++) {
+    if(channel & (1 << i)) *selReg[i] |=  selMask[i];
+    else                   *selReg[i] &= ~selMask[i];
+  }
+}
+
+void MuxScanner::scan(void) {
+  if(*inReg & bitMask) raw |=  bit;
+  else                 raw &= ~bit;
+  channel = (channel + 1) & (MUX_SCANNER_CHANNELS - 1);
+  bit     = 1 << channel;
+  select(channel);
+  if(channel) return;
+
+  // End of a pass: each bit of count1:count0 counts down the passes its
+  // channel has differed from the debounced level, and is reset by any
+  // pass that agrees; the level flips when the count wraps
+  uint8_t differs = raw ^ debounced;
+  count0  = ~(count0 & differs);
+  count1  = count0 ^ (count1 & differs);
+  differs &= count0 & count1;
+  debounced ^= differs;
+  changed   |= differs;
+}
+
+uint8_t MuxScanner::state(void) const {
+  return debounced;
+}
+
+uint8_t MuxScanner::read(uint8_t channel) const {
+  return (debounced >> channel) & 1;
+}
+
+uint8_t MuxScanner::changes(void) {
+  noInterrupts();
+  uint8_t c = changed;
+  changed   = 0;
+  interrupts();
+  return c;
+}
@@ -0,0 +1,56 @@
+// 74HC4051 inputs scanned in the background.
+//
+// The sketch runs a hardware timer and forwards its compare interrupt to
+// scan(), e.g.
+//   ISR(TIMER5_COMPA_vect) { muxScanner.scan(); }
+// Each call reads the common pin for the channel selected by the call
+// before, so the mux has a whole timer period to settle, and selects the
+// next one with direct port writes.  After every pass over the eight
+// channels each input goes through a vertical counter: it must read the
+// same in MUX_SCANNER_PASSES passes in a row before state() follows it,
+// and the channels that changed are collected for changes().
+
+#ifndef _MUX_SCANNER_H_
+#define _MUX_SCANNER_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#define MUX_SCANNER_CHANNELS 8
+#define MUX_SCANNER_PASSES   4 // Set by the 2-bit vertical counter
+
+class MuxScanner {
+
+ public:
+
+  MuxScanner(void);
+
+  // Select lines s0-s2 and common pin z.  Reads every channel once, so
+  // state() is valid on return; start the timer afterwards.
+  void     begin(uint8_t s0, uint8_t s1, uint8_t s2, uint8_t z);
+
+  void     scan(void);            // Call from the timer interrupt
+
+  // Bit n: debounced level of channel n
+  uint8_t  state(void) const;
+  uint8_t  read(uint8_t channel) const; // HIGH or LOW
+
+  // Channels whose debounced level changed since the last call
+  uint8_t  changes(void);
+
+ private:
+
+  void     select(uint8_t channel);
+
+  volatile uint8_t *selReg[3], *inReg;
+  uint8_t           selMask[3], bitMask;
+  uint8_t           channel, bit;  // Selected channel and its bit
+  uint8_t           raw;           // Levels read in the current pass
+  uint8_t           count0, count1;
+  volatile uint8_t  debounced, changed;
+};
+
+#endif // _MUX_SCANNER_H_
@@ -0,0 +1,66 @@
+#include "RotaryEncoder.h"
+
+// Quarter steps for each transition, indexed by (old state << 2) | new
+// state; 0 for no change, and for a skipped state, whose direction is
+// unknown.  Clockwise runs 00, 10, 11, 01.
+static const int8_t steps[16] PROGMEM = {
+   0, -1, +1,  0,
+  +1,  0,  0, -1,
+  -1,  0,  0, +1,
+   0, +1, -1,  0
+};
+
+RotaryEncoder::RotaryEncoder(void) :
+  inRegA(NULL), inRegB(NULL), bitMaskA(0), bitMaskB(0), state(0), rest(0),
+  quarters(0), pending(0), head(0), tail(0) {
+}
+
+void RotaryEncoder::begin(uint8_t pinA, uint8_t pinB) {
+  inRegA   = portInputRegister(digitalPinToPort(pinA));
+  bitMaskA = digitalPinToBitMask(pinA);
+  inRegB   = portInputRegister(digitalPinToPort(pinB));
+  bitMaskB = digitalPinToBitMask(pinB);
+  pinMode(pinA, INPUT);
+  pinMode(pinB, INPUT);
+  state    = ((*inRegA & bitMaskA) ? 2 : 0) | ((*inRegB & bitMaskB) ? 1 : 0);
+  rest     = state;
+  quarters = 0;
+  pending  = 0;
+  head     = tail = 0;
+}
+
+boolean RotaryEncoder::read(int8_t *detents) {
+  if(tail != head) {
+    *detents = ring[tail & (ROTARY_ENCODER_QUEUE - 1)];
+    tail++;
+    return true;
+  }
+  // Ring empty: anything left over from when it was full is the newest
+  noInterrupts();
+  int8_t n = pending;
+  pending  = 0;
+  interrupts();
+  if(!n) return false;
+  *detents = n;
+  return true;
+}
+
+void RotaryEncoder::edge(void) {
+  uint8_t s = ((*inRegA & bitMaskA) ? 2 : 0) | ((*inRegB & bitMaskB) ? 1 : 0);
+  quarters += (int8_t)pgm_read_byte(&steps[(state << 2) | s]);
+  state = s;
+  if(s != rest) return;
+
+  // Back in the detent: a full cycle is 4 quarter steps, more than half
+  // of one in either direction counts
+  int8_t n = pending;
+  if((quarters > 1) && (n < 127)) n++;
+  else if((quarters < -1) && (n > -127)) n--;
+  quarters = 0;
+  if(n && ((uint8_t)(head - tail) < ROTARY_ENCODER_QUEUE)) {
+    ring[head & (ROTARY_ENCODER_QUEUE - 1)] = n;
+    head++;
+    n = 0;
+  }
+  pending = n;
+}
@@ -0,0 +1,55 @@
+// Quadrature rotary encoder decoded in its pin interrupts.
+//
+// The sketch attaches both pins' interrupts (CHANGE) and forwards them to
+// edge(), e.g.
+//   void encoderEdge() { encoder.edge(); }
+// Every edge reads both pins straight from their input registers and looks
+// the transition up in a Gray-code table, so direction comes from the
+// sequence of states rather than from sampling one pin later on, and
+// bounces cancel out.  A detent is counted when the encoder is back in its
+// rest state having moved at least half a cycle, and detents go into a
+// single-producer/single-consumer ring that loop() empties with read(),
+// never waiting on the encoder.
+
+#ifndef _ROTARY_ENCODER_H_
+#define _ROTARY_ENCODER_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#define ROTARY_ENCODER_QUEUE 8 // Entries in the ring, a power of 2
+
+class RotaryEncoder {
+
+ public:
+
+  RotaryEncoder(void);
+
+  // Call with the encoder at rest (in a detent), before attaching the
+  // interrupts.
+  void     begin(uint8_t pinA, uint8_t pinB);
+
+  // Takes the oldest detent count not read yet: positive clockwise (A
+  // leads B), negative counter-clockwise.  False if the encoder has not
+  // moved since.
+  boolean  read(int8_t *detents);
+
+  void     edge(void);            // Call from both pins' interrupts
+
+ private:
+
+  volatile uint8_t *inRegA, *inRegB;
+  uint8_t           bitMaskA, bitMaskB;
+  uint8_t           state, rest;   // (A << 1) | B
+  int8_t            quarters;      // Quarter steps since leaving rest
+  // Detents not queued yet because the ring was full
+  volatile int8_t   pending;
+  // edge() writes only 'head', read() only 'tail'
+  volatile int8_t   ring[ROTARY_ENCODER_QUEUE];
+  volatile uint8_t  head, tail;
+};
+
+#endif // _ROTARY_ENCODER_H_
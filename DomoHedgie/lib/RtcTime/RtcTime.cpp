@@ -0,0 +1,75 @@
+#include "RtcTime.h"
+
+RtcTime::RtcTime(RTC_PCF8523 *rtc, uint16_t resync) :
+  rtc(rtc), inReg(NULL), bitMask(0), ticks(0), time(0), syncTime(0),
+  resync(resync), sinceSync(0), lastTick(0), syncMillis(0), syncCount(0) {
+}
+
+void RtcTime::begin(uint8_t clkoutPin) {
+  inReg   = portInputRegister(digitalPinToPort(clkoutPin));
+  bitMask = digitalPinToBitMask(clkoutPin);
+  pinMode(clkoutPin, INPUT_PULLUP);
+  rtc->writeSqwPinMode(PCF8523_SquareWave1HZ);
+  sync();
+  lastTick = millis();
+}
+
+// Ticks that come in during the read are already in the chip's time, so
+// the count is cleared together with taking that time in
+void RtcTime::sync(void) {
+  uint32_t t = rtc->now().unixtime();
+  noInterrupts();
+  ticks = 0;
+  time  = t;
+  interrupts();
+  syncTime   = t;
+  syncMillis = millis();
+  sinceSync  = 0;
+  syncCount++;
+}
+
+boolean RtcTime::poll(void) {
+  noInterrupts();
+  uint8_t n = ticks;
+  ticks = 0;
+  interrupts();
+
+  if(!n) {
+    if(millis() - lastTick < RTC_TIME_TICK_LIMIT) return false;
+    // No clock output: whole seconds on millis() since the last read
+    uint32_t      before  = time;
+    unsigned long elapsed = (millis() - syncMillis) / 1000;
+    if(elapsed >= RTC_TIME_FALLBACK_RESYNC) sync();
+    else if(syncTime + elapsed > time) time = syncTime + elapsed;
+    return time != before;
+  }
+
+  time     += n;
+  lastTick  = millis();
+  sinceSync += n;
+  // Right after a tick, so the chip's seconds have just turned over too
+  if(sinceSync >= resync) sync();
+  return true;
+}
+
+DateTime RtcTime::now(void) const {
+  return DateTime(time);
+}
+
+uint32_t RtcTime::unixtime(void) const {
+  return time;
+}
+
+void RtcTime::adjust(const DateTime &dt) {
+  rtc->adjust(dt);
+  sync();
+}
+
+// CLKOUT falls at the start of each second
+void RtcTime::edge(void) {
+  if(!(*inReg & bitMask)) ticks++;
+}
+
+unsigned long RtcTime::reads(void) const {
+  return syncCount;
+}
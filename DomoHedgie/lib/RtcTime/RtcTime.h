@@ -0,0 +1,65 @@
+// PCF8523 time kept in RAM, advanced by the chip's 1 Hz clock output.
+//
+// begin() sets CLKOUT to 1 Hz and reads the time once.  From then on the
+// sketch forwards the pin change interrupt of the CLKOUT pin to edge(),
+// e.g.
+//   ISR(PCINT2_vect) { rtcTime.edge(); }
+// and every falling edge counts a second, which poll() adds to the cached
+// time from loop().  now() and unixtime() never touch the I2C bus; the
+// chip is only read again every 'resync' seconds.  If the clock output
+// stops ticking (CLKOUT not wired, or the chip reset) the seconds are
+// counted on millis() from the last read instead, and the chip is read
+// every RTC_TIME_FALLBACK_RESYNC seconds.
+
+#ifndef _RTC_TIME_H_
+#define _RTC_TIME_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "RTClib.h"
+
+#define RTC_TIME_RESYNC     3600 // Seconds between reads of the chip
+#define RTC_TIME_TICK_LIMIT 1100 // ms without a tick before falling back
+#define RTC_TIME_FALLBACK_RESYNC 60 // Seconds between reads without ticks
+
+class RtcTime {
+
+ public:
+
+  RtcTime(RTC_PCF8523 *rtc, uint16_t resync = RTC_TIME_RESYNC);
+
+  // 'clkoutPin' has the chip's open-drain CLKOUT on it.  Call after
+  // rtc->begin() and, if needed, rtc->adjust().
+  void     begin(uint8_t clkoutPin);
+
+  // Takes in the seconds counted by edge(); true if the time changed.
+  boolean  poll(void);
+
+  DateTime now(void) const;
+  uint32_t unixtime(void) const;  // Seconds since 1970-01-01
+
+  // Sets the chip and the cached time.
+  void     adjust(const DateTime &dt);
+
+  void     edge(void);            // Call from the pin change ISR
+
+  unsigned long reads(void) const; // Chip reads since begin()
+
+ private:
+
+  void     sync(void);
+
+  RTC_PCF8523      *rtc;
+  volatile uint8_t *inReg;
+  uint8_t           bitMask;
+  volatile uint8_t  ticks;
+  uint32_t          time, syncTime;     // Now, and at the last read
+  uint16_t          resync, sinceSync;
+  unsigned long     lastTick, syncMillis, syncCount;
+};
+
+#endif // _RTC_TIME_H_
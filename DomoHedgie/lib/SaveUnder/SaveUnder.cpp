@@ -0,0 +1,126 @@
+#include "SaveUnder.h"
+
+// Encoded tokens, each followed by its pixels' colors (high byte first):
+//   0nnnnnnn           n+1 background pixels
+//   10nnnnnn hi lo     n+1 pixels of one color
+//   11nnnnnn hi lo...  n+1 pixels given one by one
+#define TOKEN_COLOR   0x80
+#define TOKEN_LITERAL 0xC0
+#define TOKEN_COUNT   0x3F
+#define MAX_BACKGROUND 128
+#define MAX_RUN        64
+
+#define NO_LITERAL 0xFFFF
+
+// Pixels read back per burst
+#define CHUNK 32
+
+SaveUnder::SaveUnder(Adafruit_TFTLCD *tft, uint8_t *buffer, uint16_t size,
+  uint16_t background) :
+  tft(tft), buffer(buffer), size(size), background(background), length(0),
+  runColor(0), runLength(0), literal(NO_LITERAL), x(0), y(0), w(0), h(0) {
+}
+
+boolean SaveUnder::save(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if(x < 0) { w += x; x = 0; }
+  if(y < 0) { h += y; y = 0; }
+  if(x + w > tft->width() ) w = tft->width()  - x;
+  if(y + h > tft->height()) h = tft->height() - y;
+  length = 0;
+  if((w <= 0) || (h <= 0)) return true;
+
+  uint16_t chunk[CHUNK];
+  uint32_t left = (uint32_t)w * h;
+  boolean  fits = true;
+
+  // Background only is the best case, one byte per MAX_BACKGROUND pixels
+  if((left + MAX_BACKGROUND - 1) / MAX_BACKGROUND > size) return false;
+
+  runLength = 0;
+  literal   = NO_LITERAL;
+  tft->startReadRect(x, y, w, h);
+  while(fits && left) {
+    uint8_t n = (left < CHUNK) ? left : CHUNK;
+    tft->readPixels(chunk, n);
+    left -= n;
+    for(uint8_t i=0; fits && (i<n); i++) {
+      uint16_t c = chunk[i];
+      if(runLength && (c == runColor) &&
+         (runLength < ((c == background) ? MAX_BACKGROUND : MAX_RUN))) {
+        runLength++;
+      } else {
+        fits      = flushRun();
+        runColor  = c;
+        runLength = 1;
+      }
+    }
+  }
+  tft->endReadRect();
+
+  if(fits) fits = flushRun();
+  if(!fits) {
+    length = 0;
+    return false;
+  }
+  this->x = x;
+  this->y = y;
+  this->w = w;
+  this->h = h;
+  return true;
+}
+
+void SaveUnder::restore(void) {
+  uint16_t pos = 0, pixels[MAX_RUN];
+  boolean  first = true;
+
+  if(!length) return;
+  tft->setAddrWindow(x, y, x + w - 1, y + h - 1);
+  while(pos < length) {
+    uint8_t token = buffer[pos++];
+    if(!(token & TOKEN_COLOR)) {
+      tft->pushColor(background, token + 1, first);
+    } else if((token & TOKEN_LITERAL) == TOKEN_COLOR) {
+      tft->pushColor(((uint16_t)buffer[pos] << 8) | buffer[pos + 1],
+        (token & TOKEN_COUNT) + 1, first);
+      pos += 2;
+    } else {
+      uint8_t n = (token & TOKEN_COUNT) + 1;
+      for(uint8_t i=0; i<n; i++, pos+=2) {
+        pixels[i] = ((uint16_t)buffer[pos] << 8) | buffer[pos + 1];
+      }
+      tft->pushColors(pixels, n, first);
+    }
+    first = false;
+  }
+}
+
+uint16_t SaveUnder::used(void) {
+  return length;
+}
+
+boolean SaveUnder::put(uint8_t b) {
+  if(length >= size) return false;
+  buffer[length++] = b;
+  return true;
+}
+
+// Writes out the pending run.  A single pixel of a color other than the
+// background joins the open literal token, or starts one.
+boolean SaveUnder::flushRun(void) {
+  if(!runLength) return true;
+  if(runColor == background) {
+    literal = NO_LITERAL;
+    return put(runLength - 1);
+  }
+  if(runLength > 1) {
+    literal = NO_LITERAL;
+    if(!put(TOKEN_COLOR | (runLength - 1))) return false;
+  } else if((literal != NO_LITERAL) &&
+            ((buffer[literal] & TOKEN_COUNT) < TOKEN_COUNT)) {
+    buffer[literal]++;
+  } else {
+    literal = length;
+    if(!put(TOKEN_LITERAL)) return false;
+  }
+  return put(runColor >> 8) && put(runColor);
+}
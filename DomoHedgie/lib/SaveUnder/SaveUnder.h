@@ -0,0 +1,54 @@
+// Save-under for overlays on Adafruit_TFTLCD.
+//
+// save() reads a screen rectangle back from the controller in one burst
+// and keeps it, run-length encoded, in a buffer the caller provides;
+// restore() writes it back through a single address window.  Runs of the
+// background color cost one byte per 128 pixels and runs of any other
+// color three bytes per 64, so flat areas and text keep small; dithered
+// or photographic areas take up to a little over two bytes per pixel and
+// may not fit, in which case save() says so and the caller has to redraw
+// instead.  The buffer is the caller's to size: 2 KB on a Mega holds a
+// flat band across the screen, not the dithered sections.
+
+#ifndef _SAVE_UNDER_H_
+#define _SAVE_UNDER_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include <Adafruit_TFTLCD.h>
+
+class SaveUnder {
+
+ public:
+
+  SaveUnder(Adafruit_TFTLCD *tft, uint8_t *buffer, uint16_t size,
+    uint16_t background);
+
+  // Reads the rectangle (clipped to the screen).  False if it does not
+  // fit in the buffer, found out before reading when not even a
+  // rectangle of background would; nothing is kept then.
+  boolean  save(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Puts the last saved rectangle back; it stays saved
+  void     restore(void);
+  // Buffer bytes taken by the saved rectangle (0: none)
+  uint16_t used(void);
+
+ private:
+
+  boolean  put(uint8_t b),
+           flushRun(void);
+
+  Adafruit_TFTLCD *tft;
+  uint8_t         *buffer;
+  uint16_t         size, background,
+                   length,           // Bytes used
+                   runColor, runLength,
+                   literal;          // Open literal token (0xFFFF: none)
+  int16_t          x, y, w, h;
+};
+
+#endif // _SAVE_UNDER_H_
@@ -0,0 +1,93 @@
+#include "Scheduler.h"
+
+Task::Task(const char *name, TaskCallback callback, unsigned long period,
+  unsigned long deadline) :
+  label(name), callback(callback), interval(period), limit(deadline), due(0),
+  running(false), link(NULL) {
+  resetStats();
+}
+
+const char *Task::name(void) const {
+  return label;
+}
+
+unsigned long Task::period(void) const {
+  return interval;
+}
+
+unsigned long Task::deadline(void) const {
+  return limit;
+}
+
+boolean Task::active(void) const {
+  return running;
+}
+
+const TaskStats &Task::stats(void) const {
+  return counters;
+}
+
+void Task::resetStats(void) {
+  memset(&counters, 0, sizeof(counters));
+}
+
+Task *Task::next(void) const {
+  return link;
+}
+
+Scheduler::Scheduler(void) : head(NULL) {
+}
+
+void Scheduler::add(Task *task) {
+  Task **t = &head;
+  while(*t) {
+    if(*t == task) return;
+    t = &(*t)->link;
+  }
+  task->link = NULL;
+  *t = task;
+}
+
+void Scheduler::start(Task *task, unsigned long delay) {
+  task->due     = millis() + delay;
+  task->running = true;
+}
+
+void Scheduler::stop(Task *task) {
+  task->running = false;
+}
+
+uint8_t Scheduler::run(void) {
+  uint8_t ran = 0;
+  for(Task *t=head; t; t=t->link) {
+    unsigned long now  = millis(),
+                  late = now - t->due;
+    if(!t->running || ((long)late < 0)) continue;
+
+    TaskStats *s = &t->counters;
+    if(late > s->maxLateness) s->maxLateness = late;
+    if(t->limit && (late > t->limit)) s->lateRuns++;
+
+    // Next slot on the grid; whole periods already gone are dropped
+    if(t->interval) {
+      unsigned long skipped = late / t->interval;
+      s->missed += skipped;
+      t->due    += (skipped + 1) * t->interval;
+    } else {
+      t->running = false;
+    }
+
+    unsigned long began = micros();
+    t->callback();
+    unsigned long spent = micros() - began;
+    s->runs++;
+    s->totalRunTime += spent;
+    if(spent > s->maxRunTime) s->maxRunTime = spent;
+    ran++;
+  }
+  return ran;
+}
+
+Task *Scheduler::tasks(void) const {
+  return head;
+}
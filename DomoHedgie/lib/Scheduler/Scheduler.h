@@ -0,0 +1,90 @@
+// Cooperative task scheduler for loop().
+//
+// Tasks are statically allocated and linked into a Scheduler with add(),
+// so nothing is allocated at run time.  A periodic task falls due every
+// 'period' ms on a fixed grid counted from start(): a late run does not
+// push the next ones back, and periods that go by entirely while other
+// tasks hold the CPU are counted as missed instead of being run back to
+// back.  A one-shot task (period 0) runs once, 'delay' ms after start().
+//
+// run() calls every due task in the order they were added.  Each task
+// keeps how late it started against its due time, how long its callback
+// took and how many runs started later than its deadline, so worst-case
+// latencies can be read off a running system.  Callbacks are expected to
+// return quickly; anything that takes longer should be split into steps.
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+typedef void (*TaskCallback)(void);
+
+typedef struct {
+  unsigned long runs,          // Callback calls
+                missed,        // Periods skipped because the task was late
+                lateRuns,      // Runs that started past the deadline
+                maxLateness,   // ms from due time to start
+                maxRunTime,    // us
+                totalRunTime;  // us
+} TaskStats;
+
+class Task {
+
+ public:
+
+  // 'deadline' is how many ms after its due time the task may start;
+  // 0 leaves it unchecked.
+  Task(const char *name, TaskCallback callback, unsigned long period,
+       unsigned long deadline = 0);
+
+  const char      *name(void) const;
+  unsigned long    period(void) const;
+  unsigned long    deadline(void) const;
+  boolean          active(void) const;
+  const TaskStats &stats(void) const;
+  void             resetStats(void);
+
+  Task            *next(void) const;
+
+ private:
+
+  friend class Scheduler;
+
+  const char   *label;
+  TaskCallback  callback;
+  unsigned long interval, limit, due;
+  boolean       running;
+  TaskStats     counters;
+  Task         *link;
+};
+
+class Scheduler {
+
+ public:
+
+  Scheduler(void);
+
+  // Links 'task' in after the ones already added.  It stays idle until
+  // start() is called.
+  void  add(Task *task);
+
+  // Makes 'task' due 'delay' ms from now, restarting it if already active.
+  void  start(Task *task, unsigned long delay = 0);
+  void  stop(Task *task);
+
+  // Runs every due task once.  Call it from loop(); returns how many ran.
+  uint8_t run(void);
+
+  Task *tasks(void) const; // First task added, then Task::next()
+
+ private:
+
+  Task *head;
+};
+
+#endif // _SCHEDULER_H_
@@ -0,0 +1,86 @@
+#include "StripChart.h"
+
+StripChart::StripChart(Adafruit_TFTLCD *tft, int16_t *samples,
+  uint16_t capacity, uint16_t color, uint16_t background) :
+  tft(tft), samples(samples), min(0), max(100), x(0), y(0), w(0), h(0),
+  capacity(capacity), head(0), count(0), cursor(0), color(color),
+  background(background), shown(false), scrolling(false) {
+}
+
+void StripChart::setRange(int16_t min, int16_t max) {
+  this->min = min;
+  this->max = (max > min) ? max : min + 1;
+}
+
+// 'age' 0 is the newest value
+int16_t StripChart::sample(uint16_t age) const {
+  return samples[(head + capacity - 1 - age) % capacity];
+}
+
+int16_t StripChart::lineFor(int16_t value) const {
+  if(value < min) value = min;
+  if(value > max) value = max;
+  return y + h - 1 - (int32_t)(value - min) * (h - 1) / (max - min);
+}
+
+// Background, then the segment from the previous value to this one
+void StripChart::drawColumn(uint16_t column, uint16_t age) {
+  int16_t cx = x + column;
+
+  tft->drawFastVLine(cx, y, h, background);
+  if(age >= count) return;
+  int16_t y1 = lineFor(sample(age)),
+          y0 = (age + 1 < count) ? lineFor(sample(age + 1)) : y1;
+  if(y0 > y1) { int16_t t = y0; y0 = y1; y1 = t; }
+  tft->drawFastVLine(cx, y0, y1 - y0 + 1, color);
+}
+
+void StripChart::add(int16_t value) {
+  samples[head] = value;
+  head = (head + 1) % capacity;
+  if(count < capacity) count++;
+  if(!shown) return;
+
+  if(scrolling) {
+    // The oldest column is on the left: scroll it round to the right and
+    // draw the new value over it
+    uint16_t column = cursor;
+    cursor = (cursor + 1) % w;
+    tft->scrollTo(cursor);
+    drawColumn(column, 0);
+  } else {
+    drawColumn(cursor, 0);
+    cursor = (cursor + 1) % w;
+    drawColumn(cursor, capacity); // Blank
+  }
+}
+
+void StripChart::show(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if(w > (int16_t)capacity) w = capacity;
+  this->x = x;
+  this->y = y;
+  this->w = w;
+  this->h = h;
+  shown   = true;
+  cursor  = 0;
+  // The controller scrolls whole columns, so the area must span them
+  scrolling = tft->scrollsAlongX() && (y == 0) && (h == tft->height()) &&
+    tft->setScrollArea(x, w);
+
+  if(scrolling) {
+    // Newest on the right edge, scroll offset 0
+    for(int16_t column=0; column<w; column++) drawColumn(column, w - 1 - column);
+  } else {
+    // Latest values from the left, the blank column after them
+    uint16_t n = (count < (uint16_t)w) ? count : w - 1;
+    for(int16_t column=0; column<w; column++) {
+      drawColumn(column, (column < (int16_t)n) ? n - 1 - column : capacity);
+    }
+    cursor = n;
+  }
+}
+
+void StripChart::hide(void) {
+  if(scrolling) tft->scrollTo(0);
+  shown = scrolling = false;
+}
@@ -0,0 +1,59 @@
+// Scrolling strip chart for Adafruit_TFTLCD.
+//
+// A StripChart plots one value per column, newest on the right, each joined
+// to the one before.  If its area runs the whole height of the screen and
+// the controller scrolls along x (9341/HX8357D in rotation 1 or 3), a new
+// value scrolls the area in hardware and only its column is drawn.
+// Anywhere else the trace sweeps across the area like an oscilloscope's,
+// blanking the column ahead of it.  Values are kept, one per column, in a
+// buffer the caller provides, so the chart keeps recording while another
+// screen is shown and show() can draw it in full.
+
+#ifndef _STRIP_CHART_H_
+#define _STRIP_CHART_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include <Adafruit_TFTLCD.h>
+
+class StripChart {
+
+ public:
+
+  StripChart(Adafruit_TFTLCD *tft, int16_t *samples, uint16_t capacity,
+    uint16_t color, uint16_t background);
+
+  // Values plotted from the bottom to the top of the area; others are
+  // held at the nearest edge
+  void    setRange(int16_t min, int16_t max);
+  // Records a value, and draws it while the chart is shown
+  void    add(int16_t value);
+  // Takes over the area and draws the latest values, as many as fit in
+  // 'w' (at most 'capacity') columns
+  void    show(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Stops drawing, with any hardware scroll undone
+  void    hide(void);
+
+ private:
+
+  int16_t sample(uint16_t age) const,
+          lineFor(int16_t value) const;
+  void    drawColumn(uint16_t column, uint16_t age);
+
+  Adafruit_TFTLCD *tft;
+  int16_t         *samples,
+                   min, max,
+                   x, y, w, h;
+  uint16_t         capacity,
+                   head,             // Where the next value is stored
+                   count,            // Values stored, up to 'capacity'
+                   cursor;           // Column the next value is drawn in
+  uint16_t         color, background;
+  boolean          shown, scrolling;
+};
+
+#endif // _STRIP_CHART_H_
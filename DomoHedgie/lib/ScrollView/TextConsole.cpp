@@ -0,0 +1,65 @@
+#include "TextConsole.h"
+
+// Classic font cell, spacing included
+#define CHAR_WIDTH  6
+#define CHAR_HEIGHT 8
+
+TextConsole::TextConsole(Adafruit_TFTLCD *tft, uint16_t color,
+  uint16_t background, uint8_t size) :
+  tft(tft), color(color), background(background), size(size), lines(0),
+  count(0), next(0), x(0), y(0), w(0), scrolling(false) {
+}
+
+void TextConsole::begin(int16_t x, int16_t y, int16_t w, int16_t h) {
+  this->x = x;
+  this->y = y;
+  this->w = w;
+  lines   = h / (CHAR_HEIGHT * size);
+  count   = next = 0;
+  // The controller scrolls whole rows, so the area must span them
+  scrolling = !tft->scrollsAlongX() && (x == 0) && (w == tft->width()) &&
+    tft->setScrollArea(y, lines * CHAR_HEIGHT * size);
+  tft->fillRect(x, y, w, h, background);
+}
+
+void TextConsole::end(void) {
+  if(scrolling) tft->scrollTo(0);
+  scrolling = false;
+  lines     = 0;
+}
+
+void TextConsole::println(const char *text) {
+  if(!lines) return;
+
+  if(scrolling) {
+    if(count < lines) {
+      drawLine(count++, text);
+    } else {
+      // The oldest line is at the top: scroll it round to the bottom and
+      // write the new one over it
+      uint8_t slot = next;
+      next = (next + 1) % lines;
+      tft->scrollTo(next * CHAR_HEIGHT * size);
+      drawLine(slot, text);
+    }
+  } else {
+    drawLine(next, text);
+    next = (next + 1) % lines;
+    if(count < lines - 1) count++;
+    else if(lines > 1) drawLine(next, "");
+  }
+}
+
+// Text opaquely from the left edge, then background to the right edge
+void TextConsole::drawLine(uint8_t slot, const char *text) {
+  int16_t cx  = x,
+          top = y + slot * CHAR_HEIGHT * size,
+          end = x + w - CHAR_WIDTH * size;
+
+  tft->setFont(NULL);
+  while(*text && (cx <= end)) {
+    tft->drawChar(cx, top, *text++, color, background, size);
+    cx += CHAR_WIDTH * size;
+  }
+  if(cx < x + w) tft->fillRect(cx, top, x + w - cx, CHAR_HEIGHT * size, background);
+}
@@ -0,0 +1,50 @@
+// Scrolling text log for Adafruit_TFTLCD.
+//
+// A TextConsole prints lines of classic-font text into a screen rectangle,
+// newest at the bottom.  If the rectangle runs the whole width of the
+// screen and the controller scrolls along y (9341/HX8357D in rotation 0
+// or 2), a new line scrolls the area in hardware and only that line is
+// drawn.  Anywhere else the lines wrap round in place: each new one takes
+// the place of the oldest, with a blank line after it marking where the
+// log continues.  Either way println() draws one line.
+
+#ifndef _TEXT_CONSOLE_H_
+#define _TEXT_CONSOLE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include <Adafruit_TFTLCD.h>
+
+class TextConsole {
+
+ public:
+
+  TextConsole(Adafruit_TFTLCD *tft, uint16_t color, uint16_t background,
+    uint8_t size = 1);
+
+  // Takes over and clears the area; the height is used in whole lines
+  void    begin(int16_t x, int16_t y, int16_t w, int16_t h);
+  // Gives the area back, with any hardware scroll undone
+  void    end(void);
+  // Longer lines are cut at the area's right edge
+  void    println(const char *text);
+
+ private:
+
+  void    drawLine(uint8_t slot, const char *text);
+
+  Adafruit_TFTLCD *tft;
+  uint16_t         color, background;
+  uint8_t          size,
+                   lines,            // Lines in the area
+                   count,            // Lines printed, up to 'lines'
+                   next;             // Slot the next line goes to
+  int16_t          x, y, w;
+  boolean          scrolling;
+};
+
+#endif // _TEXT_CONSOLE_H_
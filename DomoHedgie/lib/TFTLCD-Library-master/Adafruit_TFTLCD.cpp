@@ -18,21 +18,38 @@
 #include "Adafruit_TFTLCD.h"
 #include "pin_magic.h"
 
+#ifndef pgm_read_dword
+ #define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#endif
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+ #define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#else
+ #define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+#endif
+
 #define TFTWIDTH   320
 #define TFTHEIGHT  480
 
 //#define TFTWIDTH   240
 //#define TFTHEIGHT  320
 
-// LCD controller chip identifiers
-#define ID_932X    0
-#define ID_7575    1
-#define ID_9341    2
-#define ID_HX8357D    3
-#define ID_UNKNOWN 0xFF
+// With TFTLCD_DRIVER set, driver tests fold to constants and the other
+// controllers' code drops out; DRIVER_BUILT() keeps their init tables
+// and begin() branches out of the build altogether.
+#ifdef TFTLCD_DRIVER
+ #define DRIVER_IS(id)    (TFTLCD_DRIVER == (id))
+ #define DRIVER_BUILT(id) (TFTLCD_DRIVER == (id))
+#else
+ #define DRIVER_IS(id)    (driver == (id))
+ #define DRIVER_BUILT(id) 1
+#endif
 
 #include "registers.h"
 
+#ifdef read8isFunctionalized
+  #define read8(x) x=read8fn()
+#endif
+
 // Constructor for breakout board (configurable LCD control lines).
 // Can still use this w/shield, but parameters are ignored.
 Adafruit_TFTLCD::Adafruit_TFTLCD(
@@ -42,7 +59,7 @@ Adafruit_TFTLCD::Adafruit_TFTLCD(
 #ifndef USE_ADAFRUIT_SHIELD_PINOUT
   // Convert pin numbers to registers and bitmasks
   _reset     = reset;
-  #ifdef __AVR__
+  #if defined(__AVR__) || defined(TFTLCD_HOST_SIM)
     csPort     = portOutputRegister(digitalPinToPort(cs));
     cdPort     = portOutputRegister(digitalPinToPort(cd));
     wrPort     = portOutputRegister(digitalPinToPort(wr));
@@ -62,7 +79,7 @@ Adafruit_TFTLCD::Adafruit_TFTLCD(
   cdPinUnset = ~cdPinSet;
   wrPinUnset = ~wrPinSet;
   rdPinUnset = ~rdPinSet;
-  #ifdef __AVR__
+  #if defined(__AVR__) || defined(TFTLCD_HOST_SIM)
     *csPort   |=  csPinSet; // Set all control bits to HIGH (idle)
     *cdPort   |=  cdPinSet; // Signals are ACTIVE LOW
     *wrPort   |=  wrPinSet;
@@ -116,10 +133,14 @@ void Adafruit_TFTLCD::init(void) {
   textcolor = 0xFFFF;
   _width    = TFTWIDTH;
   _height   = TFTHEIGHT;
+  winX1     = winY1 = 0xFFFF;
+  fullWindow = false;
+  scrollLines = 0;
 }
 
 // Initialization command tables for different LCD controllers
 #define TFTLCD_DELAY 0xFF
+#if DRIVER_BUILT(ID_7575)
 static const uint8_t HX8347G_regValues[] PROGMEM = {
   0x2E           , 0x89,
   0x29           , 0x8F,
@@ -171,7 +192,9 @@ static const uint8_t HX8347G_regValues[] PROGMEM = {
   0x08           , 0x01,
   0x09           , 0x3F
 };
+#endif
 
+#if DRIVER_BUILT(ID_HX8357D)
 static const uint8_t HX8357D_regValues[] PROGMEM = {
   HX8357_SWRESET, 0,
   HX8357D_SETC, 3, 0xFF, 0x83, 0x57,
@@ -193,7 +216,9 @@ static const uint8_t HX8357D_regValues[] PROGMEM = {
   HX8357_DISPON, 0, 
   TFTLCD_DELAY, 50,
 };
+#endif
 
+#if DRIVER_BUILT(ID_932X)
 static const uint16_t ILI932x_regValues[] PROGMEM = {
   ILI932X_START_OSC        , 0x0001, // Start oscillator
   TFTLCD_DELAY             , 50,     // 50 millisecond delay
@@ -247,6 +272,7 @@ static const uint16_t ILI932x_regValues[] PROGMEM = {
   ILI932X_PANEL_IF_CTRL6   , 0X0000,
   ILI932X_DISP_CTRL1       , 0x0133, // Main screen turn on
 };
+#endif
 
 void Adafruit_TFTLCD::begin(uint16_t id) {
   uint8_t i = 0;
@@ -255,6 +281,7 @@ void Adafruit_TFTLCD::begin(uint16_t id) {
 
   delay(200);
 
+#if DRIVER_BUILT(ID_932X)
   if((id == 0x9325) || (id == 0x9328)) {
 
     uint16_t a, d;
@@ -268,8 +295,12 @@ void Adafruit_TFTLCD::begin(uint16_t id) {
     }
     setRotation(rotation);
     setAddrWindow(0, 0, TFTWIDTH-1, TFTHEIGHT-1);
+    return;
+  }
+#endif
 
-  } else if (id == 0x9341) {
+#if DRIVER_BUILT(ID_9341)
+  if (id == 0x9341) {
 
     uint16_t a, d;
     driver = ID_9341;
@@ -295,8 +326,11 @@ void Adafruit_TFTLCD::begin(uint16_t id) {
     delay(500);
     setAddrWindow(0, 0, TFTWIDTH-1, TFTHEIGHT-1);
     return;
+  }
+#endif
 
-  } else if (id == 0x8357) {
+#if DRIVER_BUILT(ID_HX8357D)
+  if (id == 0x8357) {
     // HX8357D
     driver = ID_HX8357D;
     CS_ACTIVE;
@@ -322,8 +356,11 @@ void Adafruit_TFTLCD::begin(uint16_t id) {
       }
     }
      return;
-     
-  } else if(id == 0x7575) {
+  }
+#endif
+
+#if DRIVER_BUILT(ID_7575)
+  if(id == 0x7575) {
 
     uint8_t a, d;
     driver = ID_7575;
@@ -336,15 +373,19 @@ void Adafruit_TFTLCD::begin(uint16_t id) {
     }
     setRotation(rotation);
     setLR(); // Lower-right corner of address window
-
-  } else {
-    driver = ID_UNKNOWN;
     return;
   }
+#endif
+
+  driver = ID_UNKNOWN;
 }
 
 void Adafruit_TFTLCD::reset(void) {
 
+  winX1 = winY1 = 0xFFFF; // Controller window unknown until set again
+  fullWindow = false;
+  sleepChanged = millis(); // A reset leaves the controller asleep
+  scrollLines = 0;
   CS_IDLE;
 //  CD_DATA;
   WR_IDLE;
@@ -370,12 +411,134 @@ void Adafruit_TFTLCD::reset(void) {
   CS_IDLE;
 }
 
+// Display off and into sleep (or back), keeping GRAM and every register,
+// so the picture returns as it was left.  The 9341/HX8357D ignore the
+// next command for 5 ms after SLPIN/SLPOUT and must not get the opposite
+// one within 120 ms, so that much of the wait is made up here if needed.
+void Adafruit_TFTLCD::enableSleep(boolean enable) {
+  if(DRIVER_IS(ID_932X)) {
+
+    // Init table values, with SLP set in power control 1 while asleep
+    uint16_t power = 0x1690, display = 0x0133;
+    CS_ACTIVE;
+    if(enable) {
+      writeRegister16(ILI932X_DISP_CTRL1, 0);              // Display off
+      writeRegister16(ILI932X_POW_CTRL1 , power | 0x0002); // SLP
+    } else {
+      writeRegister16(ILI932X_POW_CTRL1 , power);
+      CS_IDLE;
+      delay(10);
+      CS_ACTIVE;
+      writeRegister16(ILI932X_DISP_CTRL1, display);        // Display on
+    }
+    CS_IDLE;
+
+  } else if(DRIVER_IS(ID_7575)) {
+
+    // Same display control steps as the init table, with standby (STB)
+    // in power control 6
+    CS_ACTIVE;
+    if(enable) {
+      writeRegister8(0x28, 0x38);
+      CS_IDLE;
+      delay(40);
+      CS_ACTIVE;
+      writeRegister8(0x28, 0x04); // Display off
+      writeRegister8(0x1F, 0xD5); // STB
+    } else {
+      writeRegister8(0x1F, 0xD4);
+      CS_IDLE;
+      delay(5);
+      CS_ACTIVE;
+      writeRegister8(0x28, 0x38);
+      CS_IDLE;
+      delay(40);
+      CS_ACTIVE;
+      writeRegister8(0x28, 0x3C); // Display on
+    }
+    CS_IDLE;
+
+  } else if(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) {
+
+    uint32_t since = millis() - sleepChanged;
+    if(since < 120) delay(120 - since);
+    CS_ACTIVE;
+    CD_COMMAND;
+    if(enable) {
+      write8(ILI9341_DISPLAYOFF); // HX8357D uses same commands!
+      write8(ILI9341_SLEEPIN);
+    } else {
+      write8(ILI9341_SLEEPOUT);
+    }
+    CS_IDLE;
+    sleepChanged = millis();
+    delay(5);
+    if(!enable) {
+      CS_ACTIVE;
+      CD_COMMAND;
+      write8(ILI9341_DISPLAYON);
+      CS_IDLE;
+    }
+
+  }
+}
+
+// Both controllers scroll along their frame memory rows, which run along
+// y in rotations 0 and 2 and along x in 1 and 3; MY (set in rotations 0
+// and 1 for the 9341 and HX8357D alike) stores them in reverse order, so
+// the area and the offset are mirrored into memory rows here.
+boolean Adafruit_TFTLCD::setScrollArea(int16_t start, int16_t length) {
+  if(!(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D))) return false;
+
+  uint16_t top = (rotation < 2) ? TFTHEIGHT - start - length : start,
+           bottom = TFTHEIGHT - top - length;
+
+  CS_ACTIVE;
+  CD_COMMAND;
+  write8(ILI9341_VSCRDEF); // HX8357D uses same registers!
+  CD_DATA;
+  write8(top    >> 8); write8(top);
+  write8(length >> 8); write8(length);
+  write8(bottom >> 8); write8(bottom);
+  CS_IDLE;
+  scrollTop   = top;
+  scrollLines = length;
+  scrollTo(0);
+  return true;
+}
+
+void Adafruit_TFTLCD::scrollTo(int16_t offset) {
+  if(!(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) || !scrollLines) return;
+
+  offset %= (int16_t)scrollLines;
+  if(offset < 0) offset += scrollLines;
+  if((rotation < 2) && offset) offset = scrollLines - offset;
+  uint16_t line = scrollTop + offset;
+
+  CS_ACTIVE;
+  CD_COMMAND;
+  write8(ILI9341_VSCRSADD);
+  CD_DATA;
+  write8(line >> 8); write8(line);
+  CS_IDLE;
+}
+
+boolean Adafruit_TFTLCD::scrollsAlongX(void) {
+  return rotation & 1;
+}
+
 // Sets the LCD address window (and address counter, on 932X).
 // Relevant to rect/screen fills and H/V lines.  Input coordinates are
 // assumed pre-sorted (e.g. x2 >= x1).
 void Adafruit_TFTLCD::setAddrWindow(int x1, int y1, int x2, int y2) {
   CS_ACTIVE;
-  if(driver == ID_932X) {
+  if(DRIVER_IS(ID_932X)) {
+
+    // drawPixel() and readPixel() only set the address counter and rely
+    // on the window covering the whole screen; they restore it when this
+    // is false, so fills do not have to put it back every time.
+    fullWindow = (x1 == 0) && (y1 == 0) &&
+                 (x2 == _width - 1) && (y2 == _height - 1);
 
     // Values passed are in current (possibly rotated) coordinate
     // system.  932X requires hardware-native coords regardless of
@@ -426,31 +589,41 @@ void Adafruit_TFTLCD::setAddrWindow(int x1, int y1, int x2, int y2) {
     writeRegister16(0x0020, x ); // Set address counter to top left
     writeRegister16(0x0021, y );
 
-  } else if(driver == ID_7575) {
+  } else if(DRIVER_IS(ID_7575)) {
 
     writeRegisterPair(HX8347G_COLADDRSTART_HI, HX8347G_COLADDRSTART_LO, x1);
     writeRegisterPair(HX8347G_ROWADDRSTART_HI, HX8347G_ROWADDRSTART_LO, y1);
     writeRegisterPair(HX8347G_COLADDREND_HI  , HX8347G_COLADDREND_LO  , x2);
     writeRegisterPair(HX8347G_ROWADDREND_HI  , HX8347G_ROWADDREND_LO  , y2);
 
-  } else if ((driver == ID_9341) || (driver == ID_HX8357D)){
+  } else if (DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)){
     uint32_t t;
 
-    t = x1;
-    t <<= 16;
-    t |= x2;
-    writeRegister32(ILI9341_COLADDRSET, t);  // HX8357D uses same registers!
-    t = y1;
-    t <<= 16;
-    t |= y2;
-    writeRegister32(ILI9341_PAGEADDRSET, t); // HX8357D uses same registers!
+    // RAMWR restarts at the window's top left whatever the bounds, so
+    // only the ones that changed since the last call need sending.
+    if((x1 != winX1) || (x2 != winX2)) {
+      t = x1;
+      t <<= 16;
+      t |= x2;
+      writeRegister32(ILI9341_COLADDRSET, t);  // HX8357D uses same registers!
+      winX1 = x1;
+      winX2 = x2;
+    }
+    if((y1 != winY1) || (y2 != winY2)) {
+      t = y1;
+      t <<= 16;
+      t |= y2;
+      writeRegister32(ILI9341_PAGEADDRSET, t); // HX8357D uses same registers!
+      winY1 = y1;
+      winY2 = y2;
+    }
 
   }
   CS_IDLE;
 }
 
-// Unlike the 932X drivers that set the address window to the full screen
-// by default (using the address counter for drawPixel operations), the
+// Unlike the 932X drivers that use a full-screen address window (and the
+// address counter) for drawPixel operations, the
 // 7575 needs the address window set on all graphics operations.  In order
 // to save a few register writes on each pixel drawn, the lower-right
 // corner of the address window is reset after most fill operations, so
@@ -466,30 +639,36 @@ void Adafruit_TFTLCD::setLR(void) {
 // Requires setAddrWindow() has previously been called to set the fill
 // bounds.  'len' is inclusive, MUST be >= 1.
 void Adafruit_TFTLCD::flood(uint16_t color, uint32_t len) {
-  uint16_t blocks;
-  uint8_t  i, hi = color >> 8,
-              lo = color;
+  uint8_t hi = color >> 8, lo = color;
 
   CS_ACTIVE;
   CD_COMMAND;
-  if (driver == ID_9341) {
+  if (DRIVER_IS(ID_9341)) {
     write8(0x2C);
-  } else if (driver == ID_932X) {
+  } else if (DRIVER_IS(ID_932X)) {
     write8(0x00); // High byte of GRAM register...
     write8(0x22); // Write data to GRAM
-  } else if (driver == ID_HX8357D) {
+  } else if (DRIVER_IS(ID_HX8357D)) {
     write8(HX8357_RAMWR);
   } else {
     write8(0x22); // Write data to GRAM
   }
 
-  // Write first pixel normally, decrement counter by 1
   CD_DATA;
+#ifdef TFTLCD_BURST_KERNELS
+  while(len > 0xFFFF) {
+    writeRun(hi, lo, 0xFFFF);
+    len -= 0xFFFF;
+  }
+  writeRun(hi, lo, len);
+#else
+  // Write first pixel normally, decrement counter by 1
   write8(hi);
   write8(lo);
   len--;
 
-  blocks = (uint16_t)(len / 64); // 64 pixels/block
+  uint16_t blocks = (uint16_t)(len / 64); // 64 pixels/block
+  uint8_t  i;
   if(hi == lo) {
     // High and low bytes are identical.  Leave prior data
     // on the port(s) and just toggle the write strobe.
@@ -518,9 +697,121 @@ void Adafruit_TFTLCD::flood(uint16_t color, uint32_t len) {
       write8(lo);
     }
   }
+#endif
   CS_IDLE;
 }
 
+// Continues a GRAM write already in progress (CS active, CD high) with
+// 'len' pixels of one color, using the same strobe trick as flood() when
+// the high and low bytes match.  'len' MUST be >= 1.
+void Adafruit_TFTLCD::pushRun(uint16_t color, uint16_t len) {
+  uint8_t hi = color >> 8, lo = color;
+
+#ifdef TFTLCD_BURST_KERNELS
+  writeRun(hi, lo, len);
+#else
+  write8(hi);
+  write8(lo);
+  len--;
+  if(hi == lo) {
+    while(len >= 4) {
+      WR_STROBE; WR_STROBE; WR_STROBE; WR_STROBE;
+      WR_STROBE; WR_STROBE; WR_STROBE; WR_STROBE;
+      len -= 4;
+    }
+    while(len--) {
+      WR_STROBE;
+      WR_STROBE;
+    }
+  } else {
+    while(len--) {
+      write8(hi);
+      write8(lo);
+    }
+  }
+#endif
+}
+
+// Custom-font glyphs: the glyph is read once per (scaled) row as runs of
+// same-colored pixels (see GFXglyphRuns), whichever format the font uses.
+// Opaque glyphs that are entirely on screen are streamed through one
+// address window covering the glyph box; anything else is drawn as one
+// fillRect() per run, which also takes care of clipping.  The classic font
+// still goes through Adafruit_GFX.
+void Adafruit_TFTLCD::drawChar(int16_t x, int16_t y, unsigned char c,
+  uint16_t color, uint16_t bg, uint8_t size) {
+
+  if(!gfxFont) {
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size);
+    return;
+  }
+
+  c -= pgm_read_byte(&gfxFont->first);
+  GFXglyph *glyph  = &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
+
+  uint8_t  w  = pgm_read_byte(&glyph->width),
+           h  = pgm_read_byte(&glyph->height);
+  int8_t   xo = pgm_read_byte(&glyph->xOffset),
+           yo = pgm_read_byte(&glyph->yOffset);
+  if((w == 0) || (h == 0)) return;
+
+  boolean  opaque = (bg != color), on;
+  int16_t  x1 = x + xo * size, y1 = y + yo * size,
+           x2 = x1 + w * size - 1, y2 = y1 + h * size - 1;
+  uint8_t  xx, yy, s, n;
+  GFXglyphRuns runs;
+
+  runs.begin(gfxFont, glyph);
+
+  if(opaque && (x1 >= 0) && (y1 >= 0) && (x2 < _width) && (y2 < _height)) {
+
+    uint16_t run = 0, runColor = color;
+
+    setAddrWindow(x1, y1, x2, y2);
+    CS_ACTIVE;
+    CD_COMMAND;
+    if(DRIVER_IS(ID_932X)) write8(0x00);
+    if(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) {
+      write8(0x2C);
+    } else {
+      write8(0x22);
+    }
+    CD_DATA;
+    for(yy=0; yy<h; yy++) {
+      GFXglyphRuns row = runs;
+      for(s=0; s<size; s++) {
+        runs = row;
+        for(xx=0; xx<w; xx+=n) {
+          n = runs.next(&on);
+          uint16_t pixel = on ? color : bg, len = n * size;
+          if((pixel != runColor) || (run > 0xFFFF - len)) {
+            if(run) pushRun(runColor, run);
+            runColor = pixel;
+            run      = 0;
+          }
+          run += len;
+        }
+      }
+    }
+    if(run) pushRun(runColor, run);
+    CS_IDLE;
+    if(DRIVER_IS(ID_7575)) setLR();
+
+  } else {
+
+    for(yy=0; yy<h; yy++) {
+      for(xx=0; xx<w; xx+=n) {
+        n = runs.next(&on);
+        if(on || opaque) {
+          fillRect(x1 + xx * size, y1 + yy * size, n * size, size,
+            on ? color : bg);
+        }
+      }
+    }
+
+  }
+}
+
 void Adafruit_TFTLCD::drawFastHLine(int16_t x, int16_t y, int16_t length,
   uint16_t color)
 {
@@ -542,8 +833,7 @@ void Adafruit_TFTLCD::drawFastHLine(int16_t x, int16_t y, int16_t length,
 
   setAddrWindow(x, y, x2, y);
   flood(color, length);
-  if(driver == ID_932X) setAddrWindow(0, 0, _width - 1, _height - 1);
-  else                  setLR();
+  if(DRIVER_IS(ID_7575)) setLR();
 }
 
 void Adafruit_TFTLCD::drawFastVLine(int16_t x, int16_t y, int16_t length,
@@ -566,8 +856,7 @@ void Adafruit_TFTLCD::drawFastVLine(int16_t x, int16_t y, int16_t length,
 
   setAddrWindow(x, y, x, y2);
   flood(color, length);
-  if(driver == ID_932X) setAddrWindow(0, 0, _width - 1, _height - 1);
-  else                  setLR();
+  if(DRIVER_IS(ID_7575)) setLR();
 }
 
 void Adafruit_TFTLCD::fillRect(int16_t x1, int16_t y1, int16_t w, int16_t h, 
@@ -597,16 +886,152 @@ void Adafruit_TFTLCD::fillRect(int16_t x1, int16_t y1, int16_t w, int16_t h,
 
   setAddrWindow(x1, y1, x2, y2);
   flood(fillcolor, (uint32_t)w * (uint32_t)h);
-  if(driver == ID_932X) setAddrWindow(0, 0, _width - 1, _height - 1);
-  else                  setLR();
+  if(DRIVER_IS(ID_7575)) setLR();
+}
+
+// 4x4 Bayer matrix, thresholds 0-15
+static const uint8_t PROGMEM gradientDither[4][4] = {
+  {  0,  8,  2, 10 },
+  { 12,  4, 14,  6 },
+  {  3, 11,  1,  9 },
+  { 15,  7, 13,  5 }
+};
+
+// RGB565 channels, most to least significant
+static const uint8_t PROGMEM gradientShift[3] = { 11,   5,    0 },
+                             gradientMask[3]  = { 0x1F, 0x3F, 0x1F };
+
+// Each channel is tracked in 8.8 fixed point along the gradient with a
+// DDA (whole step q plus a remainder r/n carried in e), so a line costs a
+// few 16-bit adds instead of any multiply or divide.  Lines whose dither
+// pattern comes out as a single color are merged into runs as in
+// drawChar(); other lines stream their four-pixel pattern.
+void Adafruit_TFTLCD::fillGradientRect(int16_t x, int16_t y, int16_t w,
+  int16_t h, int16_t y0, uint16_t color0, int16_t y1, uint16_t color1,
+  boolean dither) {
+
+  int16_t  x2, y2;
+
+  // Initial off-screen clipping, as in fillRect()
+  if( (w           <= 0     ) ||  (h            <= 0      ) ||
+      (x           >= _width) ||  (y            >= _height) ||
+     ((x2 = x+w-1) <  0     ) || ((y2  = y+h-1) <  0      )) return;
+  if(x < 0) x = 0;
+  if(y < 0) y = 0;
+  if(x2 >= _width ) x2 = _width  - 1;
+  if(y2 >= _height) y2 = _height - 1;
+  w = x2 - x + 1;
+
+  int16_t  n = y1 - y0, dir = 1;
+  if(n < 0) {
+    n   = -n;
+    dir = -1;
+  }
+  if(!n) n = 1;
+
+  // Position of the first line along the gradient, held to [0, n]
+  int16_t  t  = (y - y0) * dir,
+           tc = (t < 0) ? 0 : (t > n) ? n : t;
+  int16_t  v[3], q[3], r[3], e[3];
+  uint8_t  ch, p;
+
+  for(ch=0; ch<3; ch++) {
+    uint8_t shift = pgm_read_byte(&gradientShift[ch]),
+            mask  = pgm_read_byte(&gradientMask[ch]);
+    int16_t c0    = (color0 >> shift) & mask,
+            d     = (int16_t)(((color1 >> shift) & mask) - c0) * 256;
+    q[ch] = d / n;
+    r[ch] = d % n;
+    if(r[ch] < 0) { // Floor division, so the remainder is never negative
+      r[ch] += n;
+      q[ch]--;
+    }
+    int32_t rt = (int32_t)r[ch] * tc;
+    v[ch] = (c0 << 8) + q[ch] * tc + (int16_t)(rt / n);
+    e[ch] = rt % n;
+  }
+
+  uint16_t run = 0, runColor = 0, color[4];
+
+  setAddrWindow(x, y, x2, y2);
+  CS_ACTIVE;
+  CD_COMMAND;
+  if(DRIVER_IS(ID_932X)) write8(0x00);
+  if(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) {
+    write8(0x2C);
+  } else {
+    write8(0x22);
+  }
+  CD_DATA;
+  WR_BURST_BEGIN
+
+  for(; y<=y2; y++) {
+    for(p=0; p<4; p++) {
+      uint8_t threshold = dither ?
+        (pgm_read_byte(&gradientDither[y & 3][(x + p) & 3]) << 4) + 8 : 128;
+      color[p] = (((v[0] + threshold) >> 8) << 11) |
+                 (((v[1] + threshold) >> 8) <<  5) |
+                  ((v[2] + threshold) >> 8);
+    }
+
+    if((color[0] == color[1]) && (color[0] == color[2]) &&
+       (color[0] == color[3])) {
+      if((color[0] != runColor) || (run > 0xFFFF - w)) {
+        if(run) pushRun(runColor, run);
+        runColor = color[0];
+        run      = 0;
+      }
+      run += w;
+    } else {
+      if(run) pushRun(runColor, run);
+      run = 0;
+      // Dithered line: the four colors repeat along it, each byte sent
+      // with the port values cached by WR_BURST_BEGIN
+      uint8_t hi[4], lo[4];
+      for(p=0; p<4; p++) {
+        hi[p] = color[p] >> 8;
+        lo[p] = color[p];
+      }
+      for(x2=0, p=0; x2<w; x2++, p=(p+1)&3) {
+        write8burst(hi[p]);
+        write8burst(lo[p]);
+      }
+    }
+
+    // Step to the next line's position, if it moves within [0, n]
+    t += dir;
+    if((t > tc) && (tc < n)) {
+      tc++;
+      for(ch=0; ch<3; ch++) {
+        v[ch] += q[ch];
+        if((e[ch] += r[ch]) >= n) {
+          e[ch] -= n;
+          v[ch]++;
+        }
+      }
+    } else if((t < tc) && (tc > 0)) {
+      tc--;
+      for(ch=0; ch<3; ch++) {
+        v[ch] -= q[ch];
+        if((e[ch] -= r[ch]) < 0) {
+          e[ch] += n;
+          v[ch]--;
+        }
+      }
+    }
+  }
+  if(run) pushRun(runColor, run);
+  CS_IDLE;
+  if(DRIVER_IS(ID_7575)) setLR();
 }
 
 void Adafruit_TFTLCD::fillScreen(uint16_t color) {
   
-  if(driver == ID_932X) {
+  if(DRIVER_IS(ID_932X)) {
 
-    // For the 932X, a full-screen address window is already the default
-    // state, just need to set the address pointer to the top-left corner.
+    // For the 932X, a full-screen address window is the default state
+    // (put back here if a fill left a smaller one), just need to set the
+    // address pointer to the top-left corner.
     // Although we could fill in any direction, the code uses the current
     // screen rotation because some users find it disconcerting when a
     // fill does not occur top-to-bottom.
@@ -617,11 +1042,12 @@ void Adafruit_TFTLCD::fillScreen(uint16_t color) {
       case 2 : x = TFTWIDTH  - 1; y = TFTHEIGHT - 1; break;
       case 3 : x = 0            ; y = TFTHEIGHT - 1; break;
     }
+    if(!fullWindow) setAddrWindow(0, 0, _width - 1, _height - 1);
     CS_ACTIVE;
     writeRegister16(0x0020, x);
     writeRegister16(0x0021, y);
 
-  } else if ((driver == ID_9341) || (driver == ID_7575) || (driver == ID_HX8357D)) {
+  } else if (DRIVER_IS(ID_9341) || DRIVER_IS(ID_7575) || DRIVER_IS(ID_HX8357D)) {
     // For these, there is no settable address pointer, instead the
     // address window must be set for each drawing operation.  However,
     // this display takes rotation into account for the parameters, no
@@ -637,8 +1063,10 @@ void Adafruit_TFTLCD::drawPixel(int16_t x, int16_t y, uint16_t color) {
   // Clip
   if((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) return;
 
+  if(DRIVER_IS(ID_932X) && !fullWindow)
+    setAddrWindow(0, 0, _width - 1, _height - 1);
   CS_ACTIVE;
-  if(driver == ID_932X) {
+  if(DRIVER_IS(ID_932X)) {
     int16_t t;
     switch(rotation) {
      case 1:
@@ -660,7 +1088,7 @@ void Adafruit_TFTLCD::drawPixel(int16_t x, int16_t y, uint16_t color) {
     writeRegister16(0x0021, y);
     writeRegister16(0x0022, color);
 
-  } else if(driver == ID_7575) {
+  } else if(DRIVER_IS(ID_7575)) {
 
     uint8_t hi, lo;
     switch(rotation) {
@@ -676,7 +1104,7 @@ void Adafruit_TFTLCD::drawPixel(int16_t x, int16_t y, uint16_t color) {
     hi = color >> 8; lo = color;
     CD_COMMAND; write8(0x22); CD_DATA; write8(hi); write8(lo);
 
-  } else if ((driver == ID_9341) || (driver == ID_HX8357D)) {
+  } else if (DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) {
     setAddrWindow(x, y, _width-1, _height-1);
     CS_ACTIVE;
     CD_COMMAND; 
@@ -692,20 +1120,29 @@ void Adafruit_TFTLCD::drawPixel(int16_t x, int16_t y, uint16_t color) {
 // externally by BMP examples.  Assumes that setWindowAddr() has
 // previously been set to define the bounds.  Max 255 pixels at
 // a time (BMP examples read in small chunks due to limited RAM).
-void Adafruit_TFTLCD::pushColors(uint16_t *data, uint8_t len, boolean first) {
-  uint16_t color;
-  uint8_t  hi, lo;
+// Selects the controller and readies it for pixel data, issuing the
+// GRAM write command only on the first call of a sequence
+void Adafruit_TFTLCD::beginPixels(boolean first) {
   CS_ACTIVE;
-  if(first == true) { // Issue GRAM write command only on first call
+  if(first == true) {
     CD_COMMAND;
-    if(driver == ID_932X) write8(0x00);
-    if ((driver == ID_9341) || (driver == ID_HX8357D)){
+    if(DRIVER_IS(ID_932X)) write8(0x00);
+    if (DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)){
        write8(0x2C);
      }  else {
        write8(0x22);
      }
   }
   CD_DATA;
+}
+
+void Adafruit_TFTLCD::pushColors(uint16_t *data, uint8_t len, boolean first) {
+  beginPixels(first);
+#ifdef TFTLCD_BURST_KERNELS
+  writeColors(data, len);
+#else
+  uint16_t color;
+  uint8_t  hi, lo;
   while(len--) {
     color = *data++;
     hi    = color >> 8; // Don't simplify or merge these
@@ -713,9 +1150,232 @@ void Adafruit_TFTLCD::pushColors(uint16_t *data, uint8_t len, boolean first) {
     write8(hi);         // going on.
     write8(lo);
   }
+#endif
+  CS_IDLE;
+}
+
+// Same as pushColors(), for 'len' pixels of one color
+void Adafruit_TFTLCD::pushColor(uint16_t color, uint16_t len, boolean first) {
+  if(!len) return;
+  beginPixels(first);
+  pushRun(color, len);
+  CS_IDLE;
+}
+
+// Same again for any number of pixels, from RAM or flash, in either byte
+// order.  The native-order RAM case goes through the pushColors() loop;
+// the rest fetch each byte as they write it.
+void Adafruit_TFTLCD::writePixels(const uint16_t *data, uint32_t len,
+  uint8_t source, boolean first) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint8_t        hi, lo;
+
+  beginPixels(first);
+  WR_BURST_BEGIN
+  if(source & TFTLCD_PIXELS_PROGMEM) {
+    if(source & TFTLCD_PIXELS_SWAPPED) {
+      while(len--) {
+        hi = pgm_read_byte(p++);
+        lo = pgm_read_byte(p++);
+        write8burst(hi);
+        write8burst(lo);
+      }
+    } else {
+      while(len--) {
+        uint16_t color = pgm_read_word(p);
+        p  += 2;
+        hi  = color >> 8;
+        lo  = color;
+        write8burst(hi);
+        write8burst(lo);
+      }
+    }
+  } else if(source & TFTLCD_PIXELS_SWAPPED) {
+    while(len--) {
+      hi = *p++;
+      lo = *p++;
+      write8burst(hi);
+      write8burst(lo);
+    }
+  } else {
+    while(len) {
+      uint8_t n = (len > 255) ? 255 : len;
+#ifdef TFTLCD_BURST_KERNELS
+      writeColors((uint16_t *)data, n);
+      data += n;
+#else
+      for(uint8_t i=0; i<n; i++) {
+        uint16_t color = *data++;
+        hi = color >> 8;
+        lo = color;
+        write8(hi);
+        write8(lo);
+      }
+#endif
+      len -= n;
+    }
+  }
   CS_IDLE;
 }
 
+// Clips a canvas of cw x ch pixels drawn at (*x, *y) to the screen:
+// (*x, *y, *w, *h) become the part that shows and (*sx, *sy) where that
+// part starts in the canvas.  False if none of it shows.
+static boolean clipCanvas(int16_t cw, int16_t ch, int16_t width,
+  int16_t height, int16_t *x, int16_t *y, int16_t *w, int16_t *h,
+  int16_t *sx, int16_t *sy) {
+  *w  = cw;
+  *h  = ch;
+  *sx = *sy = 0;
+  if(*x < 0) { *sx = -*x; *w += *x; *x = 0; }
+  if(*y < 0) { *sy = -*y; *h += *y; *y = 0; }
+  if(*x + *w > width ) *w = width  - *x;
+  if(*y + *h > height) *h = height - *y;
+  return (*w > 0) && (*h > 0);
+}
+
+void Adafruit_TFTLCD::drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas) {
+  uint16_t *buffer = canvas->getBuffer();
+  int16_t   stride = canvas->width(), w, h, sx, sy;
+
+  if(!buffer || !clipCanvas(stride, canvas->height(), _width, _height,
+    &x, &y, &w, &h, &sx, &sy)) return;
+  setAddrWindow(x, y, x + w - 1, y + h - 1);
+  buffer += (int32_t)sy * stride + sx;
+  if(w == stride) {
+    writePixels(buffer, (uint32_t)w * h);
+  } else {
+    for(int16_t row=0; row<h; row++, buffer+=stride) {
+      writePixels(buffer, w, 0, row == 0);
+    }
+  }
+}
+
+// Each bit is expanded to one of the two colors as it is written out
+void Adafruit_TFTLCD::drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas,
+  uint16_t color, uint16_t bg) {
+  uint8_t *buffer = canvas->getBuffer();
+  int16_t  stride = (canvas->width() + 7) / 8, w, h, sx, sy;
+  uint8_t  fgHi = color >> 8, fgLo = color, bgHi = bg >> 8, bgLo = bg;
+
+  if(!buffer || !clipCanvas(canvas->width(), canvas->height(), _width,
+    _height, &x, &y, &w, &h, &sx, &sy)) return;
+  setAddrWindow(x, y, x + w - 1, y + h - 1);
+  beginPixels(true);
+  WR_BURST_BEGIN
+  buffer += (int32_t)sy * stride + sx / 8;
+  for(int16_t row=0; row<h; row++, buffer+=stride) {
+    uint8_t *p    = buffer,
+             bits = *p++,
+             mask = 0x80 >> (sx & 7);
+    for(int16_t i=0; i<w; i++) {
+      if(!mask) {
+        bits = *p++;
+        mask = 0x80;
+      }
+      if(bits & mask) {
+        write8burst(fgHi);
+        write8burst(fgLo);
+      } else {
+        write8burst(bgHi);
+        write8burst(bgLo);
+      }
+      mask >>= 1;
+    }
+  }
+  CS_IDLE;
+}
+
+#ifdef pgm_read_word_far
+void Adafruit_TFTLCD::writePixelsFar(uint_farptr_t address, uint32_t len,
+  uint8_t source, boolean first) {
+  uint8_t hi, lo;
+
+  beginPixels(first);
+  WR_BURST_BEGIN
+  if(source & TFTLCD_PIXELS_SWAPPED) {
+    while(len--) {
+      hi = pgm_read_byte_far(address);
+      lo = pgm_read_byte_far(address + 1);
+      address += 2;
+      write8burst(hi);
+      write8burst(lo);
+    }
+  } else {
+    while(len--) {
+      uint16_t color = pgm_read_word_far(address);
+      address += 2;
+      hi = color >> 8;
+      lo = color;
+      write8burst(hi);
+      write8burst(lo);
+    }
+  }
+  CS_IDLE;
+}
+#endif
+
+// Reads back a rectangle of GRAM through one address window, left to
+// right and top to bottom.  The bus is held (CS active, port in read
+// mode) from startReadRect() to endReadRect(), so nothing else may be
+// drawn in between; readPixels() can be called as often as needed to
+// take the pixels in chunks.
+void Adafruit_TFTLCD::startReadRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint8_t dummy;
+
+  setAddrWindow(x, y, x + w - 1, y + h - 1);
+  CS_ACTIVE;
+  CD_COMMAND;
+  if(DRIVER_IS(ID_932X)) {
+    write8(0x00); write8(0x22); // Read data from GRAM
+  } else if(DRIVER_IS(ID_7575)) {
+    write8(0x22);
+  } else {
+    write8(ILI9341_MEMORYREAD); // HX8357D uses same registers!
+  }
+  CD_DATA;
+  setReadDir();  // Set up LCD data port(s) for READ operations
+  read8(dummy);  // First byte back is a dummy read (two on the 932X)
+  if(DRIVER_IS(ID_932X)) read8(dummy);
+  (void)dummy;
+}
+
+void Adafruit_TFTLCD::readPixels(uint16_t *data, uint32_t n) {
+  uint8_t r, g, b;
+
+  if(DRIVER_IS(ID_932X)) {
+    // 16 bits per pixel, as written
+    while(n--) {
+      read8(r);
+      read8(b);
+      *data++ = ((uint16_t)r << 8) | b;
+    }
+  } else {
+    // 7575/9341/HX8357D send 6 bits per component, 3 bytes per pixel
+    while(n--) {
+      read8(r);
+      read8(g);
+      read8(b);
+      *data++ = (((uint16_t)r & B11111000) << 8) |
+                (((uint16_t)g & B11111100) << 3) |
+                (           b              >> 3);
+    }
+  }
+}
+
+void Adafruit_TFTLCD::endReadRect(void) {
+  setWriteDir(); // Restore LCD data port(s) to WRITE configuration
+  CS_IDLE;
+  if(DRIVER_IS(ID_7575)) setLR();
+}
+
+void Adafruit_TFTLCD::readRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  uint16_t *data) {
+  startReadRect(x, y, w, h);
+  readPixels(data, (uint32_t)w * h);
+  endReadRect();
+}
+
 void Adafruit_TFTLCD::setRotation(uint8_t x) {
 
   // Call parent rotation func first -- sets up rotation flags, etc.
@@ -723,7 +1383,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
   // Then perform hardware-specific rotation operations...
 
   CS_ACTIVE;
-  if(driver == ID_932X) {
+  if(DRIVER_IS(ID_932X)) {
 
     uint16_t t;
     switch(rotation) {
@@ -737,7 +1397,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
     setAddrWindow(0, 0, _width - 1, _height - 1); // CS_IDLE happens here
 
   }
- if(driver == ID_7575) {
+ if(DRIVER_IS(ID_7575)) {
 
     uint8_t t;
     switch(rotation) {
@@ -753,7 +1413,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
     setLR(); // CS_IDLE happens here
   }
 
- if (driver == ID_9341) { 
+ if (DRIVER_IS(ID_9341)) { 
    // MEME, HX8357D uses same registers as 9341 but different values
    uint16_t t;
 
@@ -767,7 +1427,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
   case 0:
     t = ILI9341_MADCTL_MY | ILI9341_MADCTL_BGR;
     break;
-   case 1:
+   default: // 1; rotation is 0-3
      t = ILI9341_MADCTL_MX | ILI9341_MADCTL_MY | ILI9341_MADCTL_MV | ILI9341_MADCTL_BGR;
      break;
   }
@@ -776,7 +1436,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
    setAddrWindow(0, 0, _width - 1, _height - 1); // CS_IDLE happens here
   }
   
-  if (driver == ID_HX8357D) { 
+  if (DRIVER_IS(ID_HX8357D)) { 
     // MEME, HX8357D uses same registers as 9341 but different values
     uint16_t t;
     
@@ -790,7 +1450,7 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
       case 0:
         t = HX8357B_MADCTL_MX | HX8357B_MADCTL_MY | HX8357B_MADCTL_RGB;
         break;
-      case 1:
+      default: // 1; rotation is 0-3
         t = HX8357B_MADCTL_MY | HX8357B_MADCTL_MV | HX8357B_MADCTL_RGB;
         break;
     }
@@ -799,10 +1459,6 @@ void Adafruit_TFTLCD::setRotation(uint8_t x) {
     setAddrWindow(0, 0, _width - 1, _height - 1); // CS_IDLE happens here
   }}
 
-#ifdef read8isFunctionalized
-  #define read8(x) x=read8fn()
-#endif
-
 // Because this function is used infrequently, it configures the ports for
 // the read operation, reads the data, then restores the ports to the write
 // configuration.  Write operations happen a LOT, so it's advantageous to
@@ -811,8 +1467,16 @@ uint16_t Adafruit_TFTLCD::readPixel(int16_t x, int16_t y) {
 
   if((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) return 0;
 
+  if(DRIVER_IS(ID_9341) || DRIVER_IS(ID_HX8357D)) {
+    uint16_t color;
+    readRect(x, y, 1, 1, &color);
+    return color;
+  }
+
+  if(DRIVER_IS(ID_932X) && !fullWindow)
+    setAddrWindow(0, 0, _width - 1, _height - 1);
   CS_ACTIVE;
-  if(driver == ID_932X) {
+  if(DRIVER_IS(ID_932X)) {
 
     uint8_t hi, lo;
     int16_t t;
@@ -850,7 +1514,7 @@ uint16_t Adafruit_TFTLCD::readPixel(int16_t x, int16_t y) {
     CS_IDLE;
     return ((uint16_t)hi << 8) | lo;
 
-  } else if(driver == ID_7575) {
+  } else if(DRIVER_IS(ID_7575)) {
 
     uint8_t r, g, b;
     writeRegisterPair(HX8347G_COLADDRSTART_HI, HX8347G_COLADDRSTART_LO, x);
@@ -1001,17 +1665,17 @@ void Adafruit_TFTLCD::writeRegisterPair(uint8_t aH, uint8_t aL, uint16_t d) {
 }
 #endif
 
-
+// No delays between the bytes: the ILI9341 and HX8357D take a write
+// cycle every 66 ns (WR low and high 15 ns each at least), and every WR
+// edge is at least two cycles (125 ns) at 16 MHz.  Pixel data has always
+// gone out through the same write8() back to back.
 void Adafruit_TFTLCD::writeRegister24(uint8_t r, uint32_t d) {
   CS_ACTIVE;
   CD_COMMAND;
   write8(r);
   CD_DATA;
-  delayMicroseconds(10);
   write8(d >> 16);
-  delayMicroseconds(10);
   write8(d >> 8);
-  delayMicroseconds(10);
   write8(d);
   CS_IDLE;
 
@@ -1023,13 +1687,9 @@ void Adafruit_TFTLCD::writeRegister32(uint8_t r, uint32_t d) {
   CD_COMMAND;
   write8(r);
   CD_DATA;
-  delayMicroseconds(10);
   write8(d >> 24);
-  delayMicroseconds(10);
   write8(d >> 16);
-  delayMicroseconds(10);
   write8(d >> 8);
-  delayMicroseconds(10);
   write8(d);
   CS_IDLE;
 
@@ -19,6 +19,23 @@
 
 //#define USE_ADAFRUIT_SHIELD_PINOUT 1
 
+// LCD controller chip identifiers
+#define ID_932X    0
+#define ID_7575    1
+#define ID_9341    2
+#define ID_HX8357D    3
+#define ID_UNKNOWN 0xFF
+
+// **** A BUILD FOR ONE PANEL CAN NAME ITS CONTROLLER, HERE OR IN THE  ****
+// **** BUILD FLAGS (-DTFTLCD_DRIVER=ID_HX8357D).  ONLY THAT DRIVER IS ****
+// **** THEN COMPILED IN; LEAVE IT UNDEFINED TO DETECT IT AT RUN TIME: ****
+
+//#define TFTLCD_DRIVER ID_HX8357D
+
+// Pixel sources for writePixels()
+#define TFTLCD_PIXELS_PROGMEM 0x01 // In flash rather than RAM
+#define TFTLCD_PIXELS_SWAPPED 0x02 // Each pixel's high byte stored first
+
 class Adafruit_TFTLCD : public Adafruit_GFX {
 
  public:
@@ -32,13 +49,66 @@ class Adafruit_TFTLCD : public Adafruit_GFX {
   void     drawFastVLine(int16_t x0, int16_t y0, int16_t h, uint16_t color);
   void     fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c);
   void     fillScreen(uint16_t color);
+  // Vertical gradient from color0 on line y0 to color1 on line y1 (y1 may
+  // be above or below y0), held at the end colors beyond them, painted
+  // inside the given rectangle through a single address window.  With
+  // dither, a 4x4 ordered dither tied to screen coordinates hides the
+  // steps between colors; repainting part of the gradient later gives
+  // exactly the same pixels.
+  void     fillGradientRect(int16_t x, int16_t y, int16_t w, int16_t h,
+             int16_t y0, uint16_t color0, int16_t y1, uint16_t color1,
+             boolean dither = false);
+  // Custom-font glyphs are drawn as runs rather than pixel by pixel.  If
+  // the text background differs from the foreground (setTextColor(c, bg))
+  // the glyph's bounding box is painted opaquely in a single window.
+  void     drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+             uint16_t bg, uint8_t size);
   void     reset(void);
+  // Turns the display off and puts the controller to sleep, or wakes it
+  // and turns the display back on.  GRAM is kept, so nothing needs to be
+  // repainted; on the 9341/HX8357D drawing while asleep still reaches it.
+  void     enableSleep(boolean enable);
   void     setRegisters8(uint8_t *ptr, uint8_t n);
   void     setRegisters16(uint16_t *ptr, uint8_t n);
   void     setRotation(uint8_t x);
+  // Hardware scrolling (9341/HX8357D only; false elsewhere).  Lines start
+  // to start+length-1 along the panel's long axis -- y in rotations 0 and
+  // 2, x in rotations 1 and 3 -- become a ring: after scrollTo(offset) line
+  // start+k shows what was drawn on start+(k+offset)%length, and the rest
+  // of the screen stays put.  scrollTo(0) shows the area as drawn.  Set
+  // the area again after setRotation().
+  boolean  setScrollArea(int16_t start, int16_t length);
+  void     scrollTo(int16_t offset);
+  boolean  scrollsAlongX(void);
        // These methods are public in order for BMP examples to work:
   void     setAddrWindow(int x1, int y1, int x2, int y2);
   void     pushColors(uint16_t *data, uint8_t len, boolean first);
+  void     pushColor(uint16_t color, uint16_t len, boolean first);
+  // Off-screen canvas (at its own rotation 0) to the screen through one
+  // address window, clipped at the screen edges; a GFXcanvas1 is drawn
+  // opaquely, set bits in 'color' and clear ones in 'bg'
+  void     drawCanvas(int16_t x, int16_t y, GFXcanvas16 *canvas),
+           drawCanvas(int16_t x, int16_t y, GFXcanvas1 *canvas,
+             uint16_t color, uint16_t bg);
+  // Streams 'len' pixels into the address window under one GRAM write
+  // (continuing the last one if !first).  'source' is 0 for uint16_t
+  // colors in RAM, or any of TFTLCD_PIXELS_PROGMEM and _SWAPPED.
+  void     writePixels(const uint16_t *data, uint32_t len,
+             uint8_t source = 0, boolean first = true);
+#ifdef pgm_read_word_far
+  // Same from anywhere in flash, beyond 64 KB included, at the address
+  // pgm_get_far_address() gives; only TFTLCD_PIXELS_SWAPPED applies
+  void     writePixelsFar(uint_farptr_t address, uint32_t len,
+             uint8_t source = 0, boolean first = true);
+#endif
+  // Streaming read-back of a rectangle (see Adafruit_TFTLCD.cpp); nothing
+  // else may be drawn between startReadRect() and endReadRect().  The
+  // rectangle must be on screen.
+  void     startReadRect(int16_t x, int16_t y, int16_t w, int16_t h),
+           readPixels(uint16_t *data, uint32_t n),
+           endReadRect(void),
+           readRect(int16_t x, int16_t y, int16_t w, int16_t h,
+             uint16_t *data);
 
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b),
            readPixel(int16_t x, int16_t y),
@@ -48,6 +118,7 @@ class Adafruit_TFTLCD : public Adafruit_GFX {
  private:
 
   void     init(),
+           beginPixels(boolean first),
            // These items may have previously been defined as macros
            // in pin_magic.h.  If not, function versions are declared:
 #ifndef write8
@@ -71,17 +142,29 @@ class Adafruit_TFTLCD : public Adafruit_GFX {
            writeRegisterPair(uint8_t aH, uint8_t aL, uint16_t d),
 #endif
            setLR(void),
-           flood(uint16_t color, uint32_t len);
+           flood(uint16_t color, uint32_t len),
+           pushRun(uint16_t color, uint16_t len);
   uint8_t  driver;
-
-#ifndef read8
+  // Column/page window last sent to a 9341/HX8357D (0xFFFF: unknown),
+  // so setAddrWindow() only sends the bounds that change
+  uint16_t winX1, winX2, winY1, winY2;
+  // 932X only: address window is the whole screen, as drawPixel() and
+  // readPixel() need; fills leave it at their own bounds
+  boolean  fullWindow;
+  // millis() at the last SLPIN/SLPOUT or reset (9341/HX8357D timing)
+  uint32_t sleepChanged;
+  // Scroll area in frame memory rows (scrollLines 0: none defined)
+  uint16_t scrollTop, scrollLines;
+
+// The simulator build defines read8 in pin_magic.h, included after this
+#if !defined(read8) && !defined(TFTLCD_HOST_SIM)
   uint8_t  read8fn(void);
   #define  read8isFunctionalized
 #endif
 
 #ifndef USE_ADAFRUIT_SHIELD_PINOUT
 
-  #ifdef __AVR__
+  #if defined(__AVR__) || defined(TFTLCD_HOST_SIM)
     volatile uint8_t *csPort    , *cdPort    , *wrPort    , *rdPort;
 	uint8_t           csPinSet  ,  cdPinSet  ,  wrPinSet  ,  rdPinSet  ,
 					  csPinUnset,  cdPinUnset,  wrPinUnset,  rdPinUnset,
@@ -171,6 +171,92 @@
   #define setWriteDirInline() DDRA  = 0xff
   #define setReadDirInline()  DDRA  = 0
 
+  #ifndef TFTLCD_NO_BURST_KERNELS
+
+  // Burst kernels for flood(), pushRun() and pushColors().  WR_STROBE
+  // reads, masks and writes WR's port through a pointer on every edge
+  // (5 cycles); here the port address and the port's value with WR low
+  // and with WR high are worked out once per burst and kept in registers,
+  // so an edge is one 2-cycle store and a byte 5 cycles: WR low 125 ns,
+  // high 125 ns or more, data set 125 ns before the rising edge and held
+  // 62.5 ns after it, all well inside the 9341 write timing (66 ns cycle,
+  // 15 ns low and high, 10 ns setup and hold).
+  // As those values are written whole, nothing else may change the pins
+  // of WR's port while a burst runs -- with DomoHedgie's wiring that is
+  // PORTC, which only carries LCD control lines.
+  #define TFTLCD_BURST_KERNELS
+
+  // 'n' pixels of one color
+  static inline void writeRunKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint8_t hi, uint8_t lo, uint16_t n) {
+    if(hi == lo) {
+      // Leave the byte on the port and just strobe, 4 pixels a pass
+      PORTA = hi;
+      for(uint8_t i = n & 3; i--; ) {
+        *wr = active; *wr = idle; *wr = active; *wr = idle;
+      }
+      if(n >>= 2) asm volatile(
+        "1:"            "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "st   Z, %[a]"  "\n\t" "st   Z, %[i]"  "\n\t"
+        "sbiw %[n], 1"  "\n\t"
+        "brne 1b"       "\n"
+        : [n] "+w" (n)
+        : "z" (wr), [a] "r" (active), [i] "r" (idle)
+        : "memory");
+    } else {
+      // 2 pixels a pass
+      if(n & 1) {
+        PORTA = hi; *wr = active; *wr = idle;
+        PORTA = lo; *wr = active; *wr = idle;
+      }
+      if(n >>= 1) asm volatile(
+        "1:"                 "\n\t"
+        "out  %[port], %[h]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+        "out  %[port], %[l]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+        "out  %[port], %[h]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+        "out  %[port], %[l]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+        "sbiw %[n], 1"       "\n\t"
+        "brne 1b"            "\n"
+        : [n] "+w" (n)
+        : [port] "I" (_SFR_IO_ADDR(PORTA)), "z" (wr),
+          [a] "r" (active), [i] "r" (idle), [h] "r" (hi), [l] "r" (lo)
+        : "memory");
+    }
+  }
+
+  // One byte, for loops that fetch their data as they go
+  static inline void write8BurstKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint8_t d) {
+    PORTA = d; *wr = active; *wr = idle;
+  }
+
+  // 'n' pixels from 'data'
+  static inline void writeColorsKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint16_t *data, uint8_t n) {
+    uint8_t hi, lo;
+    if(n) asm volatile(
+      "1:"                 "\n\t"
+      "ld   %[l], X+"      "\n\t"
+      "ld   %[h], X+"      "\n\t"
+      "out  %[port], %[h]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+      "out  %[port], %[l]" "\n\t" "st   Z, %[a]" "\n\t" "st   Z, %[i]" "\n\t"
+      "dec  %[n]"          "\n\t"
+      "brne 1b"            "\n"
+      : [n] "+r" (n), "+x" (data), [h] "=&r" (hi), [l] "=&r" (lo)
+      : [port] "I" (_SFR_IO_ADDR(PORTA)), "z" (wr),
+        [a] "r" (active), [i] "r" (idle)
+      : "memory");
+  }
+
+  #endif
+
  #endif
 
   // All of the functions are inlined on the Arduino Mega.  When using the
@@ -279,7 +365,7 @@
    PIO_Clear(PIOB, (((~d) & 0x20)<<(27-5))); \
    WR_STROBE; }
 
-  #define read8inline(result) { \    
+  #define read8inline(result) { \
    RD_ACTIVE;   \
    delayMicroseconds(1);      \
    result = (((PIOC->PIO_PDSR & (1<<23)) >> (23-7)) | ((PIOC->PIO_PDSR & (1<<24)) >> (24-6)) | \
@@ -345,13 +431,81 @@
  #endif
 
 
+#elif defined(TFTLCD_HOST_SIM)
+
+ // Host-side simulator build (DomoHedgie/sim): every bus operation calls
+ // into the cycle-accounting model of the Mega breakout wiring, which
+ // decodes the command/data stream into a framebuffer.
+
+ #include "TFTLCD_sim.h"
+
+  #define write8inline(d)     { tftsim_dataWrite(d); WR_STROBE; }
+  #define read8inline(result) { result = tftsim_dataRead(); }
+  #define setWriteDirInline() tftsim_setWriteDir()
+  #define setReadDirInline()  tftsim_setReadDir()
+
+  #define write8            write8inline
+  #define read8             read8inline
+  #define setWriteDir       setWriteDirInline
+  #define setReadDir        setReadDirInline
+  #define writeRegister8    writeRegister8inline
+  #define writeRegister16   writeRegister16inline
+  #define writeRegisterPair writeRegisterPairInline
+
+  #define RD_ACTIVE  tftsim_rdActive()
+  #define RD_IDLE    tftsim_rdIdle()
+  #define WR_ACTIVE  tftsim_wrActive()
+  #define WR_IDLE    tftsim_wrIdle()
+  #define CD_COMMAND tftsim_cdCommand()
+  #define CD_DATA    tftsim_cdData()
+  #define CS_ACTIVE  tftsim_csActive()
+  #define CS_IDLE    tftsim_csIdle()
+
+ #ifndef TFTLCD_NO_BURST_KERNELS
+
+  // The Mega breakout burst kernels, with each port write and store
+  // charged as the AVR version issues it
+  #define TFTLCD_BURST_KERNELS
+
+  static inline void writeRunKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint8_t hi, uint8_t lo, uint16_t n) {
+    if(hi == lo) {
+      tftsim_dataWrite(hi);
+      while(n--) {
+        tftsim_wrStore(true); tftsim_wrStore(false);
+        tftsim_wrStore(true); tftsim_wrStore(false);
+      }
+    } else {
+      while(n--) {
+        tftsim_dataWrite(hi); tftsim_wrStore(true); tftsim_wrStore(false);
+        tftsim_dataWrite(lo); tftsim_wrStore(true); tftsim_wrStore(false);
+      }
+    }
+  }
+
+  static inline void write8BurstKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint8_t d) {
+    tftsim_dataWrite(d); tftsim_wrStore(true); tftsim_wrStore(false);
+  }
+
+  static inline void writeColorsKernel(volatile uint8_t *wr, uint8_t active,
+    uint8_t idle, uint16_t *data, uint8_t n) {
+    while(n--) {
+      uint16_t c = *data++;
+      tftsim_dataWrite(c >> 8); tftsim_wrStore(true); tftsim_wrStore(false);
+      tftsim_dataWrite(c);      tftsim_wrStore(true); tftsim_wrStore(false);
+    }
+  }
+
+ #endif
+
 #else
 
  #error "Board type unsupported / not recognized"
 
 #endif
 
-#if !defined(__SAM3X8E__)
+#if !defined(__SAM3X8E__) && !defined(TFTLCD_HOST_SIM)
 // Stuff common to all Arduino AVR board types:
 
 #ifdef USE_ADAFRUIT_SHIELD_PINOUT
@@ -386,6 +540,21 @@
 // Data write strobe, ~2 instructions and always inline
 #define WR_STROBE { WR_ACTIVE; WR_IDLE; }
 
+#ifdef TFTLCD_BURST_KERNELS
+// Bursts of pixel data with CS active and CD high (see the kernels above)
+#define writeRun(hi, lo, n) writeRunKernel(wrPort, \
+  *wrPort & wrPinUnset, *wrPort | wrPinSet, hi, lo, n)
+#define writeColors(data, n) writeColorsKernel(wrPort, \
+  *wrPort & wrPinUnset, *wrPort | wrPinSet, data, n)
+// Single bytes the same way; WR_BURST_BEGIN declares what they use
+#define WR_BURST_BEGIN volatile uint8_t *wrBurst = wrPort; \
+  uint8_t wrLow = *wrPort & wrPinUnset, wrHigh = *wrPort | wrPinSet;
+#define write8burst(d) write8BurstKernel(wrBurst, wrLow, wrHigh, d)
+#else
+#define WR_BURST_BEGIN
+#define write8burst(d) write8(d)
+#endif
+
 // These higher-level operations are usually functionalized,
 // except on Mega where's there's gobs and gobs of program space.
 
@@ -74,6 +74,7 @@
 #define ILI9341_COLADDRSET         0x2A
 #define ILI9341_PAGEADDRSET        0x2B
 #define ILI9341_MEMORYWRITE        0x2C
+#define ILI9341_MEMORYREAD         0x2E
 #define ILI9341_PIXELFORMAT        0x3A
 #define ILI9341_FRAMECONTROL       0xB1
 #define ILI9341_DISPLAYFUNC        0xB6
@@ -93,6 +94,9 @@
 #define ILI9341_MADCTL_BGR 0x08
 #define ILI9341_MADCTL_MH  0x04
 
+#define ILI9341_VSCRDEF    0x33 // Vertical scrolling definition
+#define ILI9341_VSCRSADD   0x37 // Vertical scrolling start address
+
 
 
 #define HX8357_NOP     0x00
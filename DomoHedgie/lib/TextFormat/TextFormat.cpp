@@ -0,0 +1,75 @@
+#include "TextFormat.h"
+
+char *formatUnsigned(char *s, uint32_t value, uint8_t width, char pad) {
+  char    digits[10];
+  uint8_t n = 0;
+  // Values that fit in 16 bits take the cheaper division on AVR
+  while(value > 0xFFFF) {
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  }
+  uint16_t v = value;
+  do {
+    digits[n++] = '0' + v % 10;
+    v /= 10;
+  } while(v);
+  while(width > n) {
+    *s++ = pad;
+    width--;
+  }
+  while(n) *s++ = digits[--n];
+  *s = 0;
+  return s;
+}
+
+char *formatSigned(char *s, int32_t value, uint8_t width, char pad) {
+  if(value >= 0) return formatUnsigned(s, value, width, pad);
+  uint32_t magnitude = -(uint32_t)value;
+  if(pad == '0') {
+    *s++ = '-';
+    return formatUnsigned(s, magnitude, width ? width - 1 : 0, pad);
+  }
+  // Spaces go before the sign
+  char    digits[TEXT_FORMAT_DIGITS + 1];
+  uint8_t n = formatUnsigned(digits, magnitude) - digits + 1;
+  while(width > n) {
+    *s++ = pad;
+    width--;
+  }
+  *s++ = '-';
+  memcpy(s, digits, n);
+  return s + n - 1;
+}
+
+char *formatDateTime(char *s, uint8_t size, const __FlashStringHelper *format,
+        const DateTime &dt) {
+  // No room for the NUL: nothing is written
+  if(!size) return s;
+  const char *p   = (const char *)format;
+  char       *end = s + size - 1;
+  while(s < end) {
+    char c = pgm_read_byte(p++);
+    if(!c) break;
+    if(c != '%') {
+      *s++ = c;
+      continue;
+    }
+    uint16_t value;
+    uint8_t  width = 2;
+    switch(c = pgm_read_byte(p++)) {
+      case 'd': value = dt.day();           break;
+      case 'm': value = dt.month();         break;
+      case 'y': value = dt.year() % 100;    break;
+      case 'Y': value = dt.year(); width = 4; break;
+      case 'H': value = dt.hour();          break;
+      case 'M': value = dt.minute();        break;
+      case 'S': value = dt.second();        break;
+      case 0  : *s = 0; return s;
+      default : *s++ = c; continue;
+    }
+    if(end - s < width) break;
+    s = formatUnsigned(s, value, width);
+  }
+  *s = 0;
+  return s;
+}
@@ -0,0 +1,40 @@
+// Text formatting into buffers the caller owns, with no String and no
+// heap.
+//
+// Numbers are written in decimal, padded on the left to a minimum width.
+// Dates and times are expanded from a template in flash, e.g.
+//   char date[9];
+//   formatDateTime(date, sizeof(date), F("%d/%m/%y"), rtcTime.now());
+// where %d, %m, %y, %Y, %H, %M and %S stand for the day, month, year (2
+// or 4 digits), hour, minute and second, all zero-padded, %% for a '%',
+// and anything else is copied.  Every function NUL-terminates the text and
+// returns a pointer to that NUL, so calls can be chained.
+
+#ifndef _TEXT_FORMAT_H_
+#define _TEXT_FORMAT_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "RTClib.h"
+
+// Longest number formatUnsigned()/formatSigned() write without padding
+#define TEXT_FORMAT_DIGITS 11 // "-2147483648"
+
+// 'value' in at least 'width' characters, padded with 'pad'; 's' must
+// hold max(width, digits) + 1 bytes.
+char *formatUnsigned(char *s, uint32_t value, uint8_t width = 0, char pad = '0');
+// Same with a leading '-' for negative values; zero padding goes after
+// the sign.
+char *formatSigned(char *s, int32_t value, uint8_t width = 0, char pad = '0');
+
+// Expands 'format' (in flash, see above) for 'dt', writing at most
+// 'size' bytes with the NUL.  A 'size' of 0 writes nothing, not even the
+// NUL, and returns 's'.
+char *formatDateTime(char *s, uint8_t size, const __FlashStringHelper *format,
+        const DateTime &dt);
+
+#endif // _TEXT_FORMAT_H_
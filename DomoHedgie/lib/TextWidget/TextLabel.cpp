@@ -0,0 +1,46 @@
+#include "TextLabel.h"
+
+TextLabel::TextLabel(const char *text, const GFXfont *font, uint8_t size) :
+  str(text), fnt(font), size(size), measured(false), x1(0), y1(0), w(0), h(0) {
+}
+
+const char *TextLabel::text(void) const {
+  return str;
+}
+
+const GFXfont *TextLabel::font(void) const {
+  return fnt;
+}
+
+void TextLabel::measure(void) {
+  if(measured) return;
+  textBounds(fnt, size, str, 0, 0, &x1, &y1, &w, &h);
+  measured = true;
+}
+
+int16_t TextLabel::left(void) {
+  measure();
+  return x1;
+}
+
+int16_t TextLabel::top(void) {
+  measure();
+  return y1;
+}
+
+uint16_t TextLabel::width(void) {
+  measure();
+  return w;
+}
+
+uint16_t TextLabel::height(void) {
+  measure();
+  return h;
+}
+
+void TextLabel::print(Adafruit_GFX *gfx, int16_t x, int16_t y) const {
+  gfx->setFont(fnt);
+  gfx->setTextSize(size);
+  gfx->setCursor(x, y);
+  gfx->print(str);
+}
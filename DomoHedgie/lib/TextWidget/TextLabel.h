@@ -0,0 +1,45 @@
+// Static custom-font text with a layout cache.
+//
+// A TextLabel is a fixed string (typically an i18n define) in a fixed font.
+// Its bounds are measured from the glyph table the first time any of them
+// is asked for and kept from then on, so layout code that aligns labels on
+// every repaint (right-aligned columns, centred captions) just reads four
+// numbers.  Bounds are relative to the cursor: top() is the offset from
+// the baseline to the top of the text, so it is negative.
+
+#ifndef _TEXT_LABEL_H_
+#define _TEXT_LABEL_H_
+
+#include "TextWidget.h"
+
+class TextLabel {
+
+ public:
+
+  TextLabel(const char *text, const GFXfont *font, uint8_t size = 1);
+
+  const char    *text(void) const;
+  const GFXfont *font(void) const;
+
+  int16_t  left(void),
+           top(void);
+  uint16_t width(void),
+           height(void);
+
+  // Sets the display's font and size and prints the label with its
+  // baseline at (x, y).  Colour is left as the caller set it.
+  void     print(Adafruit_GFX *gfx, int16_t x, int16_t y) const;
+
+ private:
+
+  void     measure(void);
+
+  const char    *str;
+  const GFXfont *fnt;
+  uint8_t        size;
+  boolean        measured;
+  int16_t        x1, y1;
+  uint16_t       w, h;
+};
+
+#endif // _TEXT_LABEL_H_
@@ -0,0 +1,162 @@
+#ifdef __AVR__
+ #include <avr/pgmspace.h>
+#endif
+#include "TextWidget.h"
+
+#ifndef pgm_read_byte
+ #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#endif
+#ifndef pgm_read_dword
+ #define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#endif
+#if !defined(__INT_MAX__) || (__INT_MAX__ > 0xFFFF)
+ #define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
+#else
+ #define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
+#endif
+
+TextWidget::TextWidget(Adafruit_GFX *gfx, const GFXfont *font, uint8_t size,
+  uint16_t color, uint8_t align) :
+  gfx(gfx), font(font), size(size), align(align), drawFrom(0), color(color),
+  x(0), y(0), shownX(0), shownY(0), onScreen(false), pending(false) {
+  text[0] = shown[0] = 0;
+}
+
+void TextWidget::setPosition(int16_t x, int16_t y) {
+  this->x = x;
+  this->y = y;
+}
+
+void TextWidget::setText(const char *text) {
+  strncpy(this->text, text, TEXT_WIDGET_MAX_LENGTH);
+  this->text[TEXT_WIDGET_MAX_LENGTH] = 0;
+}
+
+void TextWidget::invalidate(void) {
+  onScreen = false;
+}
+
+int16_t TextWidget::endX(void) const {
+  return cursorX(text) + advance(text, strlen(text));
+}
+
+int16_t TextWidget::baseline(void) const {
+  return y;
+}
+
+// Cursor advance of the first 'n' characters of 's'
+int16_t TextWidget::advance(const char *s, uint8_t n) const {
+  uint8_t   first = pgm_read_byte(&font->first),
+            last  = pgm_read_byte(&font->last);
+  GFXglyph *glyph = (GFXglyph *)pgm_read_pointer(&font->glyph);
+  int16_t   a     = 0;
+
+  while(n-- && *s) {
+    uint8_t c = *s++;
+    if((c >= first) && (c <= last)) {
+      a += (uint8_t)pgm_read_byte(&glyph[c - first].xAdvance);
+    }
+  }
+  return a * size;
+}
+
+void textBounds(const GFXfont *font, uint8_t size, const char *s,
+  int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
+  uint8_t   first = pgm_read_byte(&font->first),
+            last  = pgm_read_byte(&font->last);
+  GFXglyph *glyph = (GFXglyph *)pgm_read_pointer(&font->glyph);
+  int16_t   minx = 0x7FFF, miny = 0x7FFF, maxx = -0x7FFF, maxy = -0x7FFF;
+
+  for(; *s; s++) {
+    uint8_t c = *s;
+    if((c < first) || (c > last)) continue;
+    GFXglyph *g  = &glyph[c - first];
+    uint8_t   gw = pgm_read_byte(&g->width),
+              gh = pgm_read_byte(&g->height);
+    if(gw && gh) {
+      int16_t gx1 = x + (int8_t)pgm_read_byte(&g->xOffset) * size,
+              gy1 = y + (int8_t)pgm_read_byte(&g->yOffset) * size,
+              gx2 = gx1 + gw * size - 1,
+              gy2 = gy1 + gh * size - 1;
+      if(gx1 < minx) minx = gx1;
+      if(gy1 < miny) miny = gy1;
+      if(gx2 > maxx) maxx = gx2;
+      if(gy2 > maxy) maxy = gy2;
+    }
+    x += (uint8_t)pgm_read_byte(&g->xAdvance) * size;
+  }
+  if(maxx >= minx) {
+    *x1 = minx; *y1 = miny;
+    *w  = maxx - minx + 1;
+    *h  = maxy - miny + 1;
+  } else {
+    *x1 = x; *y1 = y;
+    *w  = *h = 0;
+  }
+}
+
+int16_t TextWidget::cursorX(const char *s) const {
+  if(align == TEXT_WIDGET_ALIGN_LEFT) return x;
+  int16_t  bx, by;
+  uint16_t bw, bh;
+  textBounds(font, size, s, 0, 0, &bx, &by, &bw, &bh);
+  return (align == TEXT_WIDGET_ALIGN_CENTER) ? x - (bw / 2) : x - bw;
+}
+
+boolean TextWidget::update(BackgroundPainter background) {
+  if(!erase(background)) return false;
+  draw();
+  return true;
+}
+
+boolean TextWidget::erase(BackgroundPainter background) {
+  int16_t cx    = cursorX(text);
+  boolean moved = (cx != shownX) || (y != shownY);
+  uint8_t from  = 0;
+
+  if(onScreen) {
+    if(!moved) {
+      while(text[from] && (text[from] == shown[from])) from++;
+      if(!text[from] && !shown[from]) return false; // Nothing changed
+    }
+
+    int16_t  bx, by;
+    uint16_t bw, bh;
+    textBounds(font, size, &shown[from], shownX + advance(shown, from),
+      shownY, &bx, &by, &bw, &bh);
+    if(bw && bh) {
+      background(bx, by, bw, bh);
+      // Redraw the last unchanged glyph too if it reaches into the box
+      if(from) {
+        char     prev[2] = { shown[from - 1], 0 };
+        int16_t  gx, gy;
+        uint16_t gw, gh;
+        textBounds(font, size, prev, shownX + advance(shown, from - 1),
+          shownY, &gx, &gy, &gw, &gh);
+        if(gw && (gx + (int16_t)gw > bx) && (gx < bx + (int16_t)bw)) from--;
+      }
+    }
+  }
+
+  drawFrom = from;
+  pending  = true;
+  onScreen = false;
+  return true;
+}
+
+void TextWidget::draw(void) {
+  if(!pending) return;
+
+  int16_t cx = cursorX(text);
+  gfx->setFont(font);
+  gfx->setTextSize(size);
+  gfx->setTextColor(color);
+  gfx->setCursor(cx + advance(text, drawFrom), y);
+  gfx->print(&text[drawFrom]);
+
+  strcpy(shown, text);
+  shownX   = cx;
+  shownY   = y;
+  onScreen = true;
+  pending  = false;
+}
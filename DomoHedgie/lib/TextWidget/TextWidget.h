@@ -0,0 +1,80 @@
+// Retained-mode text for Adafruit_GFX displays.
+//
+// A TextWidget owns one short line of custom-font text at a fixed anchor.
+// setText() only records the new value; update() compares it with what is
+// on screen and repaints just the glyphs from the first difference on:
+// the old glyphs are erased through the owner's BackgroundPainter (which
+// knows about gradients, panels, etc.) and the new ones drawn transparently.
+// A one-digit change therefore costs one glyph box, not a section repaint.
+
+#ifndef _TEXT_WIDGET_H_
+#define _TEXT_WIDGET_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include <Adafruit_GFX.h>
+
+#define TEXT_WIDGET_MAX_LENGTH 8
+
+#define TEXT_WIDGET_ALIGN_LEFT   0 // Anchor is the cursor position
+#define TEXT_WIDGET_ALIGN_CENTER 1 // Anchor is the middle of the text
+#define TEXT_WIDGET_ALIGN_RIGHT  2 // Anchor is the right edge of the text
+
+// Restores the background of a screen rectangle
+typedef void (*BackgroundPainter)(int16_t x, int16_t y, int16_t w, int16_t h);
+
+// Same box Adafruit_GFX::getTextBounds() reports for a single line of
+// custom-font text, read straight from the glyph table: no display font or
+// wrap settings are touched and nothing is copied.
+void textBounds(const GFXfont *font, uint8_t size, const char *s,
+  int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+
+class TextWidget {
+
+ public:
+
+  TextWidget(Adafruit_GFX *gfx, const GFXfont *font, uint8_t size,
+    uint16_t color, uint8_t align = TEXT_WIDGET_ALIGN_LEFT);
+
+  // Anchor x and text baseline
+  void    setPosition(int16_t x, int16_t y);
+  // Text is truncated to TEXT_WIDGET_MAX_LENGTH characters
+  void    setText(const char *text);
+  // The area under the widget has been repainted by someone else, so the
+  // next update() draws the whole text without erasing anything first.
+  void    invalidate(void);
+  // Brings the screen in line with the current text and position.
+  // Returns true if anything was drawn.
+  boolean update(BackgroundPainter background);
+  // update() in two halves, for widgets whose areas may overlap while
+  // they change (e.g. a unit following a centred reading): erase all of
+  // them first, then draw them.
+  boolean erase(BackgroundPainter background);
+  void    draw(void);
+
+  // Cursor x after the last glyph of the current text, and the baseline
+  int16_t endX(void) const,
+          baseline(void) const;
+
+ private:
+
+  int16_t advance(const char *s, uint8_t n) const,
+          cursorX(const char *s) const;
+
+  Adafruit_GFX  *gfx;
+  const GFXfont *font;
+  uint8_t        size, align,
+                 drawFrom;           // First character draw() will paint
+  uint16_t       color;
+  int16_t        x, y,               // Requested anchor and baseline
+                 shownX, shownY;     // Cursor used for the text on screen
+  char           text[TEXT_WIDGET_MAX_LENGTH + 1],
+                 shown[TEXT_WIDGET_MAX_LENGTH + 1];
+  boolean        onScreen, pending;
+};
+
+#endif // _TEXT_WIDGET_H_
@@ -0,0 +1,99 @@
+#include "Arduino.h"
+#include "sim_clock.h"
+#include "sim_io.h"
+#include "DHT11_sim.h"
+
+#define START_LOW_US 18000 // Shortest start signal the sensor accepts
+#define WAIT_US      30    // Release to response
+#define RESPONSE_US  80    // Response low, then high
+#define BIT_LOW_US   50
+#define ZERO_HIGH_US 26
+#define ONE_HIGH_US  70
+
+static struct {
+  uint8_t       pin;
+  uint8_t       data[5];
+  uint8_t       drop;
+  bool          out, low;   // MCU driving the line, driving it low
+  uint64_t      lowSince, lowFor;
+  int           edge;       // Next edge of the frame being sent, -1 idle
+  unsigned long frames, dropped;
+} dht = { 0, { 0 }, 0, false, false, 0, 0, -1, 0, 0 };
+
+static uint64_t us(uint32_t n) {
+  return (uint64_t)n * SIM_CYCLES_PER_US;
+}
+
+// Edge 0 pulls the line low for the response, edge 1 raises it; then each
+// bit is a falling edge (start of its 50 us low) and a rising edge, and
+// the falling edge after the last bit is followed by the release.
+static void step(void *arg) {
+  int e = dht.edge++;
+  if(e == 0) {
+    sim_pin_set(dht.pin, LOW);
+    sim_at(sim_cycles() + us(RESPONSE_US), step, NULL);
+  } else if(e == 1) {
+    sim_pin_set(dht.pin, HIGH);
+    sim_at(sim_cycles() + us(RESPONSE_US), step, NULL);
+  } else if(e < 2 + 2 * 40 + 1) {
+    int i = (e - 2) / 2;
+    if(!(e & 1)) {
+      sim_pin_set(dht.pin, LOW);
+      sim_at(sim_cycles() + us(BIT_LOW_US), step, NULL);
+    } else {
+      bool one = dht.data[i >> 3] & (0x80 >> (i & 7));
+      sim_pin_set(dht.pin, HIGH);
+      sim_at(sim_cycles() + us(one ? ONE_HIGH_US : ZERO_HIGH_US), step, NULL);
+    }
+  } else {
+    sim_pin_set(dht.pin, HIGH);
+    dht.edge = -1;
+    dht.frames++;
+  }
+}
+
+// A start signal is the line driven low for long enough and then let go
+// (the library raises it before switching to input, so the low period and
+// the release are separate calls).
+static void watch(uint8_t pin) {
+  bool out = sim_pin_output(pin), low = out && !digitalRead(pin);
+  if(low && !dht.low) dht.lowSince = sim_cycles();
+  if(!low && dht.low) dht.lowFor = sim_cycles() - dht.lowSince;
+  if(!out && dht.out && (dht.edge < 0) && (dht.lowFor >= us(START_LOW_US))) {
+    dht.lowFor = 0;
+    if(dht.drop) {
+      dht.drop--;
+      dht.dropped++;
+    } else {
+      dht.edge = 0;
+      sim_at(sim_cycles() + us(WAIT_US), step, NULL);
+    }
+  }
+  dht.out = out;
+  dht.low = low;
+}
+
+void dhtsim_attach(uint8_t pin) {
+  dht.pin = pin;
+  sim_pin_watch(pin, watch);
+}
+
+void dhtsim_set(uint8_t humidity, uint8_t temperature) {
+  dht.data[0] = humidity;
+  dht.data[1] = 0;
+  dht.data[2] = temperature;
+  dht.data[3] = 0;
+  dht.data[4] = humidity + temperature;
+}
+
+void dhtsim_drop(uint8_t requests) {
+  dht.drop = requests;
+}
+
+unsigned long dhtsim_frames(void) {
+  return dht.frames;
+}
+
+unsigned long dhtsim_dropped(void) {
+  return dht.dropped;
+}
@@ -0,0 +1,27 @@
+// DHT11 model on one simulated pin.
+//
+// Follows the single-wire protocol from the sensor side: once the MCU has
+// held the line low for at least 18 ms and released it, the model answers
+// 30 us later with the 80 us low / 80 us high response and 40 bits (50 us
+// low, then 26 us high for a 0 or 70 us high for a 1) and releases the
+// line.  Every edge is driven with sim_pin_set() at its exact cycle, so
+// the sketch's pin change interrupt sees the same timing as on the board.
+
+#ifndef _DHT11_SIM_H_
+#define _DHT11_SIM_H_
+
+#include <stdint.h>
+
+void dhtsim_attach(uint8_t pin);
+
+// Reading reported from now on (integral, as the DHT11 gives them)
+void dhtsim_set(uint8_t humidity, uint8_t temperature);
+
+// Ignore the next 'requests' start signals, so the MCU times out
+void dhtsim_drop(uint8_t requests);
+
+// Frames sent and start signals ignored since attach
+unsigned long dhtsim_frames(void);
+unsigned long dhtsim_dropped(void);
+
+#endif // _DHT11_SIM_H_
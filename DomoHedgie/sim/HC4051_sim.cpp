@@ -0,0 +1,31 @@
+#include "Arduino.h"
+#include "sim_io.h"
+#include "HC4051_sim.h"
+
+static struct {
+  uint8_t s[3], z;
+  uint8_t levels;   // Bit n: level of channel n
+} mux = { { 0, 0, 0 }, 0, 0xFF };
+
+static void update(uint8_t pin) {
+  uint8_t channel = 0;
+  for(uint8_t i=0; i<3; i++) {
+    if(sim_port[mux.s[i]] & 1) channel |= 1 << i;
+  }
+  sim_pin_set(mux.z, (mux.levels >> channel) & 1);
+}
+
+void muxsim_attach(uint8_t s0, uint8_t s1, uint8_t s2, uint8_t z) {
+  mux.s[0] = s0;
+  mux.s[1] = s1;
+  mux.s[2] = s2;
+  mux.z    = z;
+  for(uint8_t i=0; i<3; i++) sim_pin_watch(mux.s[i], update);
+  update(0);
+}
+
+void muxsim_set(uint8_t channel, uint8_t level) {
+  if(level) mux.levels |= 1 << channel;
+  else      mux.levels &= ~(1 << channel);
+  update(0);
+}
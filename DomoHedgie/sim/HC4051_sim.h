@@ -0,0 +1,17 @@
+// 74HC4051 8-channel multiplexer model.
+//
+// Follows the select lines the MCU writes and drives the common pin with
+// the level of the selected channel, as switches and buttons to ground
+// with pull-ups would.  Every channel starts high (open).
+
+#ifndef _HC4051_SIM_H_
+#define _HC4051_SIM_H_
+
+#include <stdint.h>
+
+void muxsim_attach(uint8_t s0, uint8_t s1, uint8_t s2, uint8_t z);
+
+// Level of 'channel' (0 to 7) from now on
+void muxsim_set(uint8_t channel, uint8_t level);
+
+#endif // _HC4051_SIM_H_
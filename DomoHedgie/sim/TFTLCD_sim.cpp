@@ -0,0 +1,315 @@
+#include <string.h>
+
+#include "Arduino.h"
+#include "TFTLCD_sim.h"
+
+// HX8357D commands the model decodes (same values as the ILI9341)
+#define CMD_SWRESET 0x01
+#define CMD_SLPIN   0x10
+#define CMD_SLPOUT  0x11
+#define CMD_DISPOFF 0x28
+#define CMD_DISPON  0x29
+#define CMD_CASET   0x2A
+#define CMD_PASET   0x2B
+#define CMD_RAMWR   0x2C
+#define CMD_RAMRD   0x2E
+#define CMD_VSCRDEF 0x33
+#define CMD_MADCTL  0x36
+#define CMD_VSCRSADD 0x37
+#define CMD_RAMWRC  0x3C
+#define CMD_RAMRDC  0x3E
+
+#define MADCTL_MY 0x80
+#define MADCTL_MX 0x40
+#define MADCTL_MV 0x20
+
+#define MAX_ARGS 16
+
+// Sleep timing rules: no command for 5 ms after SLPIN/SLPOUT, and at
+// least 120 ms from one of them (or a reset) to the opposite one
+#define SLEEP_BUSY_MS  5
+#define SLEEP_HOLD_MS  120
+
+static uint16_t gram[TFTSIM_HEIGHT][TFTSIM_WIDTH];
+
+static struct {
+  bool     cs, cd, wr, rd, readDir; // true = asserted / command / input
+  uint8_t  bus;
+  uint8_t  cmd, args[MAX_ARGS], nArgs;
+  uint8_t  madctl;
+  uint16_t xs, xe, ys, ye, x, y;    // Address window and counter
+  uint8_t  hi;                      // First byte of a pixel in flight
+  bool     hiPending;
+  uint32_t readIndex;               // Bytes read since last command
+  uint16_t readPixel;               // Pixel being returned by RAMRD
+  bool     asleep, displayOn;
+  uint64_t sleepChanged;            // Cycle of last SLPIN/SLPOUT/reset
+  bool     sleepBusy;               // SLPIN/SLPOUT was the last command
+  uint16_t tfa, vsa, vsp;           // Vertical scroll area and start
+} lcd = {
+  false, false, false, false, false, 0, 0, { 0 }, 0, 0,
+  0, TFTSIM_WIDTH - 1, 0, TFTSIM_HEIGHT - 1, 0, 0, 0, false, 0, 0,
+  true, false, 0, false, 0, TFTSIM_HEIGHT, 0
+};
+
+static unsigned long sleepViolations;
+
+static tftsim_stats stats;
+
+static inline void charge(uint32_t cycles) {
+  stats.busCycles += cycles;
+  sim_advance(cycles);
+}
+
+// Logical (column, page) address in the current MADCTL orientation to the
+// GRAM cell it selects, or NULL when outside the panel.  With 'shown' the
+// row is the panel line instead, and the cell is the one that line shows
+// under the current vertical scroll.
+static uint16_t *cell(uint16_t c, uint16_t p, bool shown = false) {
+  uint16_t col = c, row = p;
+  if(lcd.madctl & MADCTL_MV) { col = p; row = c; }
+  if((col >= TFTSIM_WIDTH) || (row >= TFTSIM_HEIGHT)) return NULL;
+  if(lcd.madctl & MADCTL_MX) col = TFTSIM_WIDTH  - 1 - col;
+  if(lcd.madctl & MADCTL_MY) row = TFTSIM_HEIGHT - 1 - row;
+  if(shown && (row >= lcd.tfa) && (row < lcd.tfa + lcd.vsa) &&
+     (lcd.vsp >= lcd.tfa) && (lcd.vsp < lcd.tfa + lcd.vsa)) {
+    row = lcd.tfa + (row - lcd.tfa + lcd.vsp - lcd.tfa) % lcd.vsa;
+  }
+  return &gram[row][col];
+}
+
+static void advance(void) {
+  if(++lcd.x > lcd.xe) {
+    lcd.x = lcd.xs;
+    if(++lcd.y > lcd.ye) lcd.y = lcd.ys;
+  }
+}
+
+static void command(uint8_t c) {
+  uint64_t since = sim_cycles() - lcd.sleepChanged;
+
+  if(lcd.sleepBusy && (since < SLEEP_BUSY_MS * SIM_CYCLES_PER_MS)) {
+    sleepViolations++;
+  }
+  lcd.sleepBusy = false;
+  stats.commands++;
+  lcd.cmd       = c;
+  lcd.nArgs     = 0;
+  lcd.hiPending = false;
+  lcd.readIndex = 0;
+  switch(c) {
+    case CMD_SWRESET:
+      lcd.madctl = 0;
+      lcd.xs = 0; lcd.xe = TFTSIM_WIDTH  - 1;
+      lcd.ys = 0; lcd.ye = TFTSIM_HEIGHT - 1;
+      lcd.tfa = 0; lcd.vsa = TFTSIM_HEIGHT; lcd.vsp = 0;
+      lcd.asleep       = true;
+      lcd.displayOn    = false;
+      lcd.sleepChanged = sim_cycles();
+      break;
+    case CMD_SLPIN:
+    case CMD_SLPOUT:
+      if((lcd.asleep != (c == CMD_SLPIN)) &&
+         (since < SLEEP_HOLD_MS * SIM_CYCLES_PER_MS)) sleepViolations++;
+      lcd.asleep       = (c == CMD_SLPIN);
+      lcd.sleepChanged = sim_cycles();
+      lcd.sleepBusy    = true;
+      break;
+    case CMD_DISPOFF: lcd.displayOn = false; break;
+    case CMD_DISPON : lcd.displayOn = true;  break;
+    case CMD_CASET: stats.caset++; break;
+    case CMD_PASET: stats.paset++; break;
+    case CMD_RAMWR:
+      stats.ramwr++;
+      lcd.x = lcd.xs;
+      lcd.y = lcd.ys;
+      break;
+    case CMD_RAMRD:
+      stats.ramrd++;
+      lcd.x = lcd.xs;
+      lcd.y = lcd.ys;
+      break;
+  }
+}
+
+static void data(uint8_t d) {
+  stats.dataBytes++;
+  if((lcd.cmd == CMD_RAMWR) || (lcd.cmd == CMD_RAMWRC)) {
+    if(!lcd.hiPending) {
+      lcd.hi        = d;
+      lcd.hiPending = true;
+      return;
+    }
+    lcd.hiPending = false;
+    uint16_t *p = cell(lcd.x, lcd.y);
+    if(p) *p = ((uint16_t)lcd.hi << 8) | d;
+    stats.pixels++;
+    advance();
+    return;
+  }
+
+  if(lcd.nArgs < MAX_ARGS) lcd.args[lcd.nArgs] = d;
+  lcd.nArgs++;
+  switch(lcd.cmd) {
+    case CMD_CASET:
+      if(lcd.nArgs == 4) {
+        lcd.xs = ((uint16_t)lcd.args[0] << 8) | lcd.args[1];
+        lcd.xe = ((uint16_t)lcd.args[2] << 8) | lcd.args[3];
+      }
+      break;
+    case CMD_PASET:
+      if(lcd.nArgs == 4) {
+        lcd.ys = ((uint16_t)lcd.args[0] << 8) | lcd.args[1];
+        lcd.ye = ((uint16_t)lcd.args[2] << 8) | lcd.args[3];
+      }
+      break;
+    case CMD_MADCTL:
+      if(lcd.nArgs == 1) lcd.madctl = d;
+      break;
+    case CMD_VSCRDEF:
+      if(lcd.nArgs == 6) {
+        uint16_t tfa = ((uint16_t)lcd.args[0] << 8) | lcd.args[1],
+                 vsa = ((uint16_t)lcd.args[2] << 8) | lcd.args[3],
+                 bfa = ((uint16_t)lcd.args[4] << 8) | lcd.args[5];
+        // Ignored by the controller unless the three add up to the panel
+        if((tfa + vsa + bfa == TFTSIM_HEIGHT) && vsa) {
+          lcd.tfa = tfa;
+          lcd.vsa = vsa;
+        }
+      }
+      break;
+    case CMD_VSCRSADD:
+      if(lcd.nArgs == 2) lcd.vsp = ((uint16_t)lcd.args[0] << 8) | lcd.args[1];
+      break;
+  }
+}
+
+// Register reads answer what readID() expects from an HX8357D; memory
+// reads return a dummy byte followed by R, G, B bytes per pixel (18-bit
+// read-back format, colour in the top bits of each byte).
+static uint8_t readByte(void) {
+  uint32_t i = lcd.readIndex++;
+
+  if((lcd.cmd == CMD_RAMRD) || (lcd.cmd == CMD_RAMRDC)) {
+    if(lcd.cmd == CMD_RAMRD) {
+      if(i == 0) return 0;
+      i--;
+    }
+    switch(i % 3) {
+      case 0: {
+        uint16_t *p = cell(lcd.x, lcd.y);
+        lcd.readPixel = p ? *p : 0;
+        advance();
+        return (lcd.readPixel >> 8) & 0xF8;
+      }
+      case 1 : return (lcd.readPixel >> 3) & 0xFC;
+      default: return (lcd.readPixel << 3) & 0xF8;
+    }
+  }
+
+  static const uint8_t rddid[4] = { 0x00, 0x00, 0x80, 0x00 },
+                       setpwr[4] = { 0x00, 0x99, 0x00, 0x00 };
+  switch(lcd.cmd) {
+    case 0x04: return (i < 4) ? rddid[i]  : 0;
+    case 0xD0: return (i < 4) ? setpwr[i] : 0;
+    case 0x0B: return (i == 1) ? lcd.madctl : 0;
+  }
+  return 0;
+}
+
+void tftsim_csActive(void)  { charge(TFTSIM_CYCLES_EDGE); lcd.cs = true;  }
+void tftsim_csIdle(void)    { charge(TFTSIM_CYCLES_EDGE); lcd.cs = false; }
+void tftsim_cdCommand(void) { charge(TFTSIM_CYCLES_EDGE); lcd.cd = true;  }
+void tftsim_cdData(void)    { charge(TFTSIM_CYCLES_EDGE); lcd.cd = false; }
+void tftsim_rdActive(void)  { charge(TFTSIM_CYCLES_EDGE); lcd.rd = true;  }
+void tftsim_rdIdle(void)    { charge(TFTSIM_CYCLES_EDGE); lcd.rd = false; }
+
+void tftsim_wrActive(void) {
+  charge(TFTSIM_CYCLES_EDGE);
+  lcd.wr = true;
+}
+
+// The controller latches the data bus on the rising edge of WR
+static void wrRise(void) {
+  if(!lcd.wr) return;
+  lcd.wr = false;
+  stats.strobes++;
+  if(!lcd.cs || lcd.readDir) return;
+  if(lcd.cd) command(lcd.bus);
+  else       data(lcd.bus);
+}
+
+void tftsim_wrIdle(void) {
+  charge(TFTSIM_CYCLES_EDGE);
+  wrRise();
+}
+
+void tftsim_wrStore(bool active) {
+  charge(TFTSIM_CYCLES_STORE);
+  if(active) lcd.wr = true;
+  else       wrRise();
+}
+
+void tftsim_dataWrite(uint8_t d) {
+  charge(TFTSIM_CYCLES_PORT_WRITE);
+  lcd.bus = d;
+}
+
+uint8_t tftsim_dataRead(void) {
+  charge(TFTSIM_CYCLES_READ);
+  stats.readBytes++;
+  return (lcd.cs && lcd.readDir) ? readByte() : 0xFF;
+}
+
+void tftsim_setWriteDir(void) {
+  charge(TFTSIM_CYCLES_DIR);
+  lcd.readDir = false;
+}
+
+void tftsim_setReadDir(void) {
+  charge(TFTSIM_CYCLES_DIR);
+  lcd.readDir = true;
+}
+
+const tftsim_stats *tftsim_getStats(void) {
+  return &stats;
+}
+
+void tftsim_resetStats(void) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+bool tftsim_panelLit(void) {
+  return lcd.displayOn && !lcd.asleep;
+}
+
+unsigned long tftsim_sleepViolations(void) {
+  return sleepViolations;
+}
+
+uint16_t tftsim_pixel(int16_t x, int16_t y) {
+  if((x < 0) || (y < 0)) return 0;
+  uint16_t *p = cell(x, y, true);
+  return p ? *p : 0;
+}
+
+bool tftsim_dumpPPM(const char *filename) {
+  FILE *f = fopen(filename, "wb");
+  if(!f) return false;
+  bool    mv = lcd.madctl & MADCTL_MV;
+  int16_t w  = mv ? TFTSIM_HEIGHT : TFTSIM_WIDTH,
+          h  = mv ? TFTSIM_WIDTH  : TFTSIM_HEIGHT;
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for(int16_t y=0; y<h; y++) {
+    for(int16_t x=0; x<w; x++) {
+      uint16_t c = tftsim_pixel(x, y);
+      uint8_t  rgb[3] = {
+        (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+        (uint8_t)(((c >>  5) & 0x3F) * 255 / 63),
+        (uint8_t)(( c        & 0x1F) * 255 / 31)
+      };
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return fclose(f) == 0;
+}
@@ -0,0 +1,79 @@
+// Bus model behind the TFTLCD_HOST_SIM branch of pin_magic.h.
+//
+// Every control-line edge and data-port access the library performs lands
+// here.  Each one is charged the AVR cycles it costs on a Mega with the
+// breakout wiring (data on PORTA, control lines through the port pointers
+// set up in the Adafruit_TFTLCD constructor) and the byte stream is
+// decoded as an HX8357D would: CASET/PASET/RAMWR/RAMRD/MADCTL are
+// honoured, pixels land in a framebuffer shown through the vertical
+// scroll (VSCRDEF/VSCRSADD), sleep and display on/off are tracked against
+// their timing rules, everything else is counted.
+//
+// Only bus operations are charged.  Loop bookkeeping and arithmetic
+// between them is not, so absolute times are a lower bound; compare runs
+// against each other rather than against a stopwatch.
+
+#ifndef _TFTLCD_SIM_H_
+#define _TFTLCD_SIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Estimated cost of each bus primitive in CPU cycles
+#define TFTSIM_CYCLES_PORT_WRITE 1 // out PORTA, r
+#define TFTSIM_CYCLES_EDGE       5 // ld, and/or, st through port pointer
+#define TFTSIM_CYCLES_STORE      2 // st of a value held in a register
+#define TFTSIM_CYCLES_DIR        2 // ldi + out DDRA
+#define TFTSIM_CYCLES_READ       (TFTSIM_CYCLES_EDGE + 7 + 1 + TFTSIM_CYCLES_EDGE)
+
+// Native (rotation 0, MADCTL 0) panel geometry
+#define TFTSIM_WIDTH  320
+#define TFTSIM_HEIGHT 480
+
+typedef struct {
+  unsigned long commands;   // Bytes written with CD low
+  unsigned long caset;      // Column address set commands
+  unsigned long paset;      // Page address set commands
+  unsigned long ramwr;      // Memory write commands
+  unsigned long ramrd;      // Memory read commands
+  unsigned long dataBytes;  // Bytes written with CD high
+  unsigned long pixels;     // Pixels stored into GRAM
+  unsigned long readBytes;  // Bytes read back from the controller
+  unsigned long strobes;    // WR pulses
+  uint64_t      busCycles;  // Estimated CPU cycles spent on the bus
+} tftsim_stats;
+
+void    tftsim_csActive(void);
+void    tftsim_csIdle(void);
+void    tftsim_cdCommand(void);
+void    tftsim_cdData(void);
+void    tftsim_wrActive(void);
+void    tftsim_wrIdle(void);
+void    tftsim_wrStore(bool active); // WR edge from a burst kernel
+void    tftsim_rdActive(void);
+void    tftsim_rdIdle(void);
+void    tftsim_dataWrite(uint8_t d);
+uint8_t tftsim_dataRead(void);
+void    tftsim_setWriteDir(void);
+void    tftsim_setReadDir(void);
+
+// Running totals since start-up (or the last reset)
+const tftsim_stats *tftsim_getStats(void);
+void    tftsim_resetStats(void);
+
+// True while the panel shows GRAM: display on and not asleep
+bool    tftsim_panelLit(void);
+
+// Commands sent within 5 ms of SLPIN/SLPOUT, and SLPIN/SLPOUT sent within
+// 120 ms of the opposite one (or a reset), since start-up
+unsigned long tftsim_sleepViolations(void);
+
+// Pixel as it appears on the panel in the current MADCTL orientation,
+// after vertical scrolling
+uint16_t tftsim_pixel(int16_t x, int16_t y);
+
+// Writes the panel, as currently oriented, as a binary PPM.  Returns
+// false if the file cannot be written.
+bool    tftsim_dumpPPM(const char *filename);
+
+#endif // _TFTLCD_SIM_H_
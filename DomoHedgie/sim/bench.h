@@ -0,0 +1,26 @@
+// Micro-benchmarks selectable with 'domohedgie_sim -b <name>'.  Each one
+// runs after setup() so the display is initialised, and prints its own
+// table to stdout.
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+void bench_bus(void);
+void bench_buttons(void);
+void bench_dht(void);
+void bench_display(void);
+void bench_encoder(void);
+void bench_format(void);
+void bench_glyphs(void);
+void bench_gradients(void);
+void bench_history(void);
+void bench_lines(void);
+void bench_log(void);
+void bench_menu(void);
+void bench_mux(void);
+void bench_readback(void);
+void bench_saveunder(void);
+void bench_tasks(void);
+void bench_widgets(void);
+
+#endif // _BENCH_H_
@@ -0,0 +1,159 @@
+// Pixel throughput of the library's bus loops: fillScreen() in a color
+// whose two bytes match (strobes only) and in one whose bytes differ,
+// pushColors() in rows of 60 pixels, and a whole-screen image through
+// single writePixels() calls from RAM, flash and far flash, in both byte
+// orders, then 16- and 1-bit canvas strips through drawCanvas(), partly
+// off screen; each is checked on the panel.  Build once as is and once with
+// 'make clean all SIMFLAGS=-DTFTLCD_NO_BURST_KERNELS' to compare the Mega
+// burst kernels against the WR_STROBE loops they replace.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include "bench.h"
+#include "sim_report.h"
+#include "sim_clock.h"
+
+extern Adafruit_TFTLCD tft;
+void showMainScreen();
+
+#define BENCH_FILLS  4
+#define BENCH_ROW    60
+#define BENCH_PIXELS (480L * 320)
+#define BENCH_STRIP  40
+
+// Stands in for an image in flash; the host has no separate flash space
+static uint16_t image[BENCH_PIXELS] PROGMEM;
+static uint8_t  swapped[BENCH_PIXELS * 2] PROGMEM;
+
+static void report(const sim_phase *phase) {
+  double ms = (double)phase->bus.busCycles / SIM_CYCLES_PER_MS;
+  sim_print_phase(stdout, phase);
+  printf("  %.2f Mpixel/s\n", ms ? phase->bus.pixels / ms / 1000.0 : 0);
+}
+
+static boolean imageShown(void) {
+  for(int16_t y=0; y<tft.height(); y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      if(tftsim_pixel(x, y) != image[(long)y * tft.width() + x]) return false;
+    }
+  }
+  return true;
+}
+
+// The image through one writePixels() or writePixelsFar() call
+static boolean stream(sim_phase *phase, const void *data, uint8_t source,
+  boolean far) {
+  tft.fillScreen(0x0000);
+  tft.setAddrWindow(0, 0, tft.width() - 1, tft.height() - 1);
+  sim_sample before = sim_take();
+  if(far) tft.writePixelsFar((uint_farptr_t)data, BENCH_PIXELS, source);
+  else    tft.writePixels((const uint16_t *)data, BENCH_PIXELS, source);
+  sim_sample after = sim_take();
+  sim_phase_add(phase, &before, &after);
+  return imageShown();
+}
+
+// Strips across the screen, the last one hanging off its bottom edge
+static boolean strips(sim_phase *phase, GFXcanvas16 *c16, GFXcanvas1 *c1) {
+  boolean shown = true;
+  for(int16_t y=0; y<tft.height(); y+=BENCH_STRIP) {
+    int16_t     top = y + BENCH_STRIP / 2;
+    sim_sample  before = sim_take();
+    if(c16) tft.drawCanvas(-10, top, c16);
+    else    tft.drawCanvas(-10, top, c1, 0xFFFF, 0x001F);
+    sim_sample  after = sim_take();
+    sim_phase_add(phase, &before, &after);
+    for(int16_t yy=top; (yy<top+BENCH_STRIP) && (yy<tft.height()); yy++) {
+      for(int16_t x=0; x<tft.width(); x++) {
+        uint16_t expected = c16 ? c16->getBuffer()[(yy-top) * c16->width() + x + 10] :
+          (c1->getBuffer()[(yy-top) * ((c1->width() + 7) / 8) + (x + 10) / 8] &
+           (0x80 >> ((x + 10) & 7))) ? 0xFFFF : 0x001F;
+        shown &= (tftsim_pixel(x, yy) == expected);
+      }
+    }
+  }
+  return shown;
+}
+
+void bench_bus(void) {
+  static uint16_t row[BENCH_ROW];
+  sim_phase  same, differ, push, ram, flash, flashSwapped, far, canvas16, canvas1;
+  GFXcanvas16 c16(500, BENCH_STRIP);
+  GFXcanvas1  c1(500, BENCH_STRIP);
+  sim_sample before, after;
+  boolean    shown = true;
+
+  sim_phase_init(&same  , "fill, bytes equal");
+  sim_phase_init(&differ, "fill, bytes differ");
+  sim_phase_init(&push  , "pushColors");
+  sim_phase_init(&ram         , "writePixels, RAM");
+  sim_phase_init(&flash       , "  flash");
+  sim_phase_init(&flashSwapped, "  flash, swapped");
+  sim_phase_init(&far         , "  far flash");
+  sim_phase_init(&canvas16    , "drawCanvas, 16-bit");
+  sim_phase_init(&canvas1     , "  1-bit");
+
+  for(int i=0; i<BENCH_FILLS; i++) {
+    before = sim_take();
+    tft.fillScreen((i & 1) ? 0x0000 : 0xFFFF);
+    after  = sim_take();
+    sim_phase_add(&same, &before, &after);
+    before = sim_take();
+    tft.fillScreen((i & 1) ? 0x2966 : 0xF800);
+    after  = sim_take();
+    sim_phase_add(&differ, &before, &after);
+  }
+  for(int i=0; i<BENCH_ROW; i++) row[i] = i * 0x0421;
+  before = sim_take();
+  for(int16_t y=0; y<tft.height(); y++) {
+    tft.setAddrWindow(0, y, tft.width() - 1, y);
+    for(int16_t x=0; x<tft.width(); x+=BENCH_ROW) {
+      tft.pushColors(row, BENCH_ROW, x == 0);
+    }
+  }
+  after = sim_take();
+  sim_phase_add(&push, &before, &after);
+
+  for(long i=0; i<BENCH_PIXELS; i++) {
+    image[i]           = (uint16_t)(i * 40503UL >> 3);
+    swapped[i * 2]     = image[i] >> 8;
+    swapped[i * 2 + 1] = image[i];
+  }
+  shown &= stream(&ram         , image  , 0, false);
+  shown &= stream(&flash       , image  , TFTLCD_PIXELS_PROGMEM, false);
+  shown &= stream(&flashSwapped, swapped,
+    TFTLCD_PIXELS_PROGMEM | TFTLCD_PIXELS_SWAPPED, false);
+  shown &= stream(&far, (const void *)pgm_get_far_address(image), 0, true);
+
+  for(int16_t x=0; x<c16.width(); x++) {
+    c16.drawFastVLine(x, 0, BENCH_STRIP, x * 0x0841);
+  }
+  c1.setCursor(0, 10);
+  c1.setTextColor(1);
+  c1.print("drawCanvas() 1-bit strip, clipped at the left and bottom edges");
+  c1.drawLine(0, 0, c1.width() - 1, BENCH_STRIP - 1, 1);
+  shown &= strips(&canvas16, &c16, NULL);
+  shown &= strips(&canvas1 , NULL, &c1);
+  showMainScreen();
+
+  printf("Bus throughput, %s\n\n",
+#ifdef TFTLCD_NO_BURST_KERNELS
+   "WR_STROBE loops"
+#else
+   "burst kernels"
+#endif
+  );
+  sim_print_header(stdout);
+  report(&same);
+  report(&differ);
+  report(&push);
+  report(&ram);
+  report(&flash);
+  report(&flashSwapped);
+  report(&far);
+  report(&canvas16);
+  report(&canvas1);
+  if(!shown) printf("  ** streamed pixels differ on the panel\n");
+}
@@ -0,0 +1,113 @@
+// Enter, Cancel and the shut-off button behind the multiplexer, each
+// pressed with contact bounce on both edges while loop() runs.  Every
+// press must act exactly once: the shut-off button toggles the display,
+// Enter opens the menu and, on "Show history", the history screen, and
+// Cancel closes it.
+// Enter is then held for a few seconds, which with the old LOW-level
+// interrupts kept the CPU in the ISR; the clock must keep its deadlines.
+
+#include "Arduino.h"
+#include <Scheduler.h>
+#include <MenuTree.h>
+
+#include "bench.h"
+#include "sim_io.h"
+#include "sim_report.h"
+#include "TFTLCD_sim.h"
+#include "HC4051_sim.h"
+
+extern Scheduler scheduler;
+extern MenuTree  menu;
+extern boolean   historyShown;
+
+void turnOnDisplay();
+
+#define BENCH_TOGGLES   10
+#define BENCH_BOUNCES   7    // Extra edges at each press and release
+#define BENCH_BOUNCE_US 300
+#define BENCH_PRESS_MS  150
+#define BENCH_HOLD_MS   3000
+#define BENCH_GAP_MS    400
+#define BENCH_HISTORY   5    // "Show history" in the sketch's mainMenu
+
+#define ENTER   0
+#define CANCEL  1
+#define SHUTOFF 2
+
+static const uint8_t pins[2] = { 18, 19 }; // ENTER/CANCEL_BUTTON_PIN
+#define SHUTOFF_CHANNEL 6                  // SHUTOFF_BUTTON_MUX_INPUT
+
+static struct {
+  uint8_t level;  // Where the line settles
+  uint8_t left;   // Edges still to go
+} lines[3];
+
+static void setLine(uint8_t i, uint8_t level) {
+  if(i == SHUTOFF) muxsim_set(SHUTOFF_CHANNEL, level);
+  else             sim_pin_set(pins[i], level);
+}
+
+static void bounce(void *arg) {
+  uint8_t i = (uint8_t)(uintptr_t)arg;
+  lines[i].left--;
+  setLine(i, (lines[i].left & 1) ? !lines[i].level : lines[i].level);
+  if(lines[i].left) {
+    sim_at(sim_cycles() + BENCH_BOUNCE_US * SIM_CYCLES_PER_US, bounce, arg);
+  }
+}
+
+static void runLoop(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while(millis() < end) {
+    if(!scheduler.run()) sim_advance(SIM_CYCLES_PER_MS);
+  }
+}
+
+static void press(uint8_t i, unsigned long ms) {
+  lines[i].level = LOW;
+  lines[i].left  = BENCH_BOUNCES + 1;
+  bounce((void *)(uintptr_t)i);
+  runLoop(ms);
+  lines[i].level = HIGH;
+  lines[i].left  = BENCH_BOUNCES + 1;
+  bounce((void *)(uintptr_t)i);
+  runLoop(BENCH_GAP_MS);
+}
+
+void bench_buttons(void) {
+  turnOnDisplay();
+  for(Task *t=scheduler.tasks(); t; t=t->next()) t->resetStats();
+  int toggled = 0, history = 0;
+
+  for(int i=0; i<BENCH_TOGGLES; i++) {
+    boolean lit = tftsim_panelLit();
+    press(SHUTOFF, BENCH_PRESS_MS);
+    if(tftsim_panelLit() != lit) toggled++;
+  }
+
+  // The menu opens on the entry it was closed on
+  menu.open();
+  menu.move(BENCH_HISTORY - menu.selection());
+  menu.close();
+  for(int i=0; i<BENCH_TOGGLES / 2; i++) {
+    press(ENTER, BENCH_PRESS_MS);
+    if(menu.shown()) history++;
+    press(ENTER, BENCH_PRESS_MS);
+    if(historyShown) history++;
+    press(CANCEL, BENCH_PRESS_MS);
+    if(!historyShown) history++;
+  }
+  press(ENTER, BENCH_HOLD_MS);
+  boolean held = menu.shown();
+  press(CANCEL, BENCH_PRESS_MS);
+  held &= !menu.shown();
+
+  printf("Buttons, %d edges of bounce %d us apart at each press and release\n\n",
+   BENCH_BOUNCES, BENCH_BOUNCE_US);
+  sim_print_tasks(stdout, &scheduler);
+  printf("\nshut-off presses toggling the display: %d of %d\n", toggled, BENCH_TOGGLES);
+  printf("Enter/Cancel presses acting once: %d of %d\n", history, BENCH_TOGGLES / 2 * 3);
+  if((toggled != BENCH_TOGGLES) || (history != BENCH_TOGGLES / 2 * 3) || !held) {
+    printf("  ** a press was lost or counted twice\n");
+  }
+}
@@ -0,0 +1,58 @@
+// DHT11 readings through the non-blocking API, with the sensor model
+// answering every request, dropping some, or dropping all of them.  For
+// each case: what every attempt returned, how long the whole request took
+// and how much of it was spent in delay(), which is all the time loop()
+// was held up.  The blocking read11() path took the same total with all
+// of it inside delay() and its polling loops.
+//
+// CPU time is not modelled; on the Mega poll() is a few us and each
+// edge() interrupt a few more.
+
+#include "Arduino.h"
+#include <dht.h>
+
+#include "bench.h"
+#include "sim_clock.h"
+#include "DHT11_sim.h"
+
+extern dht DHT;
+
+#define BENCH_ATTEMPTS    6
+#define BENCH_RETRY_DELAY 3000
+
+void bench_dht(void) {
+  static const struct {
+    const char *label;
+    uint8_t     drop;
+  } cases[] = {
+    { "answered"   , 0              },
+    { "2 dropped"  , 2              },
+    { "all dropped", BENCH_ATTEMPTS },
+  };
+
+  printf("DHT11 request(%d, %d) with the sensor at 45 %% / 24 C\n\n",
+   BENCH_ATTEMPTS, BENCH_RETRY_DELAY);
+  printf("%-12s %-24s %10s %10s %8s\n",
+   "sensor", "attempts", "total ms", "delay() ms", "reading");
+  dhtsim_set(45, 24);
+  for(size_t c=0; c<sizeof(cases)/sizeof(cases[0]); c++) {
+    char     results[32] = "";
+    uint64_t start = sim_cycles(), delayed = sim_delay_cycles();
+    DHT.humidity = DHT.temperature = 0;
+    dhtsim_drop(cases[c].drop);
+    DHT.request(BENCH_ATTEMPTS, BENCH_RETRY_DELAY);
+    do {
+      int result = DHT.poll();
+      if(result != DHTLIB_BUSY) {
+        snprintf(results + strlen(results), sizeof(results) - strlen(results),
+         "%s%d", results[0] ? " " : "", result);
+      }
+      sim_advance(SIM_CYCLES_PER_MS);
+    } while(!DHT.ready());
+    printf("%-12s %-24s %10.1f %10.1f %4.0f/%-3.0f\n", cases[c].label, results,
+     (double)(sim_cycles() - start) / SIM_CYCLES_PER_MS,
+     (double)(sim_delay_cycles() - delayed) / SIM_CYCLES_PER_MS,
+     DHT.humidity, DHT.temperature);
+  }
+  dhtsim_drop(0);
+}
@@ -0,0 +1,107 @@
+// Display off and on through the sketch, with the controller put to sleep
+// and woken with its GRAM kept, against what turnOffDisplay() and
+// turnOnDisplay() used to do: paint the screen black, then repaint the
+// main screen on the way back.  The screen must come back as it was and
+// the controller's sleep timing rules must hold.  While the panel sleeps
+// the backlight pin must stay low, whatever else runs meanwhile.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include "bench.h"
+#include "sim_io.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+
+void turnOnDisplay();
+void turnOffDisplay();
+void updateMainScreen();
+void invalidateMainScreen();
+
+#define BENCH_BLACK 0x0000
+#define BENCH_CYCLES 5
+#define BENCH_PWM_PIN 7  // LCD_PWM
+
+static boolean dark = true; // Backlight off all the while the panel slept
+
+// Anything driving the backlight pin high while the panel sleeps
+static void backlightWatch(uint8_t pin) {
+  if(!tftsim_panelLit() && digitalRead(pin)) dark = false;
+}
+
+static void checkDark(void) {
+  if(sim_analog_out(BENCH_PWM_PIN) || digitalRead(BENCH_PWM_PIN)) dark = false;
+}
+
+static uint32_t screenHash(void) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t y=0; y<tft.height(); y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      hash = (hash ^ tftsim_pixel(x, y)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static void measure(sim_phase *phase, void (*fn)(void)) {
+  sim_sample before = sim_take();
+  fn();
+  sim_sample after = sim_take();
+  sim_phase_add(phase, &before, &after);
+}
+
+static void blackFill(void) {
+  tft.fillScreen(BENCH_BLACK);
+  invalidateMainScreen();
+}
+
+void bench_display(void) {
+  sim_phase off, on, quickOn, oldOff, oldOn;
+  sim_phase_init(&off    , "turnOffDisplay");
+  sim_phase_init(&on     , "turnOnDisplay");
+  sim_phase_init(&quickOn, "  on right after off");
+  sim_phase_init(&oldOff , "black fill (before)");
+  sim_phase_init(&oldOn  , "repaint (before)");
+
+  uint32_t      hash       = screenHash();
+  unsigned long violations = tftsim_sleepViolations();
+  boolean       lit        = true, kept = true;
+
+  sim_pin_watch(BENCH_PWM_PIN, backlightWatch);
+  for(int i=0; i<BENCH_CYCLES; i++) {
+    delay(2000);
+    measure(&off, turnOffDisplay);
+    lit &= !tftsim_panelLit();
+    checkDark();
+    delay(2000);
+    checkDark();
+    measure(&on, turnOnDisplay);
+    lit &= tftsim_panelLit();
+    kept &= (screenHash() == hash);
+  }
+  for(int i=0; i<BENCH_CYCLES; i++) {
+    delay(2000);
+    turnOffDisplay();
+    measure(&quickOn, turnOnDisplay);
+    lit &= tftsim_panelLit();
+  }
+  for(int i=0; i<BENCH_CYCLES; i++) {
+    measure(&oldOff, blackFill);
+    measure(&oldOn, updateMainScreen);
+  }
+
+  printf("Display off / on, %d times each\n\n", BENCH_CYCLES);
+  sim_print_header(stdout);
+  sim_print_phase(stdout, &off);
+  sim_print_phase(stdout, &on);
+  sim_print_phase(stdout, &quickOn);
+  sim_print_phase(stdout, &oldOff);
+  sim_print_phase(stdout, &oldOn);
+  if(!lit ) printf("  ** panel not off while asleep or not back on after waking\n");
+  if(!kept) printf("  ** screen differs after waking\n");
+  if(!dark) printf("  ** backlight pin not low while the panel slept\n");
+  printf("\nsleep timing violations: %lu\n",
+   tftsim_sleepViolations() - violations);
+}
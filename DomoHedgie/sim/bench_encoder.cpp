@@ -0,0 +1,88 @@
+// Rotary encoder at full spin speed: bursts of detents one way and then
+// the other, a quarter step every BENCH_QUARTER_US with a contact bounce
+// on every other edge, while loop() runs as usual.  Every detent must
+// reach the menu, in the right direction, and the encoder task's lateness
+// bounds the input latency.
+
+#include "Arduino.h"
+#include <Scheduler.h>
+#include <MenuTree.h>
+
+#include "bench.h"
+#include "sim_io.h"
+#include "sim_report.h"
+
+extern Scheduler scheduler;
+extern MenuTree  menu;
+
+void turnOnDisplay();
+
+#define BENCH_BURSTS     20
+#define BENCH_DETENTS    40  // Per burst
+#define BENCH_QUARTER_US 150 // 1.7 turns a second on a 24-detent encoder
+#define BENCH_PAUSE_MS   500 // Between bursts
+#define BENCH_A_PIN      2   // ROTARY_A_PIN
+#define BENCH_B_PIN      3   // ROTARY_B_PIN
+#define BENCH_MENU_ITEMS 7   // Entries in the sketch's mainMenu
+
+// Clockwise: A leads B
+static const uint8_t gray[4] = { 0, 2, 3, 1 };
+
+static uint8_t phase;     // Index into gray[]
+static int     quarters;  // Still to go in this burst, signed
+static long    turned;    // Detents turned so far, signed
+
+static void setPins(uint8_t s) {
+  sim_pin_set(BENCH_A_PIN, (s & 2) ? HIGH : LOW);
+  sim_pin_set(BENCH_B_PIN, (s & 1) ? HIGH : LOW);
+}
+
+static void quarter(void *arg) {
+  if(!quarters) return;
+  uint8_t from = gray[phase];
+  phase = (quarters > 0) ? (phase + 1) & 3 : (phase - 1) & 3;
+  quarters += (quarters > 0) ? -1 : 1;
+  setPins(gray[phase]);
+  if(phase & 1) {
+    // Contact bounce: back to the previous state and forward again
+    setPins(from);
+    setPins(gray[phase]);
+  }
+  if(quarters) {
+    sim_at(sim_cycles() + BENCH_QUARTER_US * SIM_CYCLES_PER_US, quarter, NULL);
+  }
+}
+
+static void spin(int detents) {
+  quarters = detents * 4;
+  turned  += detents;
+  sim_at(sim_cycles() + BENCH_QUARTER_US * SIM_CYCLES_PER_US, quarter, NULL);
+}
+
+static void runLoop(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while(millis() < end) {
+    if(!scheduler.run()) sim_advance(SIM_CYCLES_PER_MS);
+  }
+}
+
+void bench_encoder(void) {
+  turnOnDisplay();
+  for(Task *t=scheduler.tasks(); t; t=t->next()) t->resetStats();
+  menu.open();
+  int  start  = menu.selection();
+  long missed = 0;
+
+  for(int b=0; b<BENCH_BURSTS; b++) {
+    spin((b & 1) ? -BENCH_DETENTS : BENCH_DETENTS + b);
+    runLoop(BENCH_DETENTS * 4 * BENCH_QUARTER_US / 1000 + BENCH_PAUSE_MS);
+    long expect = ((start + turned) % BENCH_MENU_ITEMS + BENCH_MENU_ITEMS) % BENCH_MENU_ITEMS;
+    if(menu.selection() != expect) missed++;
+  }
+
+  printf("Encoder, %d bursts of %d+ detents at a quarter step every %d us\n\n",
+   BENCH_BURSTS, BENCH_DETENTS, BENCH_QUARTER_US);
+  sim_print_tasks(stdout, &scheduler);
+  printf("\nnet detents turned: %ld\n", turned);
+  if(missed) printf("  ** menu out of step after %ld of %d bursts\n", missed, BENCH_BURSTS);
+}
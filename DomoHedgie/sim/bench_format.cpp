@@ -0,0 +1,74 @@
+// Text formatting without String: the date line and history time stamp
+// as the sketch used to build them (String concatenation) against the
+// TextFormat templates it uses now, over a spread of dates and times.
+// Both must give the same text (the dates start in 2010: the old code
+// printed 2000-2009 as a single digit); the table gives the heap
+// (re)allocations per call of each.
+
+#include "Arduino.h"
+#include "RTClib.h"
+#include <TextFormat.h>
+
+#include "bench.h"
+#include "i18n/DomoHedgie_i18n_en_US.h"
+
+#define BENCH_TIMES 5000
+#define BENCH_START 1262304000UL // 2010-01-01
+
+static String oldDate(const DateTime &now) {
+  String date = "";
+  if(now.day()<10) date.concat("0");
+  date.concat(now.day());
+  date.concat('/');
+  if(now.month()<10) date.concat("0");
+  date.concat(now.month());
+  date.concat('/');
+  date.concat(now.year()-2000);
+  return date;
+}
+
+static String oldTime(const DateTime &now) {
+  String time = "";
+  if(now.hour()<10) time.concat("0");
+  time.concat(now.hour());
+  time.concat(C_HOUR_SEPARATOR);
+  if(now.minute()<10) time.concat("0");
+  time.concat(now.minute());
+  time.concat(' ');
+  return time;
+}
+
+void bench_format(void) {
+  unsigned long dateAllocs = 0, timeAllocs = 0, before;
+  int           differs = 0;
+  char          s[16];
+
+  for(uint32_t i=0; i<BENCH_TIMES; i++) {
+    DateTime now(BENCH_START + i * 86400UL * 7 / 3 + i * 4177UL);
+
+    before = String::allocations();
+    String date = oldDate(now);
+    dateAllocs += String::allocations() - before;
+    formatDateTime(s, sizeof(s), F(S_DATE_FORMAT), now);
+    if(strcmp(s, date.c_str())) differs++;
+
+    before = String::allocations();
+    String time = oldTime(now);
+    timeAllocs += String::allocations() - before;
+    formatDateTime(s, sizeof(s), F(S_HISTORY_TIME_FORMAT), now);
+    if(strcmp(s, time.c_str())) differs++;
+  }
+
+  // Short buffers: 0 bytes left untouched, 1 byte only the NUL
+  DateTime start(BENCH_START);
+  s[0] = 'x';
+  bool shortWrong = formatDateTime(s, 0, F(S_DATE_FORMAT), start) != s || s[0] != 'x';
+  shortWrong |= formatDateTime(s, 1, F(S_DATE_FORMAT), start) != s || s[0];
+
+  printf("Formatting %d dates and times\n\n", BENCH_TIMES);
+  printf("%-24s %14s %14s\n", "allocations per call", "String", "TextFormat");
+  printf("%-24s %14.2f %14d\n", "date (dd/mm/yy)", (double)dateAllocs / BENCH_TIMES, 0);
+  printf("%-24s %14.2f %14d\n", "event time (hh:mm)", (double)timeAllocs / BENCH_TIMES, 0);
+  if(differs) printf("  ** %d texts differ from the String versions\n", differs);
+  if(shortWrong) printf("  ** a 0 or 1 byte buffer was written past its size\n");
+}
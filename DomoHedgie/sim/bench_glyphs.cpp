@@ -0,0 +1,153 @@
+// Custom-font text: a pixel-by-pixel reference renderer (what
+// Adafruit_GFX::drawChar used to do) against the run-based transparent and
+// streamed opaque paths of Adafruit_TFTLCD, for every font/size pair
+// main.cpp uses; then bitmap against RLE glyphs for the fonts converted
+// with fontconvert -r.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include <Fonts/FreeSansBold9pt7b.h>
+#include <Fonts/FreeSansBold24pt7b.h>
+#include <Fonts/FreeMono9pt7b.h>
+#include <Fonts/FreeMono12pt7b.h>
+#include <Fonts/FreeMonoBold12pt7b.h>
+#include <Fonts/FreeMonoBold18pt7b.h>
+#include <Fonts/FreeMonoBold24pt7b.h>
+#include <Fonts/FreeSansBold24pt7bRLE.h>
+#include <Fonts/FreeMonoBold18pt7bRLE.h>
+#include <Fonts/FreeMonoBold24pt7bRLE.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+
+#define BENCH_TEXT "0123456789"
+#define BENCH_FG   0xFFFF
+#define BENCH_BG   0x2966
+
+enum { MODE_PIXEL, MODE_RUNS, MODE_OPAQUE };
+
+static const struct {
+  const char    *name;
+  const GFXfont *font;
+  uint8_t        size;
+} fonts[] = {
+  { "FreeSansBold9pt7b"   , &FreeSansBold9pt7b , 1 },
+  { "FreeSansBold24pt7b x2", &FreeSansBold24pt7b, 2 },
+  { "FreeMono9pt7b"       , &FreeMono9pt7b     , 1 },
+  { "FreeMono12pt7b"      , &FreeMono12pt7b    , 1 },
+  { "FreeMonoBold12pt7b"  , &FreeMonoBold12pt7b, 1 },
+  { "FreeMonoBold18pt7b"  , &FreeMonoBold18pt7b, 1 },
+  { "FreeMonoBold24pt7b"  , &FreeMonoBold24pt7b, 1 },
+};
+
+static const struct {
+  const char    *name;
+  const GFXfont *bitmap, *rle;
+  size_t         bitmapBytes, rleBytes;
+  uint8_t        size;
+} rleFonts[] = {
+  { "FreeSansBold24pt7b x2", &FreeSansBold24pt7b, &FreeSansBold24pt7bRLE,
+    sizeof(FreeSansBold24pt7bBitmaps), sizeof(FreeSansBold24pt7bRLEBitmaps), 2 },
+  { "FreeMonoBold18pt7b"  , &FreeMonoBold18pt7b, &FreeMonoBold18pt7bRLE,
+    sizeof(FreeMonoBold18pt7bBitmaps), sizeof(FreeMonoBold18pt7bRLEBitmaps), 1 },
+  { "FreeMonoBold24pt7b"  , &FreeMonoBold24pt7b, &FreeMonoBold24pt7bRLE,
+    sizeof(FreeMonoBold24pt7bBitmaps), sizeof(FreeMonoBold24pt7bRLEBitmaps), 1 },
+};
+
+// One drawPixel()/fillRect() per lit pixel, bitmap fonts only
+static void drawCharPixels(int16_t x, int16_t y, unsigned char c,
+ uint16_t color, uint8_t size, const GFXfont *font) {
+  const GFXglyph *g  = &font->glyph[c - font->first];
+  const uint8_t  *bm = font->bitmap + g->bitmapOffset;
+  uint8_t         bits = 0, bit = 0;
+  for(uint8_t yy=0; yy<g->height; yy++) {
+    for(uint8_t xx=0; xx<g->width; xx++) {
+      if(!(bit++ & 7)) bits = *bm++;
+      if(bits & 0x80) {
+        if(size == 1) {
+          tft.drawPixel(x + g->xOffset + xx, y + g->yOffset + yy, color);
+        } else {
+          tft.fillRect(x + (g->xOffset + xx) * size,
+           y + (g->yOffset + yy) * size, size, size, color);
+        }
+      }
+      bits <<= 1;
+    }
+  }
+}
+
+// FNV-1a over the visible panel, to check the three paths agree
+static uint32_t screenHash(void) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t y=0; y<tft.height(); y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      hash = (hash ^ tftsim_pixel(x, y)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static uint64_t drawText(const GFXfont *font, uint8_t size, int mode,
+ uint32_t *hash) {
+  const char *s = BENCH_TEXT;
+  int16_t     x = 0, y = font->yAdvance * size;
+  uint16_t    bg = (mode == MODE_OPAQUE) ? BENCH_BG : BENCH_FG;
+
+  tft.fillScreen(BENCH_BG);
+  tft.setFont(font);
+  sim_sample before = sim_take();
+  for(; *s; s++) {
+    const GFXglyph *g = &font->glyph[*s - font->first];
+    if(x + g->xAdvance * size >= tft.width()) {
+      x  = 0;
+      y += font->yAdvance * size;
+    }
+    if(mode == MODE_PIXEL) {
+      drawCharPixels(x, y, *s, BENCH_FG, size, font);
+    } else {
+      tft.drawChar(x, y, *s, BENCH_FG, bg, size);
+    }
+    x += g->xAdvance * size;
+  }
+  sim_sample after = sim_take();
+  *hash = screenHash();
+  return after.cycles - before.cycles;
+}
+
+void bench_glyphs(void) {
+  printf("Glyph rendering, \"%s\", simulated ms per string\n\n", BENCH_TEXT);
+  printf("%-22s %10s %10s %8s %10s %8s %6s\n",
+   "font", "per-pixel", "runs", "speedup", "opaque", "speedup", "pixels");
+  for(size_t i=0; i<sizeof(fonts)/sizeof(fonts[0]); i++) {
+    const GFXfont *f = fonts[i].font;
+    uint8_t        n = fonts[i].size;
+    uint32_t       hPixel, hRuns, hOpaque;
+    double pixel  = (double)drawText(f, n, MODE_PIXEL , &hPixel ) / SIM_CYCLES_PER_MS,
+           runs   = (double)drawText(f, n, MODE_RUNS  , &hRuns  ) / SIM_CYCLES_PER_MS,
+           opaque = (double)drawText(f, n, MODE_OPAQUE, &hOpaque) / SIM_CYCLES_PER_MS;
+    printf("%-22s %10.2f %10.2f %7.1fx %10.2f %7.1fx %6s\n", fonts[i].name,
+     pixel, runs, pixel / runs, opaque, pixel / opaque,
+     ((hRuns == hPixel) && (hOpaque == hPixel)) ? "same" : "DIFF");
+  }
+
+  printf("\nBitmap vs RLE glyphs: glyph data bytes, simulated ms per string\n\n");
+  printf("%-22s %7s %7s %6s %9s %9s %9s %9s %6s\n", "font", "bitmap", "RLE",
+   "saved", "runs", "RLE runs", "opaque", "RLE opq", "pixels");
+  for(size_t i=0; i<sizeof(rleFonts)/sizeof(rleFonts[0]); i++) {
+    uint8_t  n = rleFonts[i].size;
+    uint32_t hRuns, hRleRuns, hOpaque, hRleOpaque;
+    double runs      = (double)drawText(rleFonts[i].bitmap, n, MODE_RUNS  , &hRuns     ) / SIM_CYCLES_PER_MS,
+           rleRuns   = (double)drawText(rleFonts[i].rle   , n, MODE_RUNS  , &hRleRuns  ) / SIM_CYCLES_PER_MS,
+           opaque    = (double)drawText(rleFonts[i].bitmap, n, MODE_OPAQUE, &hOpaque   ) / SIM_CYCLES_PER_MS,
+           rleOpaque = (double)drawText(rleFonts[i].rle   , n, MODE_OPAQUE, &hRleOpaque) / SIM_CYCLES_PER_MS;
+    printf("%-22s %7u %7u %6u %9.2f %9.2f %9.2f %9.2f %6s\n", rleFonts[i].name,
+     (unsigned)rleFonts[i].bitmapBytes, (unsigned)rleFonts[i].rleBytes,
+     (unsigned)(rleFonts[i].bitmapBytes - rleFonts[i].rleBytes),
+     runs, rleRuns, opaque, rleOpaque,
+     ((hRleRuns == hRuns) && (hRleOpaque == hOpaque)) ? "same" : "DIFF");
+  }
+}
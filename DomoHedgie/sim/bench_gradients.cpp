@@ -0,0 +1,127 @@
+// Main screen gradients: the sketch's former paintGradient() (per-line
+// double-precision colour and one drawFastHLine() per line) against
+// Adafruit_TFTLCD::fillGradientRect(), plain and dithered, for both
+// section gradients; then whole section backgrounds, fillRect() plus
+// paintGradient() against a single fillGradientRect().
+//
+// Only bus time is modelled.  On the Mega the old path also ran three
+// soft-float divides and three multiplies per line, which is not counted
+// here; fillGradientRect() does a few 16-bit adds per line.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+
+#define BENCH_WIDTH      480
+#define BENCH_BACKGROUND 0x2966
+#define BENCH_LINES      60
+
+static const struct {
+  const char *name;
+  int16_t     sectionY, sectionEnd, gradientY;
+  uint16_t    color;
+} gradients[] = {
+  { "temperature", 100, 212, 211, 0x8602 },
+  { "light"      , 212, 320, 320, 0xEF5D },
+};
+
+static uint16_t oldGradientColour(int i, int lines, uint16_t initialColour,
+ uint16_t finalColour) {
+  if(i >= lines-1) return finalColour;
+
+  double gradientHeight = (double)lines;
+
+  double ini = ((initialColour >> 11) & 0x1F);
+  double fin = ((finalColour >> 11) & 0x1F);
+  double redLeap = (fin-ini)/gradientHeight;
+
+  ini = ((initialColour >> 5) & 0x3F);
+  fin = ((finalColour >> 5) & 0x3F);
+  double greenLeap = (fin-ini)/gradientHeight;
+
+  ini = (initialColour & 0x1F);
+  fin = (finalColour & 0x1F);
+  double blueLeap = (fin-ini)/gradientHeight;
+
+  int red = ((initialColour >> 11) & 0x1F) + ((int)(redLeap*i));
+  int green = ((initialColour >> 5) & 0x3F) + ((int)(greenLeap*i));
+  int blue = (initialColour & 0x1F) + ((int)(blueLeap*i));
+  return red << 11 | green << 5 | blue;
+}
+
+static void oldPaintGradient(int x, int y, int lines, uint16_t initialColour,
+ uint16_t finalColour) {
+  for(int i=0;i<lines-1;i++){
+    tft.drawFastHLine(x, y-i, BENCH_WIDTH, oldGradientColour(i, lines, initialColour, finalColour));
+  }
+  tft.drawFastHLine(x, y-lines, BENCH_WIDTH, finalColour);
+}
+
+enum { MODE_OLD, MODE_PLAIN, MODE_DITHER, MODE_OLD_SECTION, MODE_SECTION };
+
+static void run(sim_phase *phase, int g, int mode) {
+  int16_t  sectionY = gradients[g].sectionY, end = gradients[g].sectionEnd,
+           gy       = gradients[g].gradientY;
+  uint16_t color    = gradients[g].color;
+
+  sim_sample before = sim_take();
+  switch(mode) {
+    case MODE_OLD:
+      oldPaintGradient(0, gy, BENCH_LINES, color, BENCH_BACKGROUND);
+      break;
+    case MODE_PLAIN:
+    case MODE_DITHER:
+      tft.fillGradientRect(0, gy - BENCH_LINES, BENCH_WIDTH, BENCH_LINES + 1,
+        gy, color, gy - BENCH_LINES, BENCH_BACKGROUND, mode == MODE_DITHER);
+      break;
+    case MODE_OLD_SECTION:
+      tft.fillRect(0, sectionY, BENCH_WIDTH, end - sectionY, BENCH_BACKGROUND);
+      oldPaintGradient(0, gy, BENCH_LINES, color, BENCH_BACKGROUND);
+      break;
+    case MODE_SECTION:
+      tft.fillGradientRect(0, sectionY, BENCH_WIDTH, end - sectionY,
+        gy, color, gy - BENCH_LINES, BENCH_BACKGROUND, true);
+      break;
+  }
+  sim_sample after = sim_take();
+  sim_phase_add(phase, &before, &after);
+}
+
+void bench_gradients(void) {
+  static const struct {
+    const char *label;
+    int         mode;
+  } modes[] = {
+    { "paintGradient"     , MODE_OLD         },
+    { "fillGradientRect"  , MODE_PLAIN       },
+    { "  dithered"        , MODE_DITHER      },
+    { "fillRect+gradient" , MODE_OLD_SECTION },
+    { "fillGradientRect"  , MODE_SECTION     },
+  };
+
+  printf("Main screen gradients (%d lines) and section backgrounds\n",
+   BENCH_LINES);
+  for(size_t g=0; g<sizeof(gradients)/sizeof(gradients[0]); g++) {
+    printf("\n%s\n", gradients[g].name);
+    sim_print_header(stdout);
+    uint64_t cycles[5];
+    for(size_t m=0; m<sizeof(modes)/sizeof(modes[0]); m++) {
+      sim_phase phase;
+      sim_phase_init(&phase, modes[m].label);
+      run(&phase, g, modes[m].mode);
+      sim_print_phase(stdout, &phase);
+      cycles[m] = phase.cycles;
+      if(m == MODE_DITHER) printf("%-22s\n", "section background:");
+    }
+    printf("saved: gradient %lld cycles plain, %lld dithered; "
+     "section %lld cycles\n",
+     (long long)cycles[MODE_OLD] - (long long)cycles[MODE_PLAIN],
+     (long long)cycles[MODE_OLD] - (long long)cycles[MODE_DITHER],
+     (long long)cycles[MODE_OLD_SECTION] - (long long)cycles[MODE_SECTION]);
+  }
+}
@@ -0,0 +1,151 @@
+// History screen: a new temperature reading or event through the sketch's
+// StripChart and TextConsole against drawing the chart or the log again
+// in full, as redrawing a scrolled area in software would.
+//
+// Beforehand, in every rotation the controller can scroll in, a chart or
+// console across the whole screen is filled past its size and the panel
+// (as scrolled) is checked against the same values drawn from scratch.
+// A chart's leftmost column is left out of the comparison: drawn from
+// scratch, its oldest value has no predecessor to be joined to.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+#include <StripChart.h>
+#include <TextConsole.h>
+
+#include "bench.h"
+#include "sim_report.h"
+#include "DomoHedgie_events.h"
+
+extern Adafruit_TFTLCD tft;
+extern StripChart      temperatureChart;
+extern TextConsole     eventConsole;
+
+void showHistoryScreen();
+void hideHistoryScreen();
+void logEvent(uint8_t system, uint8_t code, uint16_t arg, uint32_t value);
+
+#define BENCH_READINGS 300
+#define BENCH_EVENTS   60
+#define BENCH_LINES    40  // Console lines on the full screen, size 1
+#define BENCH_COLUMNS  480
+
+// Main screen sections span these panel lines
+#define SECTIONS_TOP    100
+#define SECTIONS_BOTTOM 320
+
+static uint32_t areaHash(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t yy=y; yy<y+h; yy++) {
+    for(int16_t xx=x; xx<x+w; xx++) {
+      hash = (hash ^ tftsim_pixel(xx, yy)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static int16_t reading(int i) {
+  return 10 + (i * 7) % 23;
+}
+
+static void line(char *s, int i) {
+  sprintf(s, "line %d of the console check", i);
+}
+
+// Chart across the whole screen along the scroll axis
+static boolean checkChart(void) {
+  static int16_t samples[BENCH_COLUMNS];
+  StripChart chart(&tft, samples, BENCH_COLUMNS, 0xFFFF, 0x0000);
+  chart.setRange(10, 35);
+  chart.show(0, 0, tft.width(), tft.height());
+  for(int i=0; i<tft.width()*3/2; i++) chart.add(reading(i));
+  uint32_t hash = areaHash(1, 0, tft.width() - 1, tft.height());
+  chart.show(0, 0, tft.width(), tft.height());
+  chart.hide();
+  return areaHash(1, 0, tft.width() - 1, tft.height()) == hash;
+}
+
+static boolean checkConsole(void) {
+  TextConsole console(&tft, 0xFFFF, 0x0000);
+  int16_t lines = tft.height() / 8, total = lines * 3 / 2, i;
+  char s[48];
+  console.begin(0, 0, tft.width(), tft.height());
+  for(i=0; i<total; i++) { line(s, i); console.println(s); }
+  uint32_t hash = areaHash(0, 0, tft.width(), tft.height());
+  console.begin(0, 0, tft.width(), tft.height());
+  for(i=total-lines; i<total; i++) { line(s, i); console.println(s); }
+  console.end();
+  return areaHash(0, 0, tft.width(), tft.height()) == hash;
+}
+
+static void measure(sim_phase *phase, const sim_sample *before) {
+  sim_sample after = sim_take();
+  sim_phase_add(phase, before, &after);
+}
+
+void bench_history(void) {
+  uint32_t sections = areaHash(0, SECTIONS_TOP, tft.width(), SECTIONS_BOTTOM - SECTIONS_TOP);
+  boolean  scrolled = true;
+  sim_sample before;
+
+  printf("Hardware scroll checks\n\n");
+  for(uint8_t r=0; r<4; r++) {
+    tft.setRotation(r);
+    boolean ok = tft.scrollsAlongX() ? checkChart() : checkConsole();
+    printf("  rotation %d, %-8s %s\n", r, tft.scrollsAlongX() ? "chart" : "console",
+     ok ? "matches a full redraw" : "** differs from a full redraw");
+    scrolled &= ok;
+  }
+  tft.setRotation(3);
+
+  sim_phase show, reading1, chartFull, event, consoleFull, hide;
+  sim_phase_init(&show       , "show history screen");
+  sim_phase_init(&reading1   , "  new reading");
+  sim_phase_init(&chartFull  , "  chart redraw");
+  sim_phase_init(&event      , "  new event");
+  sim_phase_init(&consoleFull, "  log redraw");
+  sim_phase_init(&hide       , "back to main screen");
+
+  before = sim_take();
+  showHistoryScreen();
+  measure(&show, &before);
+  for(int i=0; i<BENCH_READINGS; i++) {
+    before = sim_take();
+    temperatureChart.add(reading(i));
+    measure(&reading1, &before);
+  }
+  uint32_t chart = areaHash(1, 0, 239, tft.height());
+  before = sim_take();
+  temperatureChart.show(0, 0, 240, tft.height());
+  measure(&chartFull, &before);
+  boolean chartKept = (areaHash(1, 0, 239, tft.height()) == chart);
+
+  for(int i=0; i<BENCH_EVENTS; i++) {
+    before = sim_take();
+    logEvent(LOG_HEATER, (i & 1) ? EVENT_HEATER_OFF : EVENT_HEATER_ON, 1, i);
+    measure(&event, &before);
+  }
+  before = sim_take();
+  eventConsole.begin(240, 0, tft.width() - 240, tft.height());
+  for(int i=0; i<BENCH_LINES; i++) eventConsole.println("00:00 Heater on");
+  measure(&consoleFull, &before);
+
+  before = sim_take();
+  hideHistoryScreen();
+  measure(&hide, &before);
+
+  printf("\nHistory screen, %d readings and %d events\n\n", BENCH_READINGS, BENCH_EVENTS);
+  sim_print_header(stdout);
+  sim_print_phase(stdout, &show);
+  sim_print_phase(stdout, &reading1);
+  sim_print_phase(stdout, &chartFull);
+  sim_print_phase(stdout, &event);
+  sim_print_phase(stdout, &consoleFull);
+  sim_print_phase(stdout, &hide);
+  if(!scrolled ) printf("  ** a scroll check failed\n");
+  if(!chartKept) printf("  ** scrolled chart differs from its full redraw\n");
+  if(areaHash(0, SECTIONS_TOP, tft.width(), SECTIONS_BOTTOM - SECTIONS_TOP) != sections) {
+    printf("  ** main screen not restored\n");
+  }
+}
@@ -0,0 +1,132 @@
+// Lines for history graphs: Adafruit_GFX::drawLine() as it was, one
+// drawPixel() (and address window) per point, against the span version
+// that sends each run along the major axis as one drawFastHLine() or
+// drawFastVLine().  A day of temperature readings is drawn as a polyline
+// across the screen, and a fan of lines at every slope from the centre;
+// each must come out pixel for pixel as before.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+void showMainScreen();
+
+#define BENCH_POINTS 480
+#define BENCH_FAN    96
+#define BENCH_COLOR  0xFFE0
+
+#define swap(a, b) { int16_t t = a; a = b; b = t; }
+
+static int16_t xs[BENCH_POINTS], ys[BENCH_POINTS];
+
+static uint32_t screenHash(void) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t y=0; y<tft.height(); y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      hash = (hash ^ tftsim_pixel(x, y)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+// Adafruit_GFX::drawLine() before spans
+static void oldDrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+ uint16_t color) {
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    swap(x0, y0);
+    swap(x1, y1);
+  }
+  if (x0 > x1) {
+    swap(x0, x1);
+    swap(y0, y1);
+  }
+  int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  for (; x0<=x1; x0++) {
+    if (steep) tft.drawPixel(y0, x0, color);
+    else       tft.drawPixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+// Fan end points, round the screen edge
+static void fanEnd(int i, int16_t *x, int16_t *y) {
+  int16_t w = tft.width() - 1, h = tft.height() - 1, side = BENCH_FAN / 4,
+          k = i % side;
+  switch(i / side) {
+    case 0:  *x = w * k / side;       *y = 0;                   break;
+    case 1:  *x = w;                  *y = h * k / side;        break;
+    case 2:  *x = w - w * k / side;   *y = h;                   break;
+    default: *x = 0;                  *y = h - h * k / side;    break;
+  }
+}
+
+static void oldGraph(void) {
+  for(int i=1; i<BENCH_POINTS; i++) {
+    oldDrawLine(xs[i-1], ys[i-1], xs[i], ys[i], BENCH_COLOR);
+  }
+}
+
+static void newGraph(void) {
+  tft.drawPolyline(xs, ys, BENCH_POINTS, BENCH_COLOR);
+}
+
+static void oldFan(void) {
+  int16_t x, y;
+  for(int i=0; i<BENCH_FAN; i++) {
+    fanEnd(i, &x, &y);
+    oldDrawLine(tft.width() / 2, tft.height() / 2, x, y, BENCH_COLOR);
+  }
+}
+
+static void newFan(void) {
+  int16_t x, y;
+  for(int i=0; i<BENCH_FAN; i++) {
+    fanEnd(i, &x, &y);
+    tft.drawLine(tft.width() / 2, tft.height() / 2, x, y, BENCH_COLOR);
+  }
+}
+
+static uint32_t measure(sim_phase *phase, void (*fn)(void)) {
+  tft.fillScreen(0x0000);
+  sim_sample before = sim_take();
+  fn();
+  sim_sample after = sim_take();
+  sim_phase_add(phase, &before, &after);
+  return screenHash();
+}
+
+void bench_lines(void) {
+  sim_phase oldG, newG, oldF, newF;
+  sim_phase_init(&oldG, "graph, per pixel");
+  sim_phase_init(&newG, "graph, spans");
+  sim_phase_init(&oldF, "fan, per pixel");
+  sim_phase_init(&newF, "fan, spans");
+
+  // A slow daily swing with a faster ripple, as the DHT11 would report
+  for(int i=0; i<BENCH_POINTS; i++) {
+    xs[i] = i;
+    ys[i] = 160 - 110 * sin(i * 2 * M_PI / BENCH_POINTS) +
+      12 * sin(i * 0.37) + (i % 7 == 0 ? 20 : 0);
+  }
+  boolean same = (measure(&oldG, oldGraph) == measure(&newG, newGraph));
+  same &= (measure(&oldF, oldFan) == measure(&newF, newFan));
+  showMainScreen();
+
+  printf("Lines, a %d-point polyline and a %d-line fan\n\n", BENCH_POINTS, BENCH_FAN);
+  sim_print_header(stdout);
+  sim_print_phase(stdout, &oldG);
+  sim_print_phase(stdout, &newG);
+  sim_print_phase(stdout, &oldF);
+  sim_print_phase(stdout, &newF);
+  if(!same) printf("  ** spans differ from the per-pixel lines\n");
+}
@@ -0,0 +1,79 @@
+// Logging cost: the sketch's former logMessage() (String concatenation,
+// an RTC read over I2C and a blocking Serial.println() at 9600 baud)
+// against EventLog::log(), for a burst of heater events as handleHeater()
+// would log them.  'blocked' is the time the callers waited, including
+// every drain() call until the records were out; 'bytes' is what went
+// over the serial port.
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "RTClib.h"
+#include <EventLog.h>
+
+#include "bench.h"
+#include "sim_clock.h"
+#include "DomoHedgie_events.h"
+
+extern RTC_PCF8523 rtc;
+extern EventLog    eventLog;
+
+#define BENCH_EVENTS 8
+
+static void oldLogMessage(String systemName, String message) {
+  String log = systemName;
+  DateTime now = rtc.now();
+  log.concat(now.day()); log.concat("/");
+  log.concat(now.month()); log.concat("/");
+  log.concat(now.year()); log.concat(" ");
+
+  log.concat(now.hour()); log.concat(":");
+  log.concat(now.minute()); log.concat(":");
+  log.concat(now.second()); log.concat(";");
+  log.concat(message);
+
+  Serial.println(log);
+}
+
+static void report(const char *label, uint64_t blocked, unsigned long i2c,
+ unsigned long allocations, unsigned long bytes) {
+  printf("%-20s %12.2f %8lu %12lu %8lu\n", label,
+   (double)blocked / SIM_CYCLES_PER_MS, i2c, allocations, bytes);
+}
+
+void bench_log(void) {
+  printf("Logging %d heater events back to back\n\n", BENCH_EVENTS);
+  printf("%-20s %12s %8s %12s %8s\n",
+   "", "blocked ms", "I2C", "allocations", "bytes");
+
+  Serial.flush();
+  uint64_t      start       = sim_cycles();
+  unsigned long i2c         = Wire.transactions(),
+                allocations = String::allocations(),
+                bytes       = Serial.bytesWritten();
+  for(int i=0; i<BENCH_EVENTS; i++) {
+    String message = "";
+    message.concat("AUTO"); message.concat("#");message.concat((i & 1) ? "OFF#" : "ON#");
+    message.concat((float)(i * 60));
+    oldLogMessage("HEATER", message);
+  }
+  report("logMessage", sim_cycles() - start, Wire.transactions() - i2c,
+   String::allocations() - allocations, Serial.bytesWritten() - bytes);
+
+  Serial.flush();
+  start       = sim_cycles();
+  i2c         = Wire.transactions();
+  allocations = String::allocations();
+  bytes       = Serial.bytesWritten();
+  for(int i=0; i<BENCH_EVENTS; i++) {
+    eventLog.log(LOG_HEATER, (i & 1) ? EVENT_HEATER_OFF : EVENT_HEATER_ON, 1, i * 60);
+  }
+  uint64_t blocked = sim_cycles() - start;
+  while(eventLog.pending()) {
+    uint64_t before = sim_cycles();
+    eventLog.drain(Serial);
+    blocked += sim_cycles() - before;
+    sim_advance(SIM_CYCLES_PER_MS);
+  }
+  report("EventLog::log", blocked, Wire.transactions() - i2c,
+   String::allocations() - allocations, Serial.bytesWritten() - bytes);
+}
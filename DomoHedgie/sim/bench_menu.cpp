@@ -0,0 +1,238 @@
+// Menu through the sketch's MenuTree: what one encoder detent costs on the
+// bus against repainting the whole menu, as a renderer without a row
+// cache would, plus submenus, number edits, pages and closing back to the
+// main screen.
+//
+// A list longer than the screen (built here, with numbers whose values
+// change behind the menu's back) is then walked in steps of every size in
+// both directions, and after every step the panel must match the same
+// list painted from scratch.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+#include <MenuTree.h>
+#include <Fonts/FreeMono12pt7b.h>
+#include <Fonts/FreeSansBold9pt7b.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+extern MenuTree        menu;
+extern int             selectedTemp;
+
+void closeMenu();
+boolean getMenuPage(uint8_t id, uint8_t line, char *s, uint8_t size);
+
+#define BENCH_DETENTS  200
+#define BENCH_ITEMS    7   // Entries in the sketch's mainMenu
+#define BENCH_MIN_TEMP 0   // "Set min. temperature"
+#define BENCH_DATE     2   // "Set date/time"
+#define BENCH_HEATING  3   // "Show heating time"
+#define BENCH_PAGE_ID  7   // MENU_HEATING_TIME
+#define BENCH_NO_PAGE  0   // MENU_MIN_TEMPERATURE, a number
+#define BENCH_SHORT    5   // Page line buffer too short for any line
+#define BENCH_STEPS    12  // Edit steps
+#define BENCH_LONG     40  // Entries in the long list
+#define BENCH_WALK     300
+
+// Menu area, under the date and clock
+#define MENU_X 0
+#define MENU_Y 100
+#define MENU_W 480
+#define MENU_H 220
+
+static uint32_t areaHash(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t yy=y; yy<y+h; yy++) {
+    for(int16_t xx=x; xx<x+w; xx++) {
+      hash = (hash ^ tftsim_pixel(xx, yy)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static uint32_t menuHash(void) {
+  return areaHash(MENU_X, MENU_Y, MENU_W, MENU_H);
+}
+
+static void measure(sim_phase *phase, const sim_sample *before) {
+  sim_sample after = sim_take();
+  sim_phase_add(phase, before, &after);
+}
+
+// The long list: every third entry a number, whose value moves when
+// 'drift' does
+static char       longLabels[BENCH_LONG][16];
+static MenuEntry  longEntries[BENCH_LONG];
+static int16_t    drift;
+static const char longTitle[] = "Long list";
+static const MenuNumber longRange = { -999, 999, 1, NULL };
+
+static int16_t longGet(uint8_t id) {
+  return (id == 4) ? id * 10 + drift : id * 10;
+}
+
+static void    longSet(uint8_t id, int16_t value) { }
+static boolean longPage(uint8_t id, uint8_t line, char *s, uint8_t size) { return false; }
+static void    longAction(uint8_t id) { }
+
+static const MenuHandlers longHandlers = { longGet, longSet, longPage, longAction };
+
+// Walks the long list and checks every step against a fresh paint
+static unsigned long walkLongList(void) {
+  MenuTree list(&tft, &FreeMono12pt7b, &FreeSansBold9pt7b, &longHandlers,
+    0xFFFF, 0x2966, 0xED00);
+  MenuList root = { longTitle, longEntries, BENCH_LONG };
+  unsigned long differ = 0;
+
+  for(uint8_t i=0; i<BENCH_LONG; i++) {
+    sprintf(longLabels[i], "Entry %d", i);
+    longEntries[i].label = longLabels[i];
+    longEntries[i].type  = (i % 3) ? MENU_ACTION : MENU_NUMBER;
+    longEntries[i].id    = i;
+    longEntries[i].data  = &longRange;
+  }
+  list.begin(&root, MENU_X, MENU_Y, MENU_W, MENU_H);
+  list.open();
+  for(int i=0; i<BENCH_WALK; i++) {
+    int8_t step = (i % 11) - 5;
+    list.move(step ? step : BENCH_LONG / 2);
+    if(i % 7 == 0) {
+      drift++;
+      list.refresh();
+    }
+    uint32_t hash = menuHash();
+    list.close();
+    list.open();
+    if(menuHash() != hash) differ++;
+  }
+  list.close();
+  return differ;
+}
+
+void bench_menu(void) {
+  uint32_t   sections = menuHash();
+  sim_sample before;
+
+  sim_phase open, detent, full, submenu, editStep, edit, page, pageIdle, back, close;
+  sim_phase_init(&open    , "open menu");
+  sim_phase_init(&detent  , "  one detent");
+  sim_phase_init(&full    , "  full menu repaint");
+  sim_phase_init(&submenu , "  into date/time");
+  sim_phase_init(&editStep, "  edit step");
+  sim_phase_init(&edit    , "  edit start/end");
+  sim_phase_init(&page    , "  heating time page");
+  sim_phase_init(&pageIdle, "  page refresh, same");
+  sim_phase_init(&back    , "  back one level");
+  sim_phase_init(&close   , "close menu");
+
+  before = sim_take();
+  menu.open();
+  measure(&open, &before);
+
+  // Selection round the root list, one detent at a time; the menu must
+  // look as if painted from scratch
+  boolean kept = true, followed = true;
+  int     expect = menu.selection();
+  for(int i=0; i<BENCH_DETENTS; i++) {
+    int8_t d = (i % 20 < 12) ? 1 : -1;
+    before = sim_take();
+    menu.move(d);
+    measure(&detent, &before);
+    expect = ((expect + d) % BENCH_ITEMS + BENCH_ITEMS) % BENCH_ITEMS;
+    followed &= (menu.selection() == expect);
+  }
+  uint32_t hash = menuHash();
+  before = sim_take();
+  menu.close();
+  menu.open();
+  measure(&full, &before);
+  kept &= (menuHash() == hash);
+
+  // Minimum temperature: edited up and kept, then down and dropped
+  menu.move(BENCH_MIN_TEMP - menu.selection());
+  int temp = selectedTemp;
+  before = sim_take();
+  menu.enter();
+  measure(&edit, &before);
+  for(int i=0; i<BENCH_STEPS; i++) {
+    before = sim_take();
+    menu.move((i < BENCH_STEPS - 2) ? ((i & 1) ? -1 : 1) : 1);
+    measure(&editStep, &before);
+  }
+  before = sim_take();
+  menu.enter();
+  measure(&edit, &before);
+  boolean edited = (selectedTemp == temp + 2);
+  menu.enter();
+  menu.move(-1);
+  menu.cancel();
+  edited &= (selectedTemp == temp + 2) && !menu.editing();
+  selectedTemp = temp;
+  menu.refresh();
+
+  // Date/time submenu, and back
+  menu.move(BENCH_DATE - menu.selection());
+  before = sim_take();
+  menu.enter();
+  measure(&submenu, &before);
+  boolean nested = (menu.level() == 1);
+  before = sim_take();
+  menu.cancel();
+  measure(&back, &before);
+  nested &= (menu.level() == 0) && (menu.selection() == BENCH_DATE);
+
+  // Heating time page, refreshed with nothing changed
+  menu.move(BENCH_HEATING - menu.selection());
+  before = sim_take();
+  menu.enter();
+  measure(&page, &before);
+  before = sim_take();
+  menu.refresh();
+  measure(&pageIdle, &before);
+  menu.cancel();
+
+  before = sim_take();
+  menu.cancel();
+  closeMenu();
+  measure(&close, &before);
+  boolean restored = !menu.shown() && (menuHash() == sections);
+
+  // Page lines must keep within the buffer they are given, and entries
+  // that are not pages have none
+  char    line[BENCH_SHORT + 1];
+  boolean bounded = true;
+  for(uint8_t l=0; l<2; l++) {
+    memset(line, 'x', sizeof(line));
+    bounded &= getMenuPage(BENCH_PAGE_ID, l, line, BENCH_SHORT) &&
+               (line[BENCH_SHORT - 1] == 0) && (line[BENCH_SHORT] == 'x');
+  }
+  bounded &= !getMenuPage(BENCH_NO_PAGE, 0, line, sizeof(line));
+
+  unsigned long differ = walkLongList();
+  closeMenu();
+
+  printf("Menu, %d detents round the main menu\n\n", BENCH_DETENTS);
+  sim_print_header(stdout);
+  sim_print_phase(stdout, &open);
+  sim_print_phase(stdout, &detent);
+  sim_print_phase(stdout, &full);
+  sim_print_phase(stdout, &submenu);
+  sim_print_phase(stdout, &edit);
+  sim_print_phase(stdout, &editStep);
+  sim_print_phase(stdout, &page);
+  sim_print_phase(stdout, &pageIdle);
+  sim_print_phase(stdout, &back);
+  sim_print_phase(stdout, &close);
+  printf("\nlong list, %d steps: %lu differ from a fresh paint\n", BENCH_WALK, differ);
+  if(!followed) printf("  ** selection out of step with the detents\n");
+  if(!kept    ) printf("  ** menu differs from a fresh paint\n");
+  if(!edited  ) printf("  ** edit not kept or not dropped\n");
+  if(!nested  ) printf("  ** submenu not entered or left\n");
+  if(pageIdle.bus.strobes) printf("  ** unchanged page repainted\n");
+  if(!restored) printf("  ** main screen not restored\n");
+  if(!bounded ) printf("  ** page line overruns its buffer, or a page for a non-page entry\n");
+  if(differ   ) printf("  ** long list differs from a fresh paint\n");
+}
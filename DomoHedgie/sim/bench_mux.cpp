@@ -0,0 +1,97 @@
+// Multiplexer inputs through the timer-driven scan: each of a series of
+// patterns on the eight channels must show in the snapshot within the
+// debounce time, a glitch shorter than it must not show at all, and the
+// heater must follow its mode switch.  Reports the worst delay from a
+// channel changing to the snapshot following it.
+
+#include "Arduino.h"
+#include <Scheduler.h>
+#include <MuxScanner.h>
+
+#include "bench.h"
+#include "sim_report.h"
+#include "HC4051_sim.h"
+
+extern Scheduler  scheduler;
+extern MuxScanner muxScanner;
+extern int        heaterMode;
+
+#define BENCH_PATTERNS  64
+#define BENCH_WAIT_MS   20   // Longest a change may take to show
+#define BENCH_GLITCH_US 1500
+#define BENCH_HEATER_MS 1100 // HEATER_INTERVAL and some
+
+// Heater mode switch channels and the mode each selects (HEATER_MODE_*)
+static const uint8_t switchModes[3] = { 1, 2, 3 };
+
+static void setChannels(uint8_t levels) {
+  for(uint8_t c=0; c<8; c++) muxsim_set(c, (levels >> c) & 1);
+}
+
+static void runLoop(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while(millis() < end) {
+    if(!scheduler.run()) sim_advance(SIM_CYCLES_PER_MS);
+  }
+}
+
+// Advances time in small steps until the snapshot reads 'levels'; returns
+// the cycles it took, or 0 if it did not within BENCH_WAIT_MS
+static uint64_t follow(uint8_t levels) {
+  uint64_t start = sim_cycles();
+  while(sim_cycles() - start < (uint64_t)BENCH_WAIT_MS * SIM_CYCLES_PER_MS) {
+    sim_advance(10 * SIM_CYCLES_PER_US);
+    if(muxScanner.state() == levels) return sim_cycles() - start;
+  }
+  return 0;
+}
+
+void bench_mux(void) {
+  uint8_t  levels = muxScanner.state(), pattern = 0x5A;
+  uint64_t worst = 0, total = 0;
+  int      followed = 0, glitches = 0, modes = 0;
+
+  for(int i=0; i<BENCH_PATTERNS; i++) {
+    pattern = pattern * 37 + 11;
+    if(pattern == levels) pattern ^= 0x80;
+    levels = pattern;
+    // At a different point of the scan each time
+    sim_advance((i * 37 % 500) * SIM_CYCLES_PER_US);
+    setChannels(levels);
+    uint64_t took = follow(levels);
+    if(took) {
+      followed++;
+      total += took;
+      if(took > worst) worst = took;
+    }
+  }
+
+  // A short glitch on every channel, one at a time
+  for(uint8_t c=0; c<8; c++) {
+    muxsim_set(c, !((levels >> c) & 1));
+    sim_advance(BENCH_GLITCH_US * SIM_CYCLES_PER_US);
+    muxsim_set(c, (levels >> c) & 1);
+    sim_advance((uint64_t)BENCH_WAIT_MS * SIM_CYCLES_PER_MS);
+    if(muxScanner.state() != levels) glitches++;
+  }
+
+  // Heater mode switch to each position, back to AUTO at the end
+  muxScanner.changes();
+  for(int i=3; i>=0; i--) {
+    uint8_t pos = i % 3;
+    setChannels(0xFF & ~(1 << pos));
+    runLoop(BENCH_HEATER_MS);
+    if(heaterMode == switchModes[pos]) modes++;
+  }
+
+  printf("Multiplexer scan, %d patterns on 8 channels\n\n", BENCH_PATTERNS);
+  printf("snapshot following a change: %d of %d, avg %.2f ms, worst %.2f ms\n",
+   followed, BENCH_PATTERNS,
+   followed ? (double)total / followed / SIM_CYCLES_PER_MS : 0.0,
+   (double)worst / SIM_CYCLES_PER_MS);
+  printf("glitches of %d us let through: %d of 8\n", BENCH_GLITCH_US, glitches);
+  printf("heater mode following the switch: %d of 4\n", modes);
+  if((followed != BENCH_PATTERNS) || glitches || (modes != 4)) {
+    printf("  ** the snapshot missed a change or let a glitch through\n");
+  }
+}
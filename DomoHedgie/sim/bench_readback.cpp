@@ -0,0 +1,101 @@
+// Read-back of main screen areas through startReadRect()/readPixels(),
+// and of the whole screen, over 65535 pixels, through readRect(), checked
+// pixel for pixel against the panel, against repainting the whole main
+// screen.  Reading back costs three RAMRD bytes per pixel, so saving
+// what is under an overlay takes longer than drawing it again, and on the
+// dithered sections it does not compress to anything a Mega could keep.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+
+void showMainScreen();
+
+#define BENCH_CHUNK 32 // Pixels read per readPixels() call
+
+static const struct {
+  const char *name;
+  int16_t     x, y, w, h;
+} areas[] = {
+  { "clock band"     ,   0,   0, 480,  40 },
+  { "menu popup"     , 120,  80, 240, 160 },
+  { "notice"         , 160, 140, 160,  40 },
+};
+
+#define NUM_AREAS (sizeof(areas) / sizeof(areas[0]))
+
+static void measure(sim_phase *phase, const sim_sample *before) {
+  sim_sample after = sim_take();
+  sim_phase_add(phase, before, &after);
+}
+
+// Reads the area back and counts the pixels that differ from the panel
+static unsigned long readArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint16_t      chunk[BENCH_CHUNK];
+  uint32_t      left = (uint32_t)w * h, at = 0;
+  unsigned long differ = 0;
+
+  tft.startReadRect(x, y, w, h);
+  while(left) {
+    uint8_t n = (left < BENCH_CHUNK) ? left : BENCH_CHUNK;
+    tft.readPixels(chunk, n);
+    for(uint8_t i=0; i<n; i++, at++) {
+      if(chunk[i] != tftsim_pixel(x + at % w, y + at / w)) differ++;
+    }
+    left -= n;
+  }
+  tft.endReadRect();
+  return differ;
+}
+
+// The whole screen in one readRect()
+static unsigned long readScreen(void) {
+  static uint16_t screen[480 * 320];
+  unsigned long   differ = 0;
+  int16_t         w = tft.width(), h = tft.height();
+
+  memset(screen, 0, sizeof(screen));
+  tft.readRect(0, 0, w, h, screen);
+  for(int16_t y=0; y<h; y++) {
+    for(int16_t x=0; x<w; x++) {
+      if(screen[(uint32_t)y * w + x] != tftsim_pixel(x, y)) differ++;
+    }
+  }
+  return differ;
+}
+
+void bench_readback(void) {
+  unsigned long differ[NUM_AREAS], screenDiffer;
+  sim_phase     read[NUM_AREAS], screen, repaint;
+  sim_sample    before;
+
+  sim_phase_init(&screen , "whole screen");
+  sim_phase_init(&repaint, "main screen repaint");
+  for(uint8_t a=0; a<NUM_AREAS; a++) {
+    sim_phase_init(&read[a], areas[a].name);
+    before = sim_take();
+    differ[a] = readArea(areas[a].x, areas[a].y, areas[a].w, areas[a].h);
+    measure(&read[a], &before);
+  }
+  before = sim_take();
+  screenDiffer = readScreen();
+  measure(&screen, &before);
+  before = sim_take();
+  showMainScreen();
+  measure(&repaint, &before);
+
+  printf("Read-back, main screen\n\n");
+  sim_print_header(stdout);
+  for(uint8_t a=0; a<NUM_AREAS; a++) sim_print_phase(stdout, &read[a]);
+  sim_print_phase(stdout, &screen);
+  sim_print_phase(stdout, &repaint);
+  for(uint8_t a=0; a<NUM_AREAS; a++) {
+    if(differ[a]) printf("  ** %s: %lu pixels read back wrong\n", areas[a].name, differ[a]);
+  }
+  if(screenDiffer) printf("  ** whole screen: %lu pixels read back wrong\n", screenDiffer);
+}
@@ -0,0 +1,104 @@
+// Overlays over the main screen: a popup drawn over part of it and taken
+// away again, with what was under it read back from the controller
+// beforehand and written back through SaveUnder, against repainting the
+// whole main screen as taking a popup away would otherwise need.
+// Restoring must bring the screen back pixel for pixel.  Each area is also tried in
+// a buffer the size a Mega can spare, to see whether it would fit.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+#include <SaveUnder.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+
+void showMainScreen();
+
+#define BENCH_BACKGROUND 0x2966  // TFT_BACKGROUND_COLOR in main.cpp
+#define BENCH_POPUP      0xFFFF
+#define BENCH_BORDER     0x0000
+#define BENCH_BUFFER     65535
+#define BENCH_MEGA       2048    // What the sketch could set aside
+
+static const struct {
+  const char *name;
+  int16_t     x, y, w, h;
+} areas[] = {
+  { "clock band"     ,   0,   0, 480,  40 },
+  { "menu popup"     , 120,  80, 240, 160 },
+  { "notice"         , 160, 140, 160,  40 },
+};
+
+#define NUM_AREAS (sizeof(areas) / sizeof(areas[0]))
+
+static uint8_t buffer[BENCH_BUFFER], megaBuffer[BENCH_MEGA];
+
+static uint32_t screenHash(void) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t y=0; y<tft.height(); y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      hash = (hash ^ tftsim_pixel(x, y)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static void popup(int16_t x, int16_t y, int16_t w, int16_t h) {
+  tft.fillRect(x, y, w, h, BENCH_POPUP);
+  tft.drawRect(x, y, w, h, BENCH_BORDER);
+}
+
+static void measure(sim_phase *phase, const sim_sample *before) {
+  sim_sample after = sim_take();
+  sim_phase_add(phase, before, &after);
+}
+
+void bench_saveunder(void) {
+  SaveUnder  under(&tft, buffer, sizeof(buffer), BENCH_BACKGROUND),
+             mega (&tft, megaBuffer, sizeof(megaBuffer), BENCH_BACKGROUND);
+  uint32_t   hash = screenHash();
+  uint16_t   used[NUM_AREAS];
+  boolean    fits[NUM_AREAS], kept = true, saved = true;
+  sim_phase  save[NUM_AREAS], restore[NUM_AREAS], repaint;
+  sim_sample before;
+
+  sim_phase_init(&repaint, "repaint (before)");
+  for(uint8_t a=0; a<NUM_AREAS; a++) {
+    sim_phase_init(&save[a]   , "save");
+    sim_phase_init(&restore[a], "restore");
+
+    before = sim_take();
+    saved &= under.save(areas[a].x, areas[a].y, areas[a].w, areas[a].h);
+    measure(&save[a], &before);
+    used[a] = under.used();
+    fits[a] = mega.save(areas[a].x, areas[a].y, areas[a].w, areas[a].h);
+
+    popup(areas[a].x, areas[a].y, areas[a].w, areas[a].h);
+    before = sim_take();
+    under.restore();
+    measure(&restore[a], &before);
+    kept &= (screenHash() == hash);
+  }
+  for(uint8_t a=0; a<NUM_AREAS; a++) {
+    popup(areas[a].x, areas[a].y, areas[a].w, areas[a].h);
+    before = sim_take();
+    showMainScreen();
+    measure(&repaint, &before);
+  }
+
+  printf("Save-under, main screen\n\n");
+  sim_print_header(stdout);
+  for(uint8_t a=0; a<NUM_AREAS; a++) {
+    printf("%s, %dx%d: %u bytes (%.2f per pixel)%s\n", areas[a].name,
+     areas[a].w, areas[a].h, used[a], (double)used[a] / (areas[a].w * areas[a].h),
+     fits[a] ? "" : ", too big for a Mega");
+    sim_print_phase(stdout, &save[a]);
+    sim_print_phase(stdout, &restore[a]);
+  }
+  sim_print_phase(stdout, &repaint);
+  if(!saved) printf("  ** an area did not fit the buffer\n");
+  if(!kept ) printf("  ** screen differs after restoring\n");
+}
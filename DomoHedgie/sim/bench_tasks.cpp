@@ -0,0 +1,47 @@
+// Scheduler latency under load: two minutes of loop() with the encoder
+// turned one detent every 1.37 s, so the detents land at every phase of
+// the clock repaints, and a DHT11 reading every minute.  The task table
+// gives the worst-case delay of each subsystem; input latency is the
+// encoder task's period plus its lateness and the display task's, which
+// then moves the menu.
+
+#include "Arduino.h"
+#include <Scheduler.h>
+
+#include "bench.h"
+#include "sim_io.h"
+#include "sim_report.h"
+
+extern Scheduler scheduler;
+
+#define BENCH_SECONDS  120
+#define BENCH_STEP_MS  1370
+#define BENCH_QUARTER_MS 2  // Between the edges of one detent
+#define BENCH_A_PIN    2    // ROTARY_A_PIN
+#define BENCH_B_PIN    3    // ROTARY_B_PIN
+
+// One detent clockwise, a quarter step at a time: A leads B
+static void turn(void *arg) {
+  static const uint8_t gray[4] = { 2, 3, 1, 0 };
+  static uint8_t quarter = 0;
+  uint8_t s = gray[quarter];
+  sim_pin_set(BENCH_A_PIN, (s & 2) ? HIGH : LOW);
+  sim_pin_set(BENCH_B_PIN, (s & 1) ? HIGH : LOW);
+  quarter = (quarter + 1) & 3;
+  uint64_t next = quarter ? BENCH_QUARTER_MS : BENCH_STEP_MS - 3 * BENCH_QUARTER_MS;
+  sim_at(sim_cycles() + next * SIM_CYCLES_PER_MS, turn, NULL);
+}
+
+void bench_tasks(void) {
+  for(Task *t=scheduler.tasks(); t; t=t->next()) t->resetStats();
+  sim_at(sim_cycles() + (uint64_t)BENCH_STEP_MS * SIM_CYCLES_PER_MS, turn, NULL);
+
+  unsigned long end = millis() + BENCH_SECONDS * 1000UL;
+  while(millis() < end) {
+    if(!scheduler.run()) sim_advance(SIM_CYCLES_PER_MS);
+  }
+
+  printf("Scheduler, %d s with an encoder detent every %d ms\n\n",
+   BENCH_SECONDS, BENCH_STEP_MS);
+  sim_print_tasks(stdout, &scheduler);
+}
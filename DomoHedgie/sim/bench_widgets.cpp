@@ -0,0 +1,69 @@
+// Main screen value changes through the TextWidget layer, compared with a
+// full repaint of both sections.  Each partial update is checked against a
+// full repaint showing the same values.
+
+#include "Arduino.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_TFTLCD.h>
+#include <dht.h>
+
+#include "bench.h"
+#include "sim_report.h"
+
+extern Adafruit_TFTLCD tft;
+extern dht     DHT;
+extern boolean tempHumValid, heaterOn;
+extern int     currentLightLevel;
+
+void updateMainScreen();
+void invalidateMainScreen();
+
+// Main screen sections span these panel lines
+#define SECTIONS_TOP    100
+#define SECTIONS_BOTTOM 320
+
+static uint32_t sectionsHash(void) {
+  uint32_t hash = 2166136261UL;
+  for(int16_t y=SECTIONS_TOP; y<SECTIONS_BOTTOM; y++) {
+    for(int16_t x=0; x<tft.width(); x++) {
+      hash = (hash ^ tftsim_pixel(x, y)) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+static void measure(sim_phase *phase, boolean full) {
+  sim_sample before = sim_take();
+  if(full) invalidateMainScreen();
+  updateMainScreen();
+  sim_sample after = sim_take();
+  sim_phase_add(phase, &before, &after);
+}
+
+static void step(const char *name, int temperature, boolean heater, int light) {
+  sim_phase partial, full;
+  sim_phase_init(&partial, name);
+  sim_phase_init(&full   , "  full repaint");
+
+  DHT.temperature   = temperature;
+  tempHumValid      = true;
+  heaterOn          = heater;
+  currentLightLevel = light;
+  measure(&partial, false);
+  uint32_t hash = sectionsHash();
+  measure(&full, true);
+
+  sim_print_phase(stdout, &partial);
+  sim_print_phase(stdout, &full);
+  if(sectionsHash() != hash) printf("  ** partial update differs from full repaint\n");
+}
+
+void bench_widgets(void) {
+  printf("Main screen updates\n\n");
+  sim_print_header(stdout);
+  step("no change"          , 25, false,  25);
+  step("temperature 25 -> 26", 26, false,  25);
+  step("temperature 26 -> 9" ,  9, false,  25);
+  step("heater off -> on"    ,  9, true ,  25);
+  step("light 25 -> 100"     ,  9, true , 100);
+}
@@ -0,0 +1,295 @@
+#include "Arduino.h"
+#include "pins_arduino.h"
+#include "sim_io.h"
+
+volatile uint8_t sim_port[SIM_NUM_PINS];
+volatile uint8_t sim_ddr[SIM_NUM_PINS];
+
+static int analogIn[SIM_NUM_PINS], analogOut[SIM_NUM_PINS];
+
+volatile uint8_t PCICR, PCMSK0, PCMSK1, PCMSK2;
+volatile uint8_t TCCR5A, TCCR5B, TIMSK5;
+volatile uint16_t OCR5A, TCNT5;
+
+static uint64_t cycles = 0, delayCycles = 0;
+
+#define SIM_MAX_EVENTS 16
+
+static struct {
+  uint64_t at;
+  void   (*fn)(void *arg);
+  void    *arg;
+} events[SIM_MAX_EVENTS];
+static uint8_t numEvents = 0;
+
+// Timer 5 compare match A: next match (0: timer off) and its period
+static uint64_t timer5At     = 0;
+static uint32_t timer5Period = 0;
+static uint32_t timer5Cycles(void);
+static void     timer5Match(void);
+
+uint64_t sim_cycles(void) {
+  return cycles;
+}
+
+void sim_at(uint64_t cycle, void (*fn)(void *arg), void *arg) {
+  if(numEvents >= SIM_MAX_EVENTS) abort();
+  events[numEvents].at  = cycle;
+  events[numEvents].fn  = fn;
+  events[numEvents].arg = arg;
+  numEvents++;
+}
+
+void sim_advance(uint64_t n) {
+  uint64_t end = cycles + n;
+  for(;;) {
+    int next = -1;
+    for(int i=0; i<numEvents; i++) {
+      if((events[i].at <= end) &&
+         ((next < 0) || (events[i].at < events[next].at))) next = i;
+    }
+    uint32_t period = timer5Cycles();
+    if(period != timer5Period) {
+      timer5Period = period;
+      timer5At     = period ? cycles + period : 0;
+    }
+    if(timer5At && (timer5At <= end) &&
+       ((next < 0) || (timer5At < events[next].at))) {
+      if(timer5At > cycles) cycles = timer5At;
+      timer5Match();
+      // Matches missed while the handler ran are lost, as on the chip
+      while(timer5At <= cycles) timer5At += period;
+      if(cycles > end) end = cycles;
+      continue;
+    }
+    if(next < 0) break;
+    void (*fn)(void *) = events[next].fn;
+    void  *arg         = events[next].arg;
+    if(events[next].at > cycles) cycles = events[next].at;
+    events[next] = events[--numEvents];
+    fn(arg);
+    if(cycles > end) end = cycles; // The handler itself took time
+  }
+  cycles = end;
+}
+
+uint64_t sim_delay_cycles(void) {
+  return delayCycles;
+}
+
+unsigned long millis(void) {
+  return (unsigned long)(cycles / SIM_CYCLES_PER_MS);
+}
+
+unsigned long micros(void) {
+  return (unsigned long)(cycles / SIM_CYCLES_PER_US);
+}
+
+void delay(unsigned long ms) {
+  uint64_t n = (uint64_t)ms * SIM_CYCLES_PER_MS;
+  delayCycles += n;
+  sim_advance(n);
+}
+
+void delayMicroseconds(unsigned int us) {
+  uint64_t n = (uint64_t)us * SIM_CYCLES_PER_US;
+  delayCycles += n;
+  sim_advance(n);
+}
+
+char *ultoa(unsigned long value, char *s, int radix) {
+  char  tmp[33], *t = tmp;
+  char *p = s;
+  do {
+    uint8_t d = value % radix;
+    *t++  = (d < 10) ? '0' + d : 'a' + d - 10;
+    value /= radix;
+  } while(value);
+  while(t > tmp) *p++ = *--t;
+  *p = 0;
+  return s;
+}
+
+char *ltoa(long value, char *s, int radix) {
+  if((value < 0) && (radix == 10)) {
+    *s = '-';
+    ultoa(-(unsigned long)value, s + 1, radix);
+    return s;
+  }
+  return ultoa((unsigned long)value, s, radix);
+}
+
+char *itoa(int value, char *s, int radix) {
+  if((value < 0) && (radix == 10)) return ltoa(value, s, radix);
+  return ultoa((unsigned int)value, s, radix);
+}
+
+char *utoa(unsigned int value, char *s, int radix) {
+  return ultoa(value, s, radix);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static void (*pinWatch[SIM_NUM_PINS])(uint8_t pin);
+
+void sim_pin_watch(uint8_t pin, void (*fn)(uint8_t pin)) {
+  if(pin < SIM_NUM_PINS) pinWatch[pin] = fn;
+}
+
+bool sim_pin_output(uint8_t pin) {
+  return (pin < SIM_NUM_PINS) && sim_ddr[pin];
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if(pin >= SIM_NUM_PINS) return;
+  sim_ddr[pin] = (mode == OUTPUT);
+  if(mode == INPUT_PULLUP) sim_port[pin] = HIGH;
+  if(pinWatch[pin]) pinWatch[pin](pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if(pin >= SIM_NUM_PINS) return;
+  sim_port[pin] = val ? HIGH : LOW;
+  if(pinWatch[pin]) pinWatch[pin](pin);
+}
+
+int digitalRead(uint8_t pin) {
+  if(pin >= SIM_NUM_PINS) return LOW;
+  return sim_port[pin] & 1;
+}
+
+int analogRead(uint8_t pin) {
+  if(pin >= A0) pin -= A0;
+  return (pin < SIM_NUM_PINS) ? analogIn[pin] : 0;
+}
+
+void analogWrite(uint8_t pin, int val) {
+  if(pin >= SIM_NUM_PINS) return;
+  analogOut[pin] = val;
+  sim_port[pin]  = (val >= 128);
+}
+
+int sim_analog_out(uint8_t pin) {
+  return (pin < SIM_NUM_PINS) ? analogOut[pin] : 0;
+}
+
+void sim_analog_in(uint8_t pin, int value) {
+  if(pin >= A0) pin -= A0;
+  if(pin < SIM_NUM_PINS) analogIn[pin] = value;
+}
+
+// External interrupts of the ATmega2560 (INT0..INT5)
+#define EXTERNAL_NUM_INTERRUPTS 6
+
+static void (*intFunc[EXTERNAL_NUM_INTERRUPTS])(void);
+static int   intMode[EXTERNAL_NUM_INTERRUPTS];
+static uint8_t interruptsEnabled = 1;
+static bool    timer5Pending     = false;
+
+// Runs an interrupt handler as the chip would, with interrupts disabled,
+// then shows pin watchers any port the handler wrote directly
+static void runVector(void (*vector)(void)) {
+  uint8_t before[SIM_NUM_PINS];
+  for(int i=0; i<SIM_NUM_PINS; i++) before[i] = sim_port[i];
+  interruptsEnabled = 0;
+  vector();
+  interruptsEnabled = 1;
+  for(int i=0; i<SIM_NUM_PINS; i++) {
+    if(pinWatch[i] && (sim_port[i] != before[i])) pinWatch[i](i);
+  }
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+  switch(pin) {
+    case 2 : return 0;
+    case 3 : return 1;
+    case 18: return 5;
+    case 19: return 4;
+    case 20: return 3;
+    case 21: return 2;
+  }
+  return NOT_AN_INTERRUPT;
+}
+
+static int interruptToPin(uint8_t interruptNum) {
+  static const uint8_t pins[EXTERNAL_NUM_INTERRUPTS] = { 2, 3, 21, 20, 19, 18 };
+  return (interruptNum < EXTERNAL_NUM_INTERRUPTS) ? pins[interruptNum] : -1;
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+  if(interruptNum >= EXTERNAL_NUM_INTERRUPTS) return;
+  intFunc[interruptNum] = userFunc;
+  intMode[interruptNum] = mode;
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+  if(interruptNum >= EXTERNAL_NUM_INTERRUPTS) return;
+  intFunc[interruptNum] = NULL;
+}
+
+void sim_interrupts(uint8_t enable) {
+  interruptsEnabled = enable;
+  if(enable && timer5Pending) {
+    timer5Pending = false;
+    runVector(TIMER5_COMPA_vect);
+  }
+}
+
+// CTC mode with the compare A interrupt enabled is all that is modelled
+static uint32_t timer5Cycles(void) {
+  static const uint16_t prescaler[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+  if(!TIMER5_COMPA_vect || !(TIMSK5 & _BV(OCIE5A)) ||
+     !(TCCR5B & _BV(WGM52))) return 0;
+  return (uint32_t)prescaler[TCCR5B & 7] * (OCR5A + 1UL);
+}
+
+static void timer5Match(void) {
+  if(interruptsEnabled) runVector(TIMER5_COMPA_vect);
+  else timer5Pending = true;
+}
+
+// Pin change interrupt group and mask bit of each Mega pin that has one
+static bool pinChangeBit(uint8_t pin, uint8_t *group, uint8_t *bit) {
+  static const uint8_t portB[8] = { 53, 52, 51, 50, 10, 11, 12, 13 };
+  for(uint8_t i=0; i<8; i++) {
+    if(portB[i] == pin) { *group = 0; *bit = i; return true; }
+  }
+  switch(pin) {
+    case 0 : *group = 1; *bit = 0; return true; // PE0
+    case 15: *group = 1; *bit = 1; return true; // PJ0
+    case 14: *group = 1; *bit = 2; return true; // PJ1
+  }
+  if((pin >= A8) && (pin < A8 + 8)) { *group = 2; *bit = pin - A8; return true; }
+  return false;
+}
+
+static void pinChange(uint8_t pin) {
+  static void (* const vectors[3])(void) = { PCINT0_vect, PCINT1_vect, PCINT2_vect };
+  static volatile uint8_t * const masks[3] = { &PCMSK0, &PCMSK1, &PCMSK2 };
+  uint8_t group, bit;
+  if(!interruptsEnabled || !pinChangeBit(pin, &group, &bit)) return;
+  if(!(PCICR & _BV(group)) || !(*masks[group] & _BV(bit))) return;
+  if(vectors[group]) runVector(vectors[group]);
+}
+
+void sim_pin_set(uint8_t pin, uint8_t level) {
+  if(pin >= SIM_NUM_PINS) return;
+  uint8_t old = sim_port[pin] & 1;
+  level = level ? HIGH : LOW;
+  sim_port[pin] = level;
+  if(old != level) pinChange(pin);
+
+  int n = digitalPinToInterrupt(pin);
+  if((n == NOT_AN_INTERRUPT) || !intFunc[n] || !interruptsEnabled) return;
+  if(interruptToPin(n) != pin) return;
+  bool fire;
+  switch(intMode[n]) {
+    case CHANGE : fire = (old != level);               break;
+    case RISING : fire = (!old && level);              break;
+    case FALLING: fire = (old && !level);              break;
+    default     : fire = (level == LOW);               break;
+  }
+  if(fire) runVector(intFunc[n]);
+}
@@ -0,0 +1,99 @@
+// Host-side stand-in for the Arduino AVR core, just enough of it to build
+// DomoHedgie and its libraries on Linux.  Time is not wall-clock time: the
+// simulator keeps a 16 MHz cycle counter (see sim_clock.h) that is advanced
+// by the TFT bus model, the I2C/serial models and by delay().
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool     boolean;
+typedef uint8_t  byte;
+typedef uint16_t word;
+
+#include "binary.h"
+#include "avr/pgmspace.h"
+#include "avr/io.h"
+#include "avr/interrupt.h"
+#include "sim_clock.h"
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define NOT_AN_INTERRUPT -1
+
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A8 62
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define lowByte(w)  ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define bitRead(value, bit)  (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)   ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif
+
+#define interrupts()   sim_interrupts(1)
+#define noInterrupts() sim_interrupts(0)
+
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+// avr-libc <stdlib.h> extensions
+char *itoa(int value, char *s, int radix);
+char *ltoa(long value, char *s, int radix);
+char *utoa(unsigned int value, char *s, int radix);
+char *ultoa(unsigned long value, char *s, int radix);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+int  digitalPinToInterrupt(uint8_t pin);
+void sim_interrupts(uint8_t enable);
+
+void setup(void);
+void loop(void);
+
+#include "WString.h"
+#include "HardwareSerial.h"
+#include "pins_arduino.h"
+
+#endif // Arduino_h
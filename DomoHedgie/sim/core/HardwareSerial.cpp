@@ -0,0 +1,44 @@
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+HardwareSerial::HardwareSerial(void) :
+  output(NULL), baud(9600), written(0), busyUntil(0) {
+}
+
+void HardwareSerial::begin(unsigned long b) {
+  baud = b ? b : 9600;
+}
+
+// 8N1 framing: 10 bit times per byte
+uint64_t HardwareSerial::byteCycles(void) const {
+  return (SIM_F_CPU * 10ULL) / baud;
+}
+
+int HardwareSerial::availableForWrite(void) {
+  uint64_t now = sim_cycles();
+  if(busyUntil <= now) return SERIAL_TX_BUFFER_SIZE - 1;
+  uint64_t queued = (busyUntil - now + byteCycles() - 1) / byteCycles();
+  if(queued >= SERIAL_TX_BUFFER_SIZE - 1) return 0;
+  return SERIAL_TX_BUFFER_SIZE - 1 - (int)queued;
+}
+
+void HardwareSerial::flush(void) {
+  uint64_t now = sim_cycles();
+  if(busyUntil > now) sim_advance(busyUntil - now);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  // Block (advance the clock) until there is room in the TX buffer
+  if(!availableForWrite()) {
+    uint64_t now  = sim_cycles(),
+             room = busyUntil - (SERIAL_TX_BUFFER_SIZE - 2) * byteCycles();
+    if(room > now) sim_advance(room - now);
+  }
+  uint64_t now = sim_cycles();
+  if(busyUntil < now) busyUntil = now;
+  busyUntil += byteCycles();
+  written++;
+  if(output) fputc(c, output);
+  return 1;
+}
@@ -0,0 +1,39 @@
+// Serial port model: bytes leave through a 64-byte TX buffer drained at
+// the configured baud rate, so a full buffer blocks the caller for as long
+// as it would on the ATmega2560.  Output is copied to a host stream.
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include <stdio.h>
+
+#include "Print.h"
+
+#define SERIAL_TX_BUFFER_SIZE 64
+
+class HardwareSerial : public Print {
+ public:
+  HardwareSerial(void);
+  void   begin(unsigned long baud);
+  void   end(void) {}
+  int    availableForWrite(void);
+  void   flush(void);
+  size_t write(uint8_t);
+  using Print::write;
+  operator bool() { return true; }
+
+  // Simulator hooks; with no output set the bytes are timed, then dropped
+  void          setOutput(FILE *out) { output = out; }
+  unsigned long bytesWritten(void) const { return written; }
+
+ private:
+  FILE         *output;
+  unsigned long baud, written;
+  uint64_t      busyUntil; // Cycle at which the TX buffer will be empty
+
+  uint64_t byteCycles(void) const;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HardwareSerial_h
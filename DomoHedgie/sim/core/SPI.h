@@ -0,0 +1,9 @@
+// DomoHedgie includes <SPI.h> but drives the TFT over the 8-bit parallel
+// bus, so nothing is needed here.
+
+#ifndef _SPI_H_INCLUDED
+#define _SPI_H_INCLUDED
+
+#include "Arduino.h"
+
+#endif // _SPI_H_INCLUDED
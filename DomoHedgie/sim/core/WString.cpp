@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include "Arduino.h"
+
+static unsigned long stringAllocations = 0;
+
+unsigned long String::allocations(void) {
+  return stringAllocations;
+}
+
+void String::init(void) {
+  buffer   = NULL;
+  capacity = 0;
+  len      = 0;
+}
+
+unsigned char String::reserve(unsigned int size) {
+  if(buffer && capacity >= size) return 1;
+  char *newbuffer = (char *)realloc(buffer, size + 1);
+  if(!newbuffer) return 0;
+  stringAllocations++;
+  if(!buffer) newbuffer[0] = 0;
+  buffer   = newbuffer;
+  capacity = size;
+  return 1;
+}
+
+unsigned char String::append(const char *cstr, unsigned int length) {
+  unsigned int newlen = len + length;
+  if(!cstr) return 0;
+  if(length == 0) return 1;
+  if(!reserve(newlen)) return 0;
+  memcpy(buffer + len, cstr, length);
+  len = newlen;
+  buffer[len] = 0;
+  return 1;
+}
+
+String::String(const char *cstr) {
+  init();
+  if(cstr) append(cstr, strlen(cstr));
+}
+
+String::String(const String &str) {
+  init();
+  append(str.c_str(), str.len);
+}
+
+String::String(const __FlashStringHelper *str) {
+  init();
+  const char *p = reinterpret_cast<const char *>(str);
+  if(p) append(p, strlen(p));
+}
+
+String::String(char c) {
+  init();
+  append(&c, 1);
+}
+
+static void formatLong(char *buf, size_t size, long value, unsigned char base) {
+  if(base == 16)     snprintf(buf, size, "%lx", value);
+  else if(base == 8) snprintf(buf, size, "%lo", value);
+  else               snprintf(buf, size, "%ld", value);
+}
+
+static void formatULong(char *buf, size_t size, unsigned long value,
+ unsigned char base) {
+  if(base == 16)     snprintf(buf, size, "%lx", value);
+  else if(base == 8) snprintf(buf, size, "%lo", value);
+  else               snprintf(buf, size, "%lu", value);
+}
+
+String::String(int value, unsigned char base) {
+  char buf[34];
+  init();
+  formatLong(buf, sizeof(buf), value, base);
+  append(buf, strlen(buf));
+}
+
+String::String(unsigned int value, unsigned char base) {
+  char buf[34];
+  init();
+  formatULong(buf, sizeof(buf), value, base);
+  append(buf, strlen(buf));
+}
+
+String::String(long value, unsigned char base) {
+  char buf[34];
+  init();
+  formatLong(buf, sizeof(buf), value, base);
+  append(buf, strlen(buf));
+}
+
+String::String(unsigned long value, unsigned char base) {
+  char buf[34];
+  init();
+  formatULong(buf, sizeof(buf), value, base);
+  append(buf, strlen(buf));
+}
+
+String::String(float value, unsigned char decimalPlaces) {
+  char buf[40];
+  init();
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, (double)value);
+  append(buf, strlen(buf));
+}
+
+String::String(double value, unsigned char decimalPlaces) {
+  char buf[40];
+  init();
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  append(buf, strlen(buf));
+}
+
+String::~String(void) {
+  free(buffer);
+}
+
+String &String::operator=(const String &rhs) {
+  if(this == &rhs) return *this;
+  len = 0;
+  if(buffer) buffer[0] = 0;
+  append(rhs.c_str(), rhs.len);
+  return *this;
+}
+
+String &String::operator=(const char *cstr) {
+  len = 0;
+  if(buffer) buffer[0] = 0;
+  if(cstr) append(cstr, strlen(cstr));
+  return *this;
+}
+
+unsigned char String::concat(const String &str) {
+  return append(str.c_str(), str.len);
+}
+
+unsigned char String::concat(const char *cstr) {
+  if(!cstr) return 0;
+  return append(cstr, strlen(cstr));
+}
+
+unsigned char String::concat(char c) {
+  return append(&c, 1);
+}
+
+unsigned char String::concat(unsigned char num) {
+  return concat(String((unsigned int)num));
+}
+
+unsigned char String::concat(int num) {
+  return concat(String(num));
+}
+
+unsigned char String::concat(unsigned int num) {
+  return concat(String(num));
+}
+
+unsigned char String::concat(long num) {
+  return concat(String(num));
+}
+
+unsigned char String::concat(unsigned long num) {
+  return concat(String(num));
+}
+
+unsigned char String::concat(float num) {
+  return concat(String(num));
+}
+
+unsigned char String::concat(double num) {
+  return concat(String(num));
+}
+
+unsigned char String::operator==(const String &rhs) const {
+  return (len == rhs.len) && !strcmp(c_str(), rhs.c_str());
+}
+
+char String::charAt(unsigned int index) const {
+  return (index < len) ? buffer[index] : 0;
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize,
+ unsigned int index) const {
+  if(!bufsize || !buf) return;
+  if(index >= len) {
+    buf[0] = 0;
+    return;
+  }
+  unsigned int n = bufsize - 1;
+  if(n > len - index) n = len - index;
+  memcpy(buf, buffer + index, n);
+  buf[n] = 0;
+}
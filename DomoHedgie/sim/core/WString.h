@@ -0,0 +1,67 @@
+// Minimal heap-backed String compatible with the parts of the Arduino API
+// used by DomoHedgie.  Allocations are counted so the simulator can report
+// heap churn per call.
+
+#ifndef String_class_h
+#define String_class_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+class String {
+ public:
+  String(const char *cstr = "");
+  String(const String &str);
+  String(const __FlashStringHelper *str);
+  explicit String(char c);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimalPlaces = 2);
+  explicit String(double value, unsigned char decimalPlaces = 2);
+  ~String(void);
+
+  String &operator=(const String &rhs);
+  String &operator=(const char *cstr);
+
+  unsigned char concat(const String &str);
+  unsigned char concat(const char *cstr);
+  unsigned char concat(char c);
+  unsigned char concat(unsigned char num);
+  unsigned char concat(int num);
+  unsigned char concat(unsigned int num);
+  unsigned char concat(long num);
+  unsigned char concat(unsigned long num);
+  unsigned char concat(float num);
+  unsigned char concat(double num);
+
+  String &operator+=(const String &rhs) { concat(rhs); return *this; }
+  String &operator+=(const char *cstr)  { concat(cstr); return *this; }
+  String &operator+=(char c)            { concat(c); return *this; }
+
+  unsigned char operator==(const String &rhs) const;
+  unsigned char operator!=(const String &rhs) const { return !(*this == rhs); }
+
+  unsigned int length(void) const { return len; }
+  const char  *c_str(void) const { return buffer ? buffer : ""; }
+  char         charAt(unsigned int index) const;
+  void         toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const;
+
+  // Number of heap (re)allocations made by all String objects so far.
+  static unsigned long allocations(void);
+
+ private:
+  char        *buffer;
+  unsigned int capacity;
+  unsigned int len;
+
+  void          init(void);
+  unsigned char reserve(unsigned int size);
+  unsigned char append(const char *cstr, unsigned int length);
+};
+
+#endif // String_class_h
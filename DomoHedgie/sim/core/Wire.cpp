@@ -0,0 +1,180 @@
+#include "Arduino.h"
+#include "Wire.h"
+#include "sim_io.h"
+
+TwoWire Wire;
+
+#define PCF8523_I2C_ADDRESS 0x68
+#define PCF8523_REGISTERS   0x14
+#define PCF8523_CLKOUT      0x0F
+#define PCF8523_CLKOUT_1HZ  6    // COF field, bits 5..3
+
+// PCF8523 register file; the time registers (0x03..0x09) are generated on
+// read from 'epoch' plus elapsed simulated time.
+static uint8_t  rtcRegs[PCF8523_REGISTERS];
+static uint8_t  rtcPointer = 0;
+static uint32_t rtcEpoch   = 1484483690; // 2017-01-15 12:34:50
+static uint64_t rtcEpochCycles = 0;
+static int      clkoutPin = -1;
+static uintptr_t clkoutRun = 0; // Edges of older runs are ignored
+
+static uint8_t bin2bcd(uint8_t v) { return v + 6 * (v / 10); }
+static uint8_t bcd2bin(uint8_t v) { return v - 6 * (v >> 4); }
+
+// Howard Hinnant's civil-from-days / days-from-civil
+static void civil(uint32_t days, int *y, unsigned *m, unsigned *d) {
+  long     z   = (long)days + 719468;
+  long     era = z / 146097;
+  unsigned doe = (unsigned)(z - era * 146097);
+  unsigned yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+  unsigned doy = doe - (365*yoe + yoe/4 - yoe/100);
+  unsigned mp  = (5*doy + 2)/153;
+  *d = doy - (153*mp+2)/5 + 1;
+  *m = mp < 10 ? mp+3 : mp-9;
+  *y = (int)(yoe + era * 400) + (*m <= 2);
+}
+
+static uint32_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  long     era = y / 400;
+  unsigned yoe = (unsigned)(y - era * 400);
+  unsigned doy = (153*(m > 2 ? m-3 : m+9) + 2)/5 + d-1;
+  unsigned doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+  return (uint32_t)(era * 146097 + (long)doe - 719468);
+}
+
+uint32_t sim_rtc_now(void) {
+  return rtcEpoch + (uint32_t)((sim_cycles() - rtcEpochCycles) / SIM_F_CPU);
+}
+
+static void clkoutRestart(void);
+
+void sim_rtc_set(uint32_t unixtime) {
+  rtcEpoch       = unixtime;
+  rtcEpochCycles = sim_cycles();
+  clkoutRestart();
+}
+
+// Half-second steps since the time was set: even ones start a second
+#define HALF_SECOND (SIM_F_CPU / 2)
+
+static void clkoutEdge(void *run) {
+  if((uintptr_t)run != clkoutRun) return;
+  uint64_t step = (sim_cycles() - rtcEpochCycles + HALF_SECOND / 2) / HALF_SECOND;
+  sim_pin_set(clkoutPin, (step & 1) ? HIGH : LOW);
+  sim_at(rtcEpochCycles + (step + 1) * HALF_SECOND, clkoutEdge, run);
+}
+
+static void clkoutRestart(void) {
+  clkoutRun++;
+  if(clkoutPin < 0) return;
+  if(((rtcRegs[PCF8523_CLKOUT] >> 3) & 7) != PCF8523_CLKOUT_1HZ) {
+    sim_pin_set(clkoutPin, HIGH);
+    return;
+  }
+  uint64_t step = (sim_cycles() - rtcEpochCycles) / HALF_SECOND;
+  sim_pin_set(clkoutPin, (step & 1) ? HIGH : LOW);
+  sim_at(rtcEpochCycles + (step + 1) * HALF_SECOND, clkoutEdge, (void *)clkoutRun);
+}
+
+void sim_rtc_clkout(uint8_t pin) {
+  clkoutPin = pin;
+  clkoutRestart();
+}
+
+static void rtcLatchTime(void) {
+  uint32_t t = sim_rtc_now(), days = t / 86400UL, secs = t % 86400UL;
+  int      y;
+  unsigned m, d;
+  civil(days, &y, &m, &d);
+  rtcRegs[0x03] = bin2bcd(secs % 60);
+  rtcRegs[0x04] = bin2bcd((secs / 60) % 60);
+  rtcRegs[0x05] = bin2bcd(secs / 3600);
+  rtcRegs[0x06] = bin2bcd(d);
+  rtcRegs[0x07] = (days + 4) % 7; // 1970-01-01 was a Thursday
+  rtcRegs[0x08] = bin2bcd(m);
+  rtcRegs[0x09] = bin2bcd(y - 2000);
+}
+
+static void rtcStoreTime(void) {
+  uint32_t days = daysFromCivil(2000 + bcd2bin(rtcRegs[0x09]),
+                   bcd2bin(rtcRegs[0x08]), bcd2bin(rtcRegs[0x06]));
+  sim_rtc_set(days * 86400UL + bcd2bin(rtcRegs[0x05]) * 3600UL +
+   bcd2bin(rtcRegs[0x04]) * 60UL + bcd2bin(rtcRegs[0x03] & 0x7F));
+}
+
+TwoWire::TwoWire(void) :
+  txAddress(0), txLength(0), rxLength(0), rxIndex(0),
+  txCount(0), byteCount(0) {
+}
+
+void TwoWire::begin(void) {
+}
+
+// 100 kHz standard mode: start + address byte + data bytes + stop, nine
+// bit times per byte including ACK.
+void TwoWire::charge(uint8_t dataBytes) {
+  uint32_t bits = 2 + 9 * (1 + (uint32_t)dataBytes);
+  sim_advance((uint64_t)bits * SIM_F_CPU / 100000UL);
+  txCount++;
+  byteCount += 1 + dataBytes;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address;
+  txLength  = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if(txLength >= BUFFER_LENGTH) return 0;
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t n = 0;
+  while(quantity--) n += write(*data++);
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(void) {
+  charge(txLength);
+  if(txAddress != PCF8523_I2C_ADDRESS) return 2; // NACK on address
+  if(txLength) {
+    rtcPointer = txBuffer[0];
+    bool timeWritten = false, clkoutWritten = false;
+    for(uint8_t i=1; i<txLength; i++) {
+      uint8_t r = rtcPointer++ % PCF8523_REGISTERS;
+      if((r >= 0x03) && (r <= 0x09)) {
+        if(!timeWritten) rtcLatchTime();
+        timeWritten = true;
+      }
+      if(r == PCF8523_CLKOUT) clkoutWritten = true;
+      rtcRegs[r] = txBuffer[i];
+    }
+    if(timeWritten) rtcStoreTime();
+    else if(clkoutWritten) clkoutRestart();
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  if(quantity > BUFFER_LENGTH) quantity = BUFFER_LENGTH;
+  charge(quantity);
+  rxIndex  = 0;
+  rxLength = 0;
+  if(address != PCF8523_I2C_ADDRESS) return 0;
+  rtcLatchTime();
+  for(uint8_t i=0; i<quantity; i++) {
+    rxBuffer[rxLength++] = rtcRegs[rtcPointer++ % PCF8523_REGISTERS];
+  }
+  return rxLength;
+}
+
+int TwoWire::available(void) {
+  return rxLength - rxIndex;
+}
+
+int TwoWire::read(void) {
+  return (rxIndex < rxLength) ? rxBuffer[rxIndex++] : -1;
+}
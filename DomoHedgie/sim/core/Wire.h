@@ -0,0 +1,57 @@
+// I2C bus model with a PCF8523 real-time clock attached at 0x68.  Each
+// transfer advances the simulated clock by its 100 kHz wire time, so the
+// cost of RTC reads shows up in the simulator's timings.
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_LENGTH 32
+
+class TwoWire {
+ public:
+  TwoWire(void);
+  void    begin(void);
+  void    beginTransmission(uint8_t address);
+  void    beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  uint8_t endTransmission(void);
+  uint8_t endTransmission(uint8_t sendStop) { (void)sendStop; return endTransmission(); }
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+  uint8_t requestFrom(int address, int quantity) {
+    return requestFrom((uint8_t)address, (uint8_t)quantity);
+  }
+  size_t  write(uint8_t data);
+  size_t  write(const uint8_t *data, size_t quantity);
+  size_t  write(unsigned long n) { return write((uint8_t)n); }
+  size_t  write(long n)          { return write((uint8_t)n); }
+  size_t  write(unsigned int n)  { return write((uint8_t)n); }
+  size_t  write(int n)           { return write((uint8_t)n); }
+  int     available(void);
+  int     read(void);
+
+  // Simulator hooks
+  unsigned long transactions(void) const { return txCount; }
+  unsigned long bytes(void) const        { return byteCount; }
+
+ private:
+  uint8_t       txAddress, txBuffer[BUFFER_LENGTH], txLength,
+                rxBuffer[BUFFER_LENGTH], rxLength, rxIndex;
+  unsigned long txCount, byteCount;
+
+  void charge(uint8_t dataBytes);
+};
+
+extern TwoWire Wire;
+
+// Sets the PCF8523 model's time (seconds since 1970-01-01, no TZ)
+void     sim_rtc_set(uint32_t unixtime);
+uint32_t sim_rtc_now(void);
+
+// Wires the PCF8523's CLKOUT to 'pin'.  In the 1 Hz mode the model drives
+// it low at the start of every second and high half way through, with
+// sim_pin_set(); other modes leave the line released (high).
+void     sim_rtc_clkout(uint8_t pin);
+
+#endif // TwoWire_h
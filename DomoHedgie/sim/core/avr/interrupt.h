@@ -0,0 +1,22 @@
+// Interrupt vectors on the host are ordinary functions with C linkage.
+// ISR(PCINT1_vect) { ... } in the sketch defines PCINT1_vect(), which the
+// mock core calls when an enabled pin of that group changes (and
+// TIMER5_COMPA_vect on every compare match of timer 5); vectors the
+// sketch does not define are weak and left NULL.
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+#define ISR(vector, ...) extern "C" void vector(void)
+
+extern "C" {
+  void PCINT0_vect(void) __attribute__((weak));
+  void PCINT1_vect(void) __attribute__((weak));
+  void PCINT2_vect(void) __attribute__((weak));
+  void TIMER5_COMPA_vect(void) __attribute__((weak));
+}
+
+#define sei() sim_interrupts(1)
+#define cli() sim_interrupts(0)
+
+#endif // _AVR_INTERRUPT_H_
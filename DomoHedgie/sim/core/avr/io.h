@@ -0,0 +1,52 @@
+// The few ATmega2560 registers the sketch touches directly: pin change
+// interrupt control and masks, and timer 5.  They are plain variables
+// here; the mock core reads them when a simulated pin changes (see
+// sim_pin_set()) and as time advances (timer 5 in CTC mode only).
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t PCICR, PCMSK0, PCMSK1, PCMSK2;
+
+extern volatile uint8_t  TCCR5A, TCCR5B, TIMSK5;
+extern volatile uint16_t OCR5A, TCNT5;
+
+#define CS50   0
+#define CS51   1
+#define CS52   2
+#define WGM52  3
+#define OCIE5A 1
+
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+
+// PCINTn is bit (n % 8) of PCMSK(n / 8)
+#define PCINT0  0
+#define PCINT1  1
+#define PCINT2  2
+#define PCINT3  3
+#define PCINT4  4
+#define PCINT5  5
+#define PCINT6  6
+#define PCINT7  7
+#define PCINT8  0
+#define PCINT9  1
+#define PCINT10 2
+#define PCINT11 3
+#define PCINT12 4
+#define PCINT13 5
+#define PCINT14 6
+#define PCINT15 7
+#define PCINT16 0
+#define PCINT17 1
+#define PCINT18 2
+#define PCINT19 3
+#define PCINT20 4
+#define PCINT21 5
+#define PCINT22 6
+#define PCINT23 7
+
+#endif // _AVR_IO_H_
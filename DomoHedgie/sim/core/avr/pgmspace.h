@@ -0,0 +1,29 @@
+// On the host, flash and RAM share one address space, so the PROGMEM
+// accessors collapse to plain loads.
+
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P  const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t  *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+
+// Far flash addresses are plain host addresses
+typedef uintptr_t uint_farptr_t;
+#define pgm_get_far_address(var)  ((uint_farptr_t)&(var))
+#define pgm_read_byte_far(addr)   pgm_read_byte(addr)
+#define pgm_read_word_far(addr)   pgm_read_word(addr)
+
+#define memcpy_P  memcpy
+#define strcpy_P  strcpy
+#define strncpy_P strncpy
+#define strlen_P  strlen
+#define strcmp_P  strcmp
+
+#endif // __PGMSPACE_H_
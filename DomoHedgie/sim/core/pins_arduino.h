@@ -0,0 +1,21 @@
+// Every simulated pin is its own one-bit "port", so code that caches port
+// registers and bitmasks (Adafruit_TFTLCD, direct port access in the
+// sketch) reads and writes the same state as digitalRead()/digitalWrite().
+
+#ifndef Pins_Arduino_h
+#define Pins_Arduino_h
+
+#include <stdint.h>
+
+#define SIM_NUM_PINS 70
+
+extern volatile uint8_t sim_port[SIM_NUM_PINS];
+extern volatile uint8_t sim_ddr[SIM_NUM_PINS];
+
+#define digitalPinToPort(P)    (P)
+#define digitalPinToBitMask(P) (1)
+#define portOutputRegister(P)  (&sim_port[P])
+#define portInputRegister(P)   (&sim_port[P])
+#define portModeRegister(P)    (&sim_ddr[P])
+
+#endif // Pins_Arduino_h
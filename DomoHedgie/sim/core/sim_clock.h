@@ -0,0 +1,27 @@
+// Simulated ATmega2560 time base.  Everything that would take time on the
+// real board (bus strobes, I2C bytes, serial bytes, delay()) advances this
+// counter; millis()/micros() are derived from it.
+
+#ifndef sim_clock_h
+#define sim_clock_h
+
+#include <stdint.h>
+
+#define SIM_F_CPU 16000000UL
+
+#define SIM_CYCLES_PER_MS (SIM_F_CPU / 1000UL)
+#define SIM_CYCLES_PER_US (SIM_F_CPU / 1000000UL)
+
+uint64_t sim_cycles(void);
+void     sim_advance(uint64_t cycles);
+
+// Time spent in delay()/delayMicroseconds() (included in sim_cycles()).
+uint64_t sim_delay_cycles(void);
+
+// Calls fn(arg) once the counter reaches 'cycle', from inside whatever
+// sim_advance() crosses it, with the counter set to exactly that cycle:
+// the way an external device would raise an interrupt in the middle of
+// a delay() or a bus transfer.  Events may schedule further events.
+void     sim_at(uint64_t cycle, void (*fn)(void *arg), void *arg);
+
+#endif // sim_clock_h
@@ -0,0 +1,30 @@
+// Stimulus side of the simulated pins: lets the host driver (or a device
+// model) change an input level and fire whatever interrupt the sketch has
+// attached to it.
+
+#ifndef sim_io_h
+#define sim_io_h
+
+#include <stdint.h>
+
+// Drives 'pin' to 'level' as an external device would, firing the
+// attachInterrupt() handler for that pin if its mode matches the edge,
+// and the pin change vector of its group if enabled in PCICR/PCMSKn.
+void sim_pin_set(uint8_t pin, uint8_t level);
+
+// Calls fn(pin) after every pinMode()/digitalWrite() the sketch does on
+// 'pin', and after any interrupt handler that changed it through its port
+// register, so a device model can follow what the MCU drives (one watcher
+// per pin).
+void sim_pin_watch(uint8_t pin, void (*fn)(uint8_t pin));
+
+// Whether the MCU currently drives 'pin' as an output.
+bool sim_pin_output(uint8_t pin);
+
+// Last value written with analogWrite() (0 if never written).
+int  sim_analog_out(uint8_t pin);
+
+// Value returned by analogRead() for 'pin'.
+void sim_analog_in(uint8_t pin, int value);
+
+#endif // sim_io_h
@@ -0,0 +1,7 @@
+#ifndef WiringPrivate_h
+#define WiringPrivate_h
+
+#include "Arduino.h"
+#include "pins_arduino.h"
+
+#endif // WiringPrivate_h
@@ -0,0 +1,179 @@
+// Headless DomoHedgie: runs the real sketch (src/main.cpp) against the
+// mock core and the TFT bus model and reports what each rendering entry
+// point pushes over the LCD bus.
+//
+//   domohedgie_sim [-s seconds] [-o screen.ppm] [-l serial.log]
+//   domohedgie_sim -b <benchmark>
+//
+// Phases reported:
+//   setup              setup(), including display init and the first paint
+//   updateMainScreen   one extra repaint of the main screen
+//   updateScreenClock  loop() for 'seconds' of simulated time; only calls
+//                      that touched the bus are counted
+// followed by the scheduler's per-task statistics for the loop() run.
+//
+// Benchmarks (see bench.h) run after setup() instead of the phases above.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "TFTLCD_sim.h"
+#include "DHT11_sim.h"
+#include "HC4051_sim.h"
+#include "sim_io.h"
+#include "sim_report.h"
+#include "bench.h"
+
+void updateMainScreen();
+
+extern Scheduler scheduler;
+
+static const struct {
+  const char *name;
+  void      (*run)(void);
+} benchmarks[] = {
+  { "bus"      , bench_bus       },
+  { "buttons"  , bench_buttons   },
+  { "dht"      , bench_dht       },
+  { "display"  , bench_display   },
+  { "encoder"  , bench_encoder   },
+  { "format"   , bench_format    },
+  { "glyphs"   , bench_glyphs    },
+  { "gradients", bench_gradients },
+  { "history"  , bench_history   },
+  { "lines"    , bench_lines     },
+  { "log"      , bench_log       },
+  { "menu"     , bench_menu      },
+  { "mux"      , bench_mux       },
+  { "readback" , bench_readback  },
+  { "saveunder", bench_saveunder },
+  { "tasks"    , bench_tasks     },
+  { "widgets"  , bench_widgets   },
+};
+
+#define NUM_BENCHMARKS (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+   "usage: %s [-s seconds] [-o screen.ppm] [-l serial.log] [-b benchmark]\n"
+   "benchmarks:", argv0);
+  for(size_t i=0; i<NUM_BENCHMARKS; i++) {
+    fprintf(stderr, " %s", benchmarks[i].name);
+  }
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  unsigned long seconds = 60;
+  const char   *ppm = NULL, *serialLog = NULL;
+  void        (*bench)(void) = NULL;
+
+  for(int i=1; i<argc; i++) {
+    if(!strcmp(argv[i], "-s") && (i+1 < argc)) {
+      seconds = strtoul(argv[++i], NULL, 10);
+    } else if(!strcmp(argv[i], "-o") && (i+1 < argc)) {
+      ppm = argv[++i];
+    } else if(!strcmp(argv[i], "-l") && (i+1 < argc)) {
+      serialLog = argv[++i];
+    } else if(!strcmp(argv[i], "-b") && (i+1 < argc)) {
+      const char *name = argv[++i];
+      for(size_t b=0; b<NUM_BENCHMARKS; b++) {
+        if(!strcmp(name, benchmarks[b].name)) bench = benchmarks[b].run;
+      }
+      if(!bench) usage(argv[0]);
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  FILE *log = NULL;
+  if(serialLog) {
+    if(!(log = fopen(serialLog, "w"))) {
+      perror(serialLog);
+      return 1;
+    }
+    Serial.setOutput(log);
+  }
+
+  // DHT11 on the sketch's TEMP_HUM_DIGITAL_SENSOR_PIN
+  dhtsim_attach(15);
+  dhtsim_set(45, 24);
+
+  // PCF8523 CLKOUT on the sketch's CLOCK_CLKOUT_PIN
+  sim_rtc_clkout(A8);
+
+  // Mode switches and shut-off button on the sketch's multiplexer (S0 on 35,
+  // S1-S2 on 8-9, Z on 10), with the heater switch at AUTO (channel 0)
+  muxsim_attach(35, 8, 9, 10);
+  muxsim_set(0, LOW);
+
+  // Enter and Cancel buttons on 18 and 19, released (pulled up)
+  sim_pin_set(18, HIGH);
+  sim_pin_set(19, HIGH);
+
+  sim_phase  setupPhase, mainPhase, clockPhase;
+  sim_sample before, after;
+  sim_phase_init(&setupPhase, "setup");
+  sim_phase_init(&mainPhase , "updateMainScreen");
+  sim_phase_init(&clockPhase, "updateScreenClock");
+
+  before = sim_take();
+  setup();
+  after  = sim_take();
+  sim_phase_add(&setupPhase, &before, &after);
+  unsigned long setupAllocations = String::allocations();
+
+  if(bench) {
+    bench();
+    if(ppm && !tftsim_dumpPPM(ppm)) {
+      perror(ppm);
+      return 1;
+    }
+    return 0;
+  }
+
+  before = sim_take();
+  updateMainScreen();
+  after  = sim_take();
+  sim_phase_add(&mainPhase, &before, &after);
+
+  // Idle passes through loop() cost nothing in the model, so step the
+  // clock 1 ms at a time between them.
+  unsigned long end = millis() + seconds * 1000UL;
+  while(millis() < end) {
+    before = sim_take();
+    loop();
+    after  = sim_take();
+    if(after.bus.strobes != before.bus.strobes) {
+      sim_phase_add(&clockPhase, &before, &after);
+    } else {
+      sim_advance(SIM_CYCLES_PER_MS);
+    }
+  }
+
+  fprintf(stdout, "DomoHedgie host simulation, %lu s simulated, "
+   "F_CPU %lu Hz\n\n", seconds, (unsigned long)SIM_F_CPU);
+  sim_print_header(stdout);
+  sim_print_phase(stdout, &setupPhase);
+  sim_print_phase(stdout, &mainPhase);
+  sim_print_phase(stdout, &clockPhase);
+  fprintf(stdout, "\nI2C: %lu transactions, %lu bytes; "
+   "serial: %lu bytes; delay(): %.1f ms; DHT11 frames: %lu\n",
+   Wire.transactions(), Wire.bytes(), Serial.bytesWritten(),
+   (double)sim_delay_cycles() / SIM_CYCLES_PER_MS, dhtsim_frames());
+  fprintf(stdout, "String allocations: %lu in setup(), %lu since\n",
+   setupAllocations, String::allocations() - setupAllocations);
+  fprintf(stdout, "\n");
+  sim_print_tasks(stdout, &scheduler);
+
+  if(ppm && !tftsim_dumpPPM(ppm)) {
+    perror(ppm);
+    return 1;
+  }
+  if(log) fclose(log);
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include "sim_report.h"
+
+sim_sample sim_take(void) {
+  sim_sample s;
+  s.bus    = *tftsim_getStats();
+  s.cycles = sim_cycles();
+  return s;
+}
+
+void sim_phase_init(sim_phase *p, const char *name) {
+  memset(p, 0, sizeof(*p));
+  p->name = name;
+}
+
+void sim_phase_add(sim_phase *p, const sim_sample *before, const sim_sample *after) {
+  p->calls++;
+  p->bus.commands  += after->bus.commands  - before->bus.commands;
+  p->bus.caset     += after->bus.caset     - before->bus.caset;
+  p->bus.paset     += after->bus.paset     - before->bus.paset;
+  p->bus.ramwr     += after->bus.ramwr     - before->bus.ramwr;
+  p->bus.ramrd     += after->bus.ramrd     - before->bus.ramrd;
+  p->bus.dataBytes += after->bus.dataBytes - before->bus.dataBytes;
+  p->bus.pixels    += after->bus.pixels    - before->bus.pixels;
+  p->bus.readBytes += after->bus.readBytes - before->bus.readBytes;
+  p->bus.strobes   += after->bus.strobes   - before->bus.strobes;
+  p->bus.busCycles += after->bus.busCycles - before->bus.busCycles;
+  p->cycles        += after->cycles        - before->cycles;
+}
+
+void sim_print_header(FILE *out) {
+  fprintf(out, "%-22s %6s %9s %8s %8s %11s %10s %11s %10s %10s %10s\n",
+   "phase", "calls", "commands", "CASET", "RAMWR", "data bytes",
+   "pixels", "strobes", "bus ms", "total ms", "ms/call");
+}
+
+void sim_print_phase(FILE *out, const sim_phase *p) {
+  double busMs   = (double)p->bus.busCycles / SIM_CYCLES_PER_MS,
+         totalMs = (double)p->cycles        / SIM_CYCLES_PER_MS;
+  fprintf(out, "%-22s %6lu %9lu %8lu %8lu %11lu %10lu %11lu %10.2f %10.2f %10.3f\n",
+   p->name, p->calls, p->bus.commands, p->bus.caset, p->bus.ramwr,
+   p->bus.dataBytes, p->bus.pixels, p->bus.strobes, busMs, totalMs,
+   p->calls ? totalMs / p->calls : 0.0);
+}
+
+void sim_print_tasks(FILE *out, const Scheduler *scheduler) {
+  fprintf(out, "%-16s %7s %8s %7s %7s %9s %9s %11s %11s\n",
+   "task", "period", "runs", "missed", "late", "max late", "deadline",
+   "max run us", "avg run us");
+  for(Task *t=scheduler->tasks(); t; t=t->next()) {
+    const TaskStats &s = t->stats();
+    fprintf(out, "%-16s %7lu %8lu %7lu %7lu %9lu %9lu %11lu %11lu\n",
+     t->name(), t->period(), s.runs, s.missed, s.lateRuns, s.maxLateness,
+     t->deadline(), s.maxRunTime, s.runs ? s.totalRunTime / s.runs : 0);
+  }
+}
@@ -0,0 +1,36 @@
+// Measurement helpers for the simulator: take a sample before and after
+// a piece of sketch code and print the difference as one table row.
+
+#ifndef _SIM_REPORT_H_
+#define _SIM_REPORT_H_
+
+#include "Arduino.h"
+#include "TFTLCD_sim.h"
+#include <Scheduler.h>
+
+typedef struct {
+  tftsim_stats bus;
+  uint64_t     cycles;
+} sim_sample;
+
+sim_sample sim_take(void);
+
+// Accumulated difference between pairs of samples
+typedef struct {
+  const char   *name;
+  unsigned long calls;
+  tftsim_stats  bus;
+  uint64_t      cycles;
+} sim_phase;
+
+void sim_phase_init(sim_phase *p, const char *name);
+void sim_phase_add(sim_phase *p, const sim_sample *before, const sim_sample *after);
+
+void sim_print_header(FILE *out);
+void sim_print_phase(FILE *out, const sim_phase *p);
+
+// One row per task of 'scheduler' with its TaskStats.  Run times only
+// include what the model charges (bus, I2C, serial and delay() time).
+void sim_print_tasks(FILE *out, const Scheduler *scheduler);
+
+#endif // _SIM_REPORT_H_
@@ -0,0 +1,25 @@
+// Subsystems and event codes of the DomoHedgie event log (lib/EventLog).
+// Shared with tools/logdecode, which turns them back into the text lines
+// the sketch used to print; keep both in step when adding events.
+
+#ifndef _DOMOHEDGIE_EVENTS_H_
+#define _DOMOHEDGIE_EVENTS_H_
+
+// Subsystems (0 is EVENT_LOG_SYSTEM)
+#define LOG_HEATER   1
+#define LOG_TEMP_HUM 2
+#define LOG_RTC      3
+
+// LOG_HEATER: arg = heater mode (HEATER_MODE_*), value = seconds on so far
+#define EVENT_HEATER_ON  1
+#define EVENT_HEATER_OFF 2
+
+// LOG_TEMP_HUM: no payload
+#define EVENT_TEMP_HUM_TIMEOUT   1
+#define EVENT_TEMP_HUM_CHECKSUM  2
+#define EVENT_TEMP_HUM_SAFE_MODE 3
+
+// LOG_RTC: value = time before the change; the record's time is the new one
+#define EVENT_RTC_ADJUSTED 1
+
+#endif // _DOMOHEDGIE_EVENTS_H_
@@ -8,5 +8,29 @@
 #define S_MAIN_SCREEN_LIGHT_LIGHTING "Lighting:"
 #define S_MAIN_SCREEN_LIGHT_THRESHOLD "Threshold:"
 #define S_MAIN_SCREEN_LIGHT_CURRENT_LIGHT "Current light level"
+#define S_HISTORY_HEATER_ON "Heater on"
+#define S_HISTORY_HEATER_OFF "Heater off"
+#define S_HISTORY_TEMP_HUM_TIMEOUT "Sensor timeout"
+#define S_HISTORY_TEMP_HUM_CHECKSUM "Sensor checksum error"
+#define S_HISTORY_TEMP_HUM_SAFE_MODE "Heater safe mode"
+#define S_HISTORY_RTC_ADJUSTED "Clock set"
+#define S_MENU_TITLE "Menu"
+#define S_MENU_MIN_TEMPERATURE "Set min. temperature"
+#define S_MENU_LIGHT_INTENSITY "Set light intensity"
+#define S_MENU_DATE_TIME "Set date/time"
+#define S_MENU_YEAR "Year"
+#define S_MENU_MONTH "Month"
+#define S_MENU_DAY "Day"
+#define S_MENU_HOUR "Hour"
+#define S_MENU_MINUTE "Minute"
+#define S_MENU_HEATING_TIME "Show heating time"
+#define S_MENU_LIGHTING_TIME "Show lighting time"
+#define S_MENU_SHOW_HISTORY "Show history"
+#define S_MENU_TURN_OFF_DISPLAY "Turn off display"
+#define S_MENU_PAGE_TOTAL "Total: "
+#define S_MENU_PAGE_NOT_TRACKED "Not tracked yet"
+#define S_MENU_UNIT_CELSIUS "C"
+#define S_MENU_UNIT_PERCENT "%"
 #define C_HOUR_SEPARATOR ':'
-#define C_DATE_SEPARATOR '/'
+#define S_DATE_FORMAT "%d/%m/%y"
+#define S_HISTORY_TIME_FORMAT "%H:%M "
@@ -8,5 +8,29 @@
 #define S_MAIN_SCREEN_LIGHT_LIGHTING "Iluminacion:"
 #define S_MAIN_SCREEN_LIGHT_THRESHOLD "Umbral:"
 #define S_MAIN_SCREEN_LIGHT_CURRENT_LIGHT "Nivel de luz actual"
+#define S_HISTORY_HEATER_ON "Calentador encendido"
+#define S_HISTORY_HEATER_OFF "Calentador apagado"
+#define S_HISTORY_TEMP_HUM_TIMEOUT "Sensor sin respuesta"
+#define S_HISTORY_TEMP_HUM_CHECKSUM "Error de suma del sensor"
+#define S_HISTORY_TEMP_HUM_SAFE_MODE "Calentador en modo seguro"
+#define S_HISTORY_RTC_ADJUSTED "Hora ajustada"
+#define S_MENU_TITLE "Menu"
+#define S_MENU_MIN_TEMPERATURE "Temp. minima"
+#define S_MENU_LIGHT_INTENSITY "Intensidad de luz"
+#define S_MENU_DATE_TIME "Fecha y hora"
+#define S_MENU_YEAR "Anio"
+#define S_MENU_MONTH "Mes"
+#define S_MENU_DAY "Dia"
+#define S_MENU_HOUR "Hora"
+#define S_MENU_MINUTE "Minuto"
+#define S_MENU_HEATING_TIME "Tiempo de calefaccion"
+#define S_MENU_LIGHTING_TIME "Tiempo de iluminacion"
+#define S_MENU_SHOW_HISTORY "Ver historial"
+#define S_MENU_TURN_OFF_DISPLAY "Apagar pantalla"
+#define S_MENU_PAGE_TOTAL "Total: "
+#define S_MENU_PAGE_NOT_TRACKED "Sin medir todavia"
+#define S_MENU_UNIT_CELSIUS "C"
+#define S_MENU_UNIT_PERCENT "%"
 #define C_HOUR_SEPARATOR ':'
-#define C_DATE_SEPARATOR '/'
+#define S_DATE_FORMAT "%d/%m/%y"
+#define S_HISTORY_TIME_FORMAT "%H:%M "
@@ -15,23 +15,36 @@
 #include "Arduino.h"
 
 #include <dht.h>
+#include <Scheduler.h>
+#include <EventLog.h>
 
 #include <Wire.h>
 #include "RTClib.h"
+#include <RtcTime.h>
+#include <RotaryEncoder.h>
+#include <Buttons.h>
+#include <MuxScanner.h>
 
 #include <SPI.h>
 #include <Adafruit_GFX.h>    // Core graphics library
 #include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include <TextWidget.h>
+#include <TextLabel.h>
+#include <TextConsole.h>
+#include <StripChart.h>
+#include <TextFormat.h>
+#include <MenuTree.h>
 
 #include <Fonts/FreeSansBold9pt7b.h>
-#include <Fonts/FreeSansBold24pt7b.h>
+#include <Fonts/FreeSansBold24pt7bRLE.h>
 #include <Fonts/FreeMono9pt7b.h>
 #include <Fonts/FreeMono12pt7b.h>
 #include <Fonts/FreeMonoBold12pt7b.h>
-#include <Fonts/FreeMonoBold18pt7b.h>
-#include <Fonts/FreeMonoBold24pt7b.h>
+#include <Fonts/FreeMonoBold18pt7bRLE.h>
+#include <Fonts/FreeMonoBold24pt7bRLE.h>
 
 #include "i18n/DomoHedgie_i18n_en_US.h"
+#include "DomoHedgie_events.h"
 
 /**
 * ANALOG PINS
@@ -50,10 +63,9 @@
 #define LED_LOW_TEMPERATURE_PIN 5 //PWM Pin
 #define LED_LIGHT_ON_PIN 6 //PWM Pin
 
-#define MULTIPLEXER_S0_PIN 7
+#define MULTIPLEXER_S0_PIN 35 //Was 7, shared with LCD_PWM: rewire S0 to 35
 #define MULTIPLEXER_S1_PIN 8
 #define MULTIPLEXER_S2_PIN 9
-const int MULTIPLEXER_S_PINS[] = {MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIPLEXER_S2_PIN};
 #define MULTIPLEXER_Z_PIN 10
 
 #define HEATER_RELAY_PIN 11
@@ -67,8 +79,9 @@ const int MULTIPLEXER_S_PINS[] = {MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIP
 
 #define CLOCK_SDA_PIN 20
 #define CLOCK_SCL_PIN 21
+#define CLOCK_CLKOUT_PIN A8 //PCF8523 CLKOUT, 1 Hz. PCINT16
 
-#define LCD_PWM 7
+#define LCD_PWM 7 //PWM Pin
 #define LCD_CS 30 // Chip Select
 #define LCD_CD 31 // Command/Data
 #define LCD_WR 32 // LCD Write
@@ -78,7 +91,6 @@ const int MULTIPLEXER_S_PINS[] = {MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIP
 /**
 * MULTIPLEXER INPUTS
 **/
-#define MULTIPLEXER_INPUT_NUM 3
 #define HEATER_MODE_SWITCH_AUTO_MUX_INPUT 0
 #define HEATER_MODE_SWITCH_OFF_MUX_INPUT 1
 #define HEATER_MODE_SWITCH_ON_MUX_INPUT 2
@@ -89,20 +101,24 @@ const int MULTIPLEXER_S_PINS[] = {MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIP
 
 #define SHUTOFF_BUTTON_MUX_INPUT 6
 
-/**
-* SYSTEM NAMES
-**/
+#define HEATER_MODE_SWITCH_INPUTS (_BV(HEATER_MODE_SWITCH_AUTO_MUX_INPUT) | \
+  _BV(HEATER_MODE_SWITCH_OFF_MUX_INPUT) | _BV(HEATER_MODE_SWITCH_ON_MUX_INPUT))
 
-#define HEATER_SYSTEM_NAME "HEATER"
-#define TEMP_HUM_SYSTEM_NAME "TEMP/HUM"
-#define RTC_SYSTEM_NAME "RTC"
+//Timer 5 steps the multiplexer one input at a time in the background; all
+//eight inputs are read every 2 ms and debounced over 4 passes.
+#define MULTIPLEXER_SCAN_US 250
+MuxScanner muxScanner;
 
 /**
 * LOG VARIABLES
 **/
-#define INFO_MESSAGE 1
-#define WARNING_MESSAGE 2
-#define ERROR_MESSAGE 3
+
+//Events are queued as binary records and sent by the log drain task; see
+//DomoHedgie_events.h and tools/logdecode.
+#define LOG_DRAIN_INTERVAL 10
+uint32_t logTime();
+EventLog eventLog(logTime);
+void logEvent(uint8_t system, uint8_t code, uint16_t arg = 0, uint32_t value = 0);
 
 /**
 * TEMPERATURE VARIABLES
@@ -111,10 +127,13 @@ const int MULTIPLEXER_S_PINS[] = {MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIP
 //I.A.W. the DHT11 datasheet, the minimum interval between reading is 1000ms
 //so the value of TEMP_HUM_READING_INTERVAL must be greater or equal to 1000 ms
 #define TEMP_HUM_READING_INTERVAL 60000
-#define MIN_TEMP_HUM_READING_INTERVAL 1000
+#define TEMP_HUM_POLL_INTERVAL 5
 #define MEASUREMENT_ATTEMPTS 5
+#define MEASUREMENT_RETRY_DELAY 3000
 dht DHT;
-long lastTempLectureMillis;
+//Until the first good reading, and after a request whose attempts all
+//failed, DHT.temperature is not to be trusted: the heater stays off
+boolean tempHumValid = false;
 
 /**
 * DATETIME VARIABLES
@@ -131,44 +150,55 @@ struct Datetime{
 };
 
 RTC_PCF8523 rtc;
+RtcTime rtcTime(&rtc); //Current time, kept in RAM
+#define RTC_POLL_INTERVAL 10
 
 /**
-* MENU VARIABLES
+* BUTTONS VARIABLES
 **/
 
-struct MenuItem{
-  int id;
-  String name;
-};
+//Button ids in the Buttons library
+#define ENTER_BUTTON 0
+#define CANCEL_BUTTON 1
+#define SHUTOFF_BUTTON 2
+
+#define BUTTONS_INTERVAL 5 //Debouncer tick
+#define BUTTONS_DEADLINE 20
 
-const int mainMenuDimension = 6;
-MenuItem mainMenu[mainMenuDimension];
-int menuIndex;
+Buttons buttons;
 
 /**
-* BUTTONS VARIABLES
+* ROTARY ENCODER VARIABLES
 **/
 
-#define PUSHED false
-#define NOT_PUSHED true
-#define WATCH_BUTTON true
-#define IGNORE_BUTTON false
-#define BUTTON_WAIT_INTERVAL 6000 //microseconds
+RotaryEncoder encoder;
 
-unsigned long previousMicros = 0;
-boolean loopPrevState = NOT_PUSHED;
-volatile boolean previousButtonState = NOT_PUSHED;
-volatile boolean debouncedButtonState = NOT_PUSHED;
-volatile boolean bounceState = false;
+#define ROTARY_INTERVAL 1
+#define ROTARY_DEADLINE 10
 
 /**
-* ROTARY ENCODER VARIABLES
+* INPUT VARIABLES
 **/
 
-static boolean rotating=false;
-bool rotaryFlag = false;
+//The encoder and buttons tasks only queue what they take in; the display
+//task then acts on it, in the order it came, and does the repainting
+#define INPUT_ENCODER 0 //Detents in 'detents'
+#define INPUT_ENTER 1
+#define INPUT_CANCEL 2
+#define INPUT_SHUTOFF 3
+#define INPUT_QUEUE_SIZE 8 //A power of 2
+
+struct InputEvent{
+  uint8_t type;
+  int8_t detents;
+};
+
+InputEvent inputQueue[INPUT_QUEUE_SIZE];
+uint8_t inputHead = 0, inputTail = 0;
+
+#define DISPLAY_DEADLINE 20
 
-#define ROTARY_DELAY 2
+void queueInput(uint8_t type, int8_t detents = 0);
 
 /**
 * HEATER VARIABLES
@@ -191,7 +221,16 @@ float heaterTotalSeconds;
 #define HEATER_SAFE_MODE_DAYTIME_ON 1800000
 #define HEATER_SAFE_MODE_DAYTIME_OFF 7200000
 int heaterMode;
-long millisSafeMode;
+unsigned long millisSafeMode;
+#define HEATER_INTERVAL 1000
+
+void turnOffHeater();
+
+/**
+* LIGHT VARIABLES
+**/
+
+int lightIntensity = 100; //Optional white LED, in %
 
 /**
 * GRAPHIC VARIABLES
@@ -219,7 +258,7 @@ Adafruit_TFTLCD tft(LCD_CS, LCD_CD, LCD_WR, LCD_RD, LCD_RESET);
 #define TFT_WHITE 0xFFFF
 #define TFT_BLACK 0x0000
 //CLOCK
-uint32_t targetTime = 0;
+#define CLOCK_DEADLINE 50
 uint8_t hh = 23, mm = 59, ss = 50;//TEMP TIME
 byte omm = 99, ohh = 99;
 int xClockPos =280;
@@ -230,81 +269,245 @@ int textXOffset = 3;
 uint8_t fillRectPlus = 3;
 uint8_t charWidth = 24;
 uint8_t charHeight = 31;
+// Two-digit clock field, rendered off screen and sent in one window
+GFXcanvas1 clockCanvas(fillRectPlus+charWidth*2, charHeight);
+
+//MAIN SCREEN
+#define TEMP_SECTION_Y 100
+#define TEMP_SECTION_HEIGHT 111
+#define LIGHT_SECTION_Y 212
+#define SECTION_GRADIENT_LINES 60
+
+boolean mainScreenPainted = false;
+int currentLightLevel = 25; //TODO Get actual current light
+
+//Values shown on the main screen. Only the ones that change are repainted.
+TextWidget temperatureModeWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget heaterStateWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget setTemperatureWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget currentTemperatureWidget(&tft, &FreeSansBold24pt7bRLE, 2, TFT_WHITE, TEXT_WIDGET_ALIGN_CENTER);
+TextWidget lightModeWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget lightingStateWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget lightThresholdWidget(&tft, &FreeMonoBold12pt7b, 1, TFT_WHITE);
+TextWidget currentLightWidget(&tft, &FreeSansBold24pt7bRLE, 2, TFT_WHITE, TEXT_WIDGET_ALIGN_CENTER);
+TextWidget currentLightUnitWidget(&tft, &FreeSansBold24pt7bRLE, 1, TFT_WHITE);
+
+//Static labels of the main screen, in the language picked by the i18n
+//header. Their bounds are measured once, on first use.
+TextLabel temperatureTitleLabel(S_MAIN_SCREEN_TEMPERATURE, &FreeSansBold9pt7b);
+TextLabel temperatureModeLabel(S_MAIN_SCREEN_TEMPERATURE_MODE, &FreeMono12pt7b);
+TextLabel heaterLabel(S_MAIN_SCREEN_TEMPERATURE_HEATER, &FreeMono12pt7b);
+TextLabel setTemperatureLabel(S_MAIN_SCREEN_TEMPERATURE_SET_TEMP, &FreeMono12pt7b);
+TextLabel currentTemperatureLabel(S_MAIN_SCREEN_TEMPERATURE_CURRENT_TEMP, &FreeMono9pt7b);
+TextLabel lightTitleLabel(S_MAIN_SCREEN_LIGHT, &FreeSansBold9pt7b);
+TextLabel lightModeLabel(S_MAIN_SCREEN_LIGHT_MODE, &FreeMono12pt7b);
+TextLabel lightingLabel(S_MAIN_SCREEN_LIGHT_LIGHTING, &FreeMono12pt7b);
+TextLabel lightThresholdLabel(S_MAIN_SCREEN_LIGHT_THRESHOLD, &FreeMono12pt7b);
+TextLabel currentLightLabel(S_MAIN_SCREEN_LIGHT_CURRENT_LIGHT, &FreeMono9pt7b);
+
+//HISTORY SCREEN
+//Temperature chart on the left, one DHT11 reading per column, running the
+//full height so the controller can scroll it; event log on the right
+#define HISTORY_CHART_WIDTH 240
+#define HISTORY_CHART_MIN_TEMP 10
+#define HISTORY_CHART_MAX_TEMP 35
+#define HISTORY_LINE_LENGTH 40
+
+boolean historyShown = false;
+int16_t temperatureHistory[HISTORY_CHART_WIDTH];
+StripChart temperatureChart(&tft, temperatureHistory, HISTORY_CHART_WIDTH, TFT_TEMP_OK, TFT_BLACK);
+TextConsole eventConsole(&tft, TFT_WHITE, TFT_BLACK);
+
+void invalidateMainScreen();
+
+/**
+* MENU VARIABLES
+**/
+
+//Entry ids, passed to the menu handlers
+#define MENU_MIN_TEMPERATURE 0
+#define MENU_LIGHT_INTENSITY 1
+#define MENU_YEAR 2
+#define MENU_MONTH 3
+#define MENU_DAY 4
+#define MENU_HOUR 5
+#define MENU_MINUTE 6
+#define MENU_HEATING_TIME 7
+#define MENU_LIGHTING_TIME 8
+#define MENU_SHOW_HISTORY 9
+#define MENU_TURN_OFF_DISPLAY 10
+
+//The whole menu tree lives in flash; see the MenuTree library
+const char menuTitle[] PROGMEM = S_MENU_TITLE;
+const char menuMinTemperature[] PROGMEM = S_MENU_MIN_TEMPERATURE;
+const char menuLightIntensity[] PROGMEM = S_MENU_LIGHT_INTENSITY;
+const char menuDateTime[] PROGMEM = S_MENU_DATE_TIME;
+const char menuYear[] PROGMEM = S_MENU_YEAR;
+const char menuMonth[] PROGMEM = S_MENU_MONTH;
+const char menuDay[] PROGMEM = S_MENU_DAY;
+const char menuHour[] PROGMEM = S_MENU_HOUR;
+const char menuMinute[] PROGMEM = S_MENU_MINUTE;
+const char menuHeatingTime[] PROGMEM = S_MENU_HEATING_TIME;
+const char menuLightingTime[] PROGMEM = S_MENU_LIGHTING_TIME;
+const char menuShowHistory[] PROGMEM = S_MENU_SHOW_HISTORY;
+const char menuTurnOffDisplay[] PROGMEM = S_MENU_TURN_OFF_DISPLAY;
+const char menuCelsius[] PROGMEM = S_MENU_UNIT_CELSIUS;
+const char menuPercent[] PROGMEM = S_MENU_UNIT_PERCENT;
+
+const MenuNumber menuTemperatureRange PROGMEM = {MIN_TEMP_ALLOWED, MAX_TEMP_ALLOWED, 1, menuCelsius};
+const MenuNumber menuIntensityRange PROGMEM = {0, 100, 5, menuPercent};
+const MenuNumber menuYearRange PROGMEM = {2000, 2099, 1, NULL};
+const MenuNumber menuMonthRange PROGMEM = {1, 12, 1, NULL};
+const MenuNumber menuDayRange PROGMEM = {1, 31, 1, NULL}; //Clamped to the month when set
+const MenuNumber menuHourRange PROGMEM = {0, 23, 1, NULL};
+const MenuNumber menuMinuteRange PROGMEM = {0, 59, 1, NULL};
+
+const MenuEntry dateTimeMenuEntries[] PROGMEM = {
+  {menuYear, MENU_NUMBER, MENU_YEAR, &menuYearRange},
+  {menuMonth, MENU_NUMBER, MENU_MONTH, &menuMonthRange},
+  {menuDay, MENU_NUMBER, MENU_DAY, &menuDayRange},
+  {menuHour, MENU_NUMBER, MENU_HOUR, &menuHourRange},
+  {menuMinute, MENU_NUMBER, MENU_MINUTE, &menuMinuteRange}
+};
+const MenuList dateTimeMenu PROGMEM = MENU_LIST(menuDateTime, dateTimeMenuEntries);
+
+const MenuEntry mainMenuEntries[] PROGMEM = {
+  {menuMinTemperature, MENU_NUMBER, MENU_MIN_TEMPERATURE, &menuTemperatureRange},
+  {menuLightIntensity, MENU_NUMBER, MENU_LIGHT_INTENSITY, &menuIntensityRange},
+  {menuDateTime, MENU_SUBMENU, 0, &dateTimeMenu},
+  {menuHeatingTime, MENU_PAGE, MENU_HEATING_TIME, NULL},
+  {menuLightingTime, MENU_PAGE, MENU_LIGHTING_TIME, NULL},
+  {menuShowHistory, MENU_ACTION, MENU_SHOW_HISTORY, NULL},
+  {menuTurnOffDisplay, MENU_ACTION, MENU_TURN_OFF_DISPLAY, NULL}
+};
+const MenuList mainMenu PROGMEM = MENU_LIST(menuTitle, mainMenuEntries);
+
+int16_t getMenuValue(uint8_t id);
+void setMenuValue(uint8_t id, int16_t value);
+boolean getMenuPage(uint8_t id, uint8_t line, char *s, uint8_t size);
+void runMenuAction(uint8_t id);
+const MenuHandlers menuHandlers = {getMenuValue, setMenuValue, getMenuPage, runMenuAction};
+
+//Covers the main screen sections, under the date and clock
+MenuTree menu(&tft, &FreeMono12pt7b, &FreeSansBold9pt7b, &menuHandlers, TFT_WHITE, TFT_BACKGROUND_COLOR, TFT_SEPATATOR_BAR);
+
+/**
+* SCHEDULER VARIABLES
+**/
+
+void handleRotaryEncoder();
+void handleButtons();
+void handleDisplay();
+void requestTempHum();
+void handleTempHumSensor();
+void handleHeater();
+void updateScreenClock();
+void handleRTC();
+void drainLog();
+
+//Everything loop() does runs from these tasks, in this order of priority.
+//Periods and deadlines are in ms; see each subsystem's variables.
+Scheduler scheduler;
+Task rotaryTask("encoder", handleRotaryEncoder, ROTARY_INTERVAL, ROTARY_DEADLINE);
+Task buttonsTask("buttons", handleButtons, BUTTONS_INTERVAL, BUTTONS_DEADLINE);
+Task displayTask("display", handleDisplay, 0, DISPLAY_DEADLINE);
+Task tempHumPollTask("DHT11 poll", handleTempHumSensor, TEMP_HUM_POLL_INTERVAL);
+Task tempHumRequestTask("DHT11 request", requestTempHum, TEMP_HUM_READING_INTERVAL);
+Task heaterTask("heater", handleHeater, HEATER_INTERVAL);
+Task rtcTask("rtc", handleRTC, RTC_POLL_INTERVAL);
+Task clockTask("clock", updateScreenClock, 0, CLOCK_DEADLINE);
+Task logTask("log drain", drainLog, LOG_DRAIN_INTERVAL);
 
 /**
 * DATETIME METHODS
 **/
 
+/**
+* Current date and time, from the copy kept in RAM (no I2C traffic).
+*/
 Datetime getDateTime(){
   Datetime myTime;
-  DateTime rtcTime = rtc.now();
-  myTime.day = rtcTime.day();
-  myTime.month = rtcTime.month();
-  myTime.year = rtcTime.year();
-  myTime.hour = rtcTime.hour();
-  myTime.minute = rtcTime.minute();
-  myTime.second = rtcTime.second();
+  DateTime now = rtcTime.now();
+  myTime.day = now.day();
+  myTime.month = now.month();
+  myTime.year = now.year();
+  myTime.hour = now.hour();
+  myTime.minute = now.minute();
+  myTime.second = now.second();
 
   return myTime;
 }
 
-String datetimeToString(Datetime date){
-  String s = "";
-  if(date.day>=1 && date.day<=9) s.concat("0");
-  s.concat(date.day);
-  s.concat("/");
-  if(date.month>=1 && date.month<=9) s.concat("0");
-  s.concat(date.month);
-  s.concat("/");
-  s.concat(date.year);
-  s.concat(" ");
+/**
+* Pin change interrupt of the RTC's 1 Hz clock output: counts the seconds
+* for rtcTime.
+*/
+ISR(PCINT2_vect){
+  rtcTime.edge();
+}
 
-  if(date.hour>=0 && date.hour<=9) s.concat("0");
-  s.concat(date.hour);
-  s.concat(":");
-  if(date.minute>=0 && date.minute<=9) s.concat("0");
-  s.concat(date.minute);
-  s.concat(":");
-  if(date.second>=0 && date.second<=9) s.concat("0");
-  s.concat(date.second);
+/**
+* RTC task, run every RTC_POLL_INTERVAL: takes in the seconds counted by
+* the interrupt and repaints the clock when the time has changed.
+*/
+void handleRTC(){
+  if(rtcTime.poll()) scheduler.start(&clockTask);
+}
 
-  return s;
+/**
+* Current local time in seconds since 1970, for log records.
+*/
+uint32_t logTime(){
+  return rtcTime.unixtime();
 }
 
 /**
 * LOG METHODS
 **/
 
-void logMessage(String systemName, String message){
-  String log = systemName;
-  Datetime now = getDateTime();
-  log.concat(now.day); log.concat("/");
-  log.concat(now.month); log.concat("/");
-  log.concat(now.year); log.concat(" ");
-
-  log.concat(now.hour); log.concat(":");
-  log.concat(now.minute); log.concat(":");
-  log.concat(now.second); log.concat(";");
-  log.concat(message);
+/**
+* Log drain task, run every LOG_DRAIN_INTERVAL: sends queued log records
+* as far as the serial TX buffer takes them without waiting.
+*/
+void drainLog(){
+  eventLog.drain(Serial);
+}
 
-  Serial.println(log);
+/**
+* Prints an event on the history screen's log as "hh:mm text".
+*/
+void printEvent(uint8_t system, uint8_t code){
+  const char *text;
+  if(system == LOG_HEATER){
+    text = (code == EVENT_HEATER_ON) ? S_HISTORY_HEATER_ON : S_HISTORY_HEATER_OFF;
+  }
+  else if(system == LOG_TEMP_HUM){
+    if(code == EVENT_TEMP_HUM_TIMEOUT) text = S_HISTORY_TEMP_HUM_TIMEOUT;
+    else if(code == EVENT_TEMP_HUM_CHECKSUM) text = S_HISTORY_TEMP_HUM_CHECKSUM;
+    else text = S_HISTORY_TEMP_HUM_SAFE_MODE;
+  }
+  else text = S_HISTORY_RTC_ADJUSTED;
 
-  //TODO
+  char line[HISTORY_LINE_LENGTH+1];
+  char *end = formatDateTime(line, sizeof(line), F(S_HISTORY_TIME_FORMAT), rtcTime.now());
+  strncpy(end, text, line+HISTORY_LINE_LENGTH-end);
+  line[HISTORY_LINE_LENGTH] = 0;
+  eventConsole.println(line);
 }
 
 /**
-* CLOCK METHODS (Continued)
-**/
+* Queues an event for the log drain task and, while the history screen is
+* shown, prints it there too.
+*/
+void logEvent(uint8_t system, uint8_t code, uint16_t arg, uint32_t value){
+  eventLog.log(system, code, arg, value);
+  if(historyShown) printEvent(system, code);
+}
 
 void setDateTime(Datetime now){
-  Datetime oldDate = getDateTime();
-  rtc.adjust(DateTime(now.year, now.month, now.day, now.hour, now.minute, now.second));
-  String message = "Date and time changed from \"";
-  message.concat(datetimeToString(oldDate));
-  message.concat("\" to \"");
-  message.concat(datetimeToString(getDateTime()));
-  message.concat("\"");
-  logMessage(RTC_SYSTEM_NAME, message);
+  uint32_t oldTime = logTime();
+  rtcTime.adjust(DateTime(now.year, now.month, now.day, now.hour, now.minute, now.second));
+  logEvent(LOG_RTC, EVENT_RTC_ADJUSTED, 0, oldTime);
 }
 
 /**
@@ -313,6 +516,7 @@ void setDateTime(Datetime now){
 
 void cleanScreen(){
   tft.fillScreen(TFT_BACKGROUND_COLOR);
+  invalidateMainScreen();
 }
 
 boolean isDisplayOn(){
@@ -323,292 +527,304 @@ void setBrightness(uint16_t brightness){
   analogWrite(LCD_PWM, map(brightness, 0, 100, 0, 255));
 }
 
-void getTextBounds(String s, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
-  int str_len = s.length() + 1;
-  int16_t  x2, y2;
-  uint16_t w1, h1;
-  char char_array[str_len];
-  s.toCharArray(char_array, str_len);
-  tft.getTextBounds(char_array, x, y, &x2, &y2, &w1, &h1);
-  *x1 = x2;
-  *y1 = y2;
-  *w = w1;
-  *h = h1;
- }
-
 void updateScreenDate(){
-  Datetime now = getDateTime();
-  tft.setFont(&FreeMonoBold18pt7b);
+  char date[9];
+  tft.setFont(&FreeMonoBold18pt7bRLE);
   tft.setTextSize(1);
   tft.setTextColor(TFT_WHITE, TFT_BACKGROUND_COLOR);
   int xDatePos = 294;
   int yDatePos = 70;
-  String date = "";
-  if(now.day<10) date.concat("0");
-  date.concat(now.day);
-  date.concat(C_DATE_SEPARATOR);
-  if(now.month<10) date.concat("0");
-  date.concat(now.month);
-  date.concat(C_DATE_SEPARATOR);
-  date.concat(now.year-2000);
+  formatDateTime(date, sizeof(date), F(S_DATE_FORMAT), rtcTime.now());
   tft.setCursor(xDatePos, yDatePos);
   tft.print(date);
 }
 
+/**
+* Paints a two-digit clock field whose text starts at x: the digits are
+* rendered into clockCanvas and sent with their background in a single
+* address window, so the old value is never erased on screen first.
+*/
+void printClockField(int x, uint8_t value){
+  char digits[3];
+  formatUnsigned(digits, value, 2);
+  clockCanvas.fillScreen(0);
+  clockCanvas.setCursor(-textXOffset, -textYOffset);
+  clockCanvas.print(digits);
+  tft.drawCanvas(x+textXOffset, yClockPos+textYOffset, &clockCanvas, TFT_CLOCK_COLOR, TFT_BACKGROUND_COLOR);
+}
+
+/**
+* Clock task, started by the RTC task whenever the time changes: repaints
+* what changed since the last call.
+*/
 void updateScreenClock(){
-  if (targetTime < millis()) {
-    // Set next update for 1 second later
-    targetTime = millis() + 1000;
-    // Adjust the time values by adding 1 second
-    ss++;              // Advance second
-    if (ss == 60) {    // Check for roll-over
-      ss = 0;          // Reset seconds to zero
-      omm = mm;        // Save last minute time for display update
-      mm++;            // Advance minute
-      Datetime now = getDateTime();
-      mm = now.minute;
-      hh = now.hour;
-      if (mm > 59) {   // Check for roll-over
-        mm = 0;
-        ohh = hh;
-        hh++;          // Advance hour
-        if (hh > 23) { // Check for 24hr roll-over (could roll-over on 13)
-          hh = 0; // 0 for 24 hour clock, set to 1 for 12 hour clock
-          updateScreenDate();
-        }
-      }
-    }
+  if(historyShown) return;
+  DateTime now = rtcTime.now();
+  ss = now.second();
+  mm = now.minute();
+  hh = now.hour();
+  if(hh != ohh && hh == 0) updateScreenDate(); //Midnight
+
+  tft.setFont(&FreeMonoBold24pt7bRLE);
+  tft.setTextSize(1);
 
-    tft.setFont(&FreeMonoBold24pt7b);
-    tft.setTextSize(1);
-    String s = "";
-
-    if(ohh != hh){
-      //Update hours
-      ohh = hh;
-      tft.setTextColor(TFT_CLOCK_COLOR);
-      tft.setCursor(xClockPos, yClockPos);
-      s = (hh<10)?"0":"";
-      s.concat(hh);
-      tft.fillRect(xClockPos+textXOffset, yClockPos+textYOffset, fillRectPlus+charWidth*2, charHeight, TFT_BACKGROUND_COLOR);
-      tft.print(s);
-    }
+  if(ohh != hh){
+    //Update hours
+    ohh = hh;
+    printClockField(xClockPos, hh);
+  }
 
-    if(ss%2==0) tft.setTextColor(TFT_CLOCK_COLON_OFF);
-    tft.setCursor(xClockPos+charWidth*2, yClockPos+colonYOffset);
-    tft.print(C_HOUR_SEPARATOR);
-
-    if(omm != mm){
-      //Update minutes
-      omm = mm;
-      tft.setTextColor(TFT_CLOCK_COLOR);
-      tft.setCursor(xClockPos+charWidth*3, yClockPos);
-      s = (mm<10)?"0":"";
-      s.concat(mm);
-      tft.fillRect(xClockPos+textXOffset+charWidth*3, yClockPos+textYOffset, fillRectPlus+charWidth*2, charHeight, TFT_BACKGROUND_COLOR);
-      tft.print(s);
-    }
+  tft.setTextColor(ss%2==0 ? TFT_CLOCK_COLON_OFF : TFT_CLOCK_COLOR);
+  tft.setCursor(xClockPos+charWidth*2, yClockPos+colonYOffset);
+  tft.print(C_HOUR_SEPARATOR);
 
-    if(ss%2==0) tft.setTextColor(TFT_CLOCK_COLON_OFF);
-    tft.setCursor(xClockPos+charWidth*5, yClockPos+colonYOffset);
-    tft.print(C_HOUR_SEPARATOR);
-
-    //Update seconds
-    tft.setTextColor(TFT_CLOCK_COLOR);
-    tft.setCursor(xClockPos+charWidth*6, yClockPos);
-    s = (ss<10)?"0":"";
-    s.concat(ss);
-    tft.fillRect(xClockPos+textXOffset+charWidth*6, yClockPos+textYOffset, fillRectPlus+charWidth*2, charHeight, TFT_BACKGROUND_COLOR);
-    tft.print(s);
+  if(omm != mm){
+    //Update minutes
+    omm = mm;
+    printClockField(xClockPos+charWidth*3, mm);
   }
-}
 
-void paintGradient(int x, int y, int lines, uint16_t initialColour, uint16_t finalColour){
-  /*uint8_t initialRed = ((initialColour >> 11) & 0x1F);
-  uint8_t initialGreen = ((initialColour >> 5) & 0x3F);
-  uint8_t initialBlue = (initialColour & 0x1F);*/
-  double gradientHeight = (double)lines;
+  tft.setCursor(xClockPos+charWidth*5, yClockPos+colonYOffset);
+  tft.print(C_HOUR_SEPARATOR);
 
-  double ini = ((initialColour >> 11) & 0x1F);
-  double fin = ((finalColour >> 11) & 0x1F);
-  double redLeap = (fin-ini)/gradientHeight;
+  //Update seconds
+  printClockField(xClockPos+charWidth*6, ss);
 
-  ini = ((initialColour >> 5) & 0x3F);
-  fin = ((finalColour >> 5) & 0x3F);
-  double greenLeap = (fin-ini)/gradientHeight;
+  //Date and time fields and pages in the menu follow the clock
+  menu.refresh();
+}
 
-  ini = (initialColour & 0x1F);
-  fin = (finalColour & 0x1F);
-  double blueLeap = (fin-ini)/gradientHeight;
+/**
+* Paints, inside the given rectangle, the background of the main screen
+* section covering lines sectionY to sectionEnd-1: a dithered gradient
+* that starts at line gradientY with gradientColour and fades into the
+* background colour over SECTION_GRADIENT_LINES lines above it.
+*/
+void paintSectionBackground(int16_t x, int16_t y, int16_t w, int16_t h, int16_t sectionY, int16_t sectionEnd, int16_t gradientY, uint16_t gradientColour){
+  int16_t top = y;
+  int16_t bottom = y+h;
+  if(top<sectionY) top = sectionY;
+  if(bottom>sectionEnd) bottom = sectionEnd;
+  if(top>=bottom) return;
+  tft.fillGradientRect(x, top, w, bottom-top, gradientY, gradientColour, gradientY-SECTION_GRADIENT_LINES, TFT_BACKGROUND_COLOR, true);
+}
 
-  for(int i=0;i<gradientHeight-1;i++){
-    int red = ((initialColour >> 11) & 0x1F) + ((int)(redLeap*i));
-    int green = ((initialColour >> 5) & 0x3F) + ((int)(greenLeap*i));
-    int blue = (initialColour & 0x1F) + ((int)(blueLeap*i));
-    tft.drawFastHLine(x, y-i, TFT_WIDTH, red << 11 | green << 5 | blue);
-  }
-  tft.drawFastHLine(x, y-gradientHeight, TFT_WIDTH, finalColour);
+/**
+* Restores the main screen background (flat colour plus the gradient at
+* the bottom of each section) under a widget or a whole section.
+*/
+void paintMainScreenBackground(int16_t x, int16_t y, int16_t w, int16_t h){
+  if(y<TEMP_SECTION_Y) tft.fillRect(x, y, w, (y+h<TEMP_SECTION_Y ? y+h : TEMP_SECTION_Y)-y, TFT_BACKGROUND_COLOR);
+  paintSectionBackground(x, y, w, h, TEMP_SECTION_Y, LIGHT_SECTION_Y, TEMP_SECTION_Y+TEMP_SECTION_HEIGHT, TFT_TEMP_OK);
+  paintSectionBackground(x, y, w, h, LIGHT_SECTION_Y, TFT_HEIGHT, TFT_HEIGHT, TFT_TEMP_OFF);
 }
 
- void updateMainScreenTemperatureSection(){
+ /**
+ * Paints the static parts of the temperature section (title, labels and
+ * gradient) and places its widgets.
+ */
+ void paintMainScreenTemperatureSection(){
    int relPosXTemp = 0;
-   int relPosYTemp = 100;
-   int tempSectionHeight = 111;
+   int relPosYTemp = TEMP_SECTION_Y;
 
-   tft.setFont(&FreeSansBold9pt7b);
-   tft.fillRect(relPosXTemp, relPosYTemp, TFT_WIDTH, tempSectionHeight, TFT_BACKGROUND_COLOR); //RESET TEMP SECTION
+   paintMainScreenBackground(relPosXTemp, relPosYTemp, TFT_WIDTH, LIGHT_SECTION_Y-relPosYTemp); //RESET TEMP SECTION
    tft.fillRect(relPosXTemp, relPosYTemp, TFT_WIDTH, 3, TFT_SEPATATOR_BAR);
 
-   int16_t  x, y;
-   uint16_t w, h;
-   getTextBounds(S_MAIN_SCREEN_TEMPERATURE, relPosXTemp+5, relPosYTemp+2, &x, &y, &w, &h);
-   tft.fillRoundRect(relPosXTemp+5, relPosYTemp, w+7, 21, 3, TFT_SEPATATOR_BAR);
+   tft.fillRoundRect(relPosXTemp+5, relPosYTemp, temperatureTitleLabel.width()+7, 21, 3, TFT_SEPATATOR_BAR);
    tft.setTextColor(TFT_WHITE);
-   tft.setCursor(relPosXTemp+7, relPosYTemp+14);
-   tft.setTextSize(1);
-   tft.print(S_MAIN_SCREEN_TEMPERATURE);
+   temperatureTitleLabel.print(&tft, relPosXTemp+7, relPosYTemp+14);
 
-   paintGradient(0, relPosYTemp+tempSectionHeight, 60, TFT_TEMP_OK, TFT_BACKGROUND_COLOR);
-
-   tft.setTextSize(1);
-   tft.setTextColor(TFT_WHITE);
-   tft.setCursor(relPosXTemp+7, relPosYTemp+45);
-
-   tft.setFont(&FreeMono12pt7b);
-   getTextBounds(S_MAIN_SCREEN_TEMPERATURE_MODE, relPosXTemp+7, relPosYTemp+45, &x, &y, &w, &h);
-   int modeLength = w;
-   int modeHeight = h;
-
-   getTextBounds(S_MAIN_SCREEN_TEMPERATURE_HEATER, relPosXTemp+7, relPosYTemp+modeHeight+15+45, &x, &y, &w, &h);
-   int heaterLength = w;
-   int heaterHeight = h;
-
-   getTextBounds(S_MAIN_SCREEN_TEMPERATURE_SET_TEMP, relPosXTemp+7, relPosYTemp+heaterHeight+15+45, &x, &y, &w, &h);
-   int setTempLength = w;
+   int modeLength = temperatureModeLabel.width();
+   int modeHeight = temperatureModeLabel.height();
+   int heaterLength = heaterLabel.width();
+   int heaterHeight = heaterLabel.height();
+   int setTempLength = setTemperatureLabel.width();
 
    int maxLength = modeLength;
    if(heaterLength>maxLength) maxLength = heaterLength;
    if(setTempLength>maxLength) maxLength = setTempLength;
 
    int offset = 2;
-   tft.setCursor(maxLength-modeLength+offset, relPosYTemp+45);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_TEMPERATURE_MODE);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.print("AUTO");
-
-   tft.setCursor(maxLength-heaterLength+offset, relPosYTemp+45+modeHeight+15);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_TEMPERATURE_HEATER);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.println("ON");
-
-   tft.setCursor(maxLength-setTempLength+offset, relPosYTemp+45+modeHeight+15+heaterHeight+15);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_TEMPERATURE_SET_TEMP);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.println("25C");
-
-   String currentTemp = "25"; //TODO Get actual current temp
+   temperatureModeLabel.print(&tft, maxLength-modeLength+offset, relPosYTemp+45);
+   temperatureModeWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
+   heaterLabel.print(&tft, maxLength-heaterLength+offset, relPosYTemp+45+modeHeight+15);
+   heaterStateWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
+   setTemperatureLabel.print(&tft, maxLength-setTempLength+offset, relPosYTemp+45+modeHeight+15+heaterHeight+15);
+   setTemperatureWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
    int currentTempXRelPos = 340;
    int currentTempYRelPos = relPosYTemp+23;
-   tft.setFont(&FreeMono9pt7b);
-   tft.setTextSize(1);
-   getTextBounds(S_MAIN_SCREEN_TEMPERATURE_CURRENT_TEMP, 0, 0, &x, &y, &w, &h);
-   tft.setCursor(currentTempXRelPos-(w/2), currentTempYRelPos);
-   int currentTempHeight = h;
-   tft.print(S_MAIN_SCREEN_TEMPERATURE_CURRENT_TEMP);
-   tft.setFont(&FreeSansBold24pt7b);
-   tft.setTextSize(2);
-   getTextBounds(currentTemp, 0, 0, &x, &y, &w, &h);
-   tft.setCursor(currentTempXRelPos-(w/2), currentTempYRelPos+currentTempHeight+65);
-   tft.print(currentTemp);
+   int currentTempHeight = currentTemperatureLabel.height();
+   currentTemperatureLabel.print(&tft, currentTempXRelPos-(currentTemperatureLabel.width()/2), currentTempYRelPos);
+   currentTemperatureWidget.setPosition(currentTempXRelPos, currentTempYRelPos+currentTempHeight+65);
+
+   temperatureModeWidget.invalidate();
+   heaterStateWidget.invalidate();
+   setTemperatureWidget.invalidate();
+   currentTemperatureWidget.invalidate();
  }
 
- void updateMainScreenLightSection(){
+ /**
+ * Brings the temperature section values up to date from the heater and
+ * the last DHT11 reading, repainting only the ones that changed.
+ */
+ void updateMainScreenTemperatureSection(){
+   char value[TEXT_WIDGET_MAX_LENGTH+1];
+
+   switch(heaterMode){
+     case HEATER_MODE_AUTO: temperatureModeWidget.setText("AUTO"); break;
+     case HEATER_MODE_OFF: temperatureModeWidget.setText("OFF"); break;
+     case HEATER_MODE_ON: temperatureModeWidget.setText("ON"); break;
+     case HEATER_SAFE_MODE: temperatureModeWidget.setText("SAFE"); break;
+   }
+   heaterStateWidget.setText(heaterOn ? "ON" : "OFF");
+   strcpy(formatSigned(value, selectedTemp), S_MENU_UNIT_CELSIUS);
+   setTemperatureWidget.setText(value);
+   //No reading yet, or the last request failed
+   if(tempHumValid) formatSigned(value, (int)DHT.temperature);
+   else strcpy(value, "--");
+   currentTemperatureWidget.setText(value);
+
+   temperatureModeWidget.update(paintMainScreenBackground);
+   heaterStateWidget.update(paintMainScreenBackground);
+   setTemperatureWidget.update(paintMainScreenBackground);
+   currentTemperatureWidget.update(paintMainScreenBackground);
+ }
+
+ /**
+ * Paints the static parts of the light section (title, labels and
+ * gradient) and places its widgets.
+ */
+ void paintMainScreenLightSection(){
    int relPosXLight = 0;
-   int relPosYLight = 212;
+   int relPosYLight = LIGHT_SECTION_Y;
 
-   int16_t  x, y;
-   uint16_t w, h;
-   tft.setFont(&FreeSansBold9pt7b);
-   tft.setTextSize(1);
+   paintMainScreenBackground(relPosXLight, relPosYLight, TFT_WIDTH, TFT_HEIGHT-relPosYLight); //RESET LIGHT SECTION
    tft.fillRect(relPosXLight, relPosYLight, TFT_WIDTH, 3, TFT_SEPATATOR_BAR);
-   getTextBounds(S_MAIN_SCREEN_LIGHT, relPosXLight+5, relPosYLight+2, &x, &y, &w, &h);
-   tft.fillRoundRect(relPosXLight+5, relPosYLight, w+7, 21, 3, TFT_SEPATATOR_BAR);
+   tft.fillRoundRect(relPosXLight+5, relPosYLight, lightTitleLabel.width()+7, 21, 3, TFT_SEPATATOR_BAR);
    tft.setTextColor(TFT_WHITE);
-   tft.setCursor(relPosXLight+7, relPosYLight+14);
-   tft.print(S_MAIN_SCREEN_LIGHT);
-
-   paintGradient(0, TFT_HEIGHT, 60, TFT_TEMP_OFF, TFT_BACKGROUND_COLOR);
+   lightTitleLabel.print(&tft, relPosXLight+7, relPosYLight+14);
 
-   tft.setTextSize(1);
-   tft.setTextColor(TFT_WHITE);
    int parametersOffset = 35;
    int parametersLineOffset = 15;
-   tft.setCursor(relPosXLight+7, relPosYLight+parametersOffset);
-
-   tft.setFont(&FreeMono12pt7b);
-   getTextBounds(S_MAIN_SCREEN_LIGHT_MODE, relPosXLight+7, relPosYLight+parametersOffset, &x, &y, &w, &h);
-   int modeLength = w;
-   int modeHeight = h;
 
-   getTextBounds(S_MAIN_SCREEN_LIGHT_LIGHTING, relPosXLight+7, relPosYLight+modeHeight+parametersLineOffset+parametersOffset, &x, &y, &w, &h);
-   int lightingLength = w;
-   int lightingHeight = h;
-
-   getTextBounds(S_MAIN_SCREEN_LIGHT_THRESHOLD, relPosXLight+7, relPosYLight+lightingHeight+parametersLineOffset+parametersOffset, &x, &y, &w, &h);
-   int thresholdLength = w;
+   int modeLength = lightModeLabel.width();
+   int modeHeight = lightModeLabel.height();
+   int lightingLength = lightingLabel.width();
+   int lightingHeight = lightingLabel.height();
+   int thresholdLength = lightThresholdLabel.width();
 
    int maxLength = modeLength;
    if(lightingLength>maxLength) maxLength = lightingLength;
    if(thresholdLength>maxLength) maxLength = thresholdLength;
 
    int offset = 2;
-   tft.setCursor(maxLength-modeLength+offset, relPosYLight+parametersOffset);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_LIGHT_MODE);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.print("AUTO");
-
-   tft.setCursor(maxLength-lightingLength+offset, relPosYLight+parametersOffset+modeHeight+parametersLineOffset);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_LIGHT_LIGHTING);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.println("ON");
-
-   tft.setCursor(maxLength-thresholdLength+offset, relPosYLight+parametersOffset+modeHeight+parametersLineOffset+lightingHeight+parametersLineOffset);
-   tft.setFont(&FreeMono12pt7b);
-   tft.print(S_MAIN_SCREEN_LIGHT_THRESHOLD);
-   tft.setFont(&FreeMonoBold12pt7b);
-   tft.println("50%");
-
-   String currentLight = "25"; //TODO Get actual current light
+   lightModeLabel.print(&tft, maxLength-modeLength+offset, relPosYLight+parametersOffset);
+   lightModeWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
+   lightingLabel.print(&tft, maxLength-lightingLength+offset, relPosYLight+parametersOffset+modeHeight+parametersLineOffset);
+   lightingStateWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
+   lightThresholdLabel.print(&tft, maxLength-thresholdLength+offset, relPosYLight+parametersOffset+modeHeight+parametersLineOffset+lightingHeight+parametersLineOffset);
+   lightThresholdWidget.setPosition(tft.getCursorX(), tft.getCursorY());
+
    int currentLightXRelPos = 340;
    int currentLightYRelPos = relPosYLight+23;
-   tft.setFont(&FreeMono9pt7b);
-   tft.setTextSize(1);
-   getTextBounds(S_MAIN_SCREEN_LIGHT_CURRENT_LIGHT, 0, 0, &x, &y, &w, &h);
-   tft.setCursor(currentLightXRelPos-(w/2), currentLightYRelPos);
-   int currentLightHeight = h;
-   tft.print(S_MAIN_SCREEN_LIGHT_CURRENT_LIGHT);
-   tft.setFont(&FreeSansBold24pt7b);
-   tft.setTextSize(2);
-   getTextBounds(currentLight, 0, 0, &x, &y, &w, &h);
-   tft.setCursor(currentLightXRelPos-(w/2), currentLightYRelPos+currentLightHeight+65);
-   tft.print(currentLight);
-   tft.setTextSize(1);
-   tft.print("%");
+   int currentLightHeight = currentLightLabel.height();
+   currentLightLabel.print(&tft, currentLightXRelPos-(currentLightLabel.width()/2), currentLightYRelPos);
+   currentLightWidget.setPosition(currentLightXRelPos, currentLightYRelPos+currentLightHeight+65);
+
+   lightModeWidget.invalidate();
+   lightingStateWidget.invalidate();
+   lightThresholdWidget.invalidate();
+   currentLightWidget.invalidate();
+   currentLightUnitWidget.invalidate();
+ }
+
+ /**
+ * Brings the light section values up to date, repainting only the ones
+ * that changed.
+ */
+ void updateMainScreenLightSection(){
+   char value[TEXT_WIDGET_MAX_LENGTH+1];
+
+   lightModeWidget.setText("AUTO");
+   lightingStateWidget.setText("ON");
+   lightThresholdWidget.setText("50%");
+   formatSigned(value, currentLightLevel);
+   currentLightWidget.setText(value);
+   currentLightUnitWidget.setText("%");
+
+   lightModeWidget.update(paintMainScreenBackground);
+   lightingStateWidget.update(paintMainScreenBackground);
+   lightThresholdWidget.update(paintMainScreenBackground);
+   //The unit follows the reading, which is centred, so either may overlap
+   //where the other was: erase both before drawing
+   currentLightUnitWidget.setPosition(currentLightWidget.endX(), currentLightWidget.baseline());
+   currentLightWidget.erase(paintMainScreenBackground);
+   currentLightUnitWidget.erase(paintMainScreenBackground);
+   currentLightWidget.draw();
+   currentLightUnitWidget.draw();
  }
 
+/**
+* The static parts of the main screen are painted only after the screen
+* has been cleared; otherwise just the values that changed are repainted.
+* Nothing is painted while the menu or the history screen covers the
+* sections.
+*/
 void updateMainScreen(){
+  if(menu.shown() || historyShown) return;
+  if(!mainScreenPainted){
+    paintMainScreenTemperatureSection();
+    paintMainScreenLightSection();
+    mainScreenPainted = true;
+  }
   updateMainScreenTemperatureSection();
   updateMainScreenLightSection();
 }
 
+void invalidateMainScreen(){
+  mainScreenPainted = false;
+}
+
+/**
+* Date, clock and main screen, painted in full.
+*/
+void showMainScreen(){
+  cleanScreen();
+  updateScreenDate();
+  ohh = omm = 99;
+  updateScreenClock();
+  updateMainScreen();
+}
+
+/**
+* Replaces the main screen with the temperature chart and the event log.
+* Both then draw just what each new reading or event adds.
+*/
+void showHistoryScreen(){
+  historyShown = true;
+  temperatureChart.show(0, 0, HISTORY_CHART_WIDTH, TFT_HEIGHT);
+  eventConsole.begin(HISTORY_CHART_WIDTH, 0, TFT_WIDTH-HISTORY_CHART_WIDTH, TFT_HEIGHT);
+}
+
+void hideHistoryScreen(){
+  eventConsole.end();
+  temperatureChart.hide();
+  historyShown = false;
+  showMainScreen();
+}
+
+/**
+* The controller sleeps with the picture kept in its GRAM, which the screen
+* updates keep current meanwhile, so waking it needs no repaint.
+*/
 void turnOnDisplay(){
   if(!isDisplayOn()){
-    updateMainScreen();
+    tft.enableSleep(false);
     setBrightness(100);
     displayOn = true;
   }
@@ -616,8 +832,8 @@ void turnOnDisplay(){
 
 void turnOffDisplay(){
   if(isDisplayOn()){
-    tft.fillScreen(TFT_BLACK);
     setBrightness(0);
+    tft.enableSleep(true);
     displayOn = false;
   }
 }
@@ -626,12 +842,20 @@ void turnOffDisplay(){
 * MULTIPLEXER METHODS
 **/
 
-int getMuxInputState(int input){
-  for(int i=0;i<MULTIPLEXER_INPUT_NUM;i++){
-    digitalWrite(MULTIPLEXER_S_PINS[i], bitRead(input, i));
-  }
+/**
+* Timer 5 compare interrupt, every MULTIPLEXER_SCAN_US: reads the selected
+* multiplexer input and selects the next one for muxScanner.
+*/
+ISR(TIMER5_COMPA_vect){
+  muxScanner.scan();
+}
 
-  return digitalRead(MULTIPLEXER_Z_PIN);
+/**
+* Debounced level of a multiplexer input from the background scan; no pin is
+* touched.
+*/
+int getMuxInputState(int input){
+  return muxScanner.read(input);
 }
 
 /**
@@ -639,33 +863,12 @@ int getMuxInputState(int input){
 **/
 
 /**
-* Internal method. Checks if it is necessary to make a new reading of the
-* temperature / humidity or if it is allowed to use the last reading values.
-* args: bool force. False means that the last reading values could be used if it
-* is allowed. True means to force a new reading.
-* args: long millis. Current millis to check if it is necessary to make a new
-* reading depending on when the last reading was.
-* return: 0 Ok, -1 Checksum error, -2 timeout.
+* Pin change interrupt of the sensor data line. Every edge of the sensor's
+* answer is timestamped by the DHT library, which decodes the bits from the
+* pulse widths so that loop() never waits for the sensor.
 */
-int readTempHum(bool force, long millis){
-  int result = 0;
-  if(force || (millis - lastTempLectureMillis)>=MIN_TEMP_HUM_READING_INTERVAL){
-    result = DHT.read11(TEMP_HUM_DIGITAL_SENSOR_PIN);
-    lastTempLectureMillis = millis;
-
-    switch(result){
-      case -2://TIMEOUT
-        logMessage(TEMP_HUM_SYSTEM_NAME, "Timeout error occured");
-        break;
-      case -1://CHECKSUM error
-        logMessage(TEMP_HUM_SYSTEM_NAME, "Checksum error occured");
-        break;
-      case 0://OK
-        break;
-    }
-  }
-
-  return result;
+ISR(PCINT1_vect){
+  DHT.edge();
 }
 
 /**
@@ -686,29 +889,48 @@ float getHumidity(){
   return DHT.humidity;
 }
 
-void handleTempHumSensor(long millis){
-  bool flag = true;
-  if((millis - lastTempLectureMillis) >= TEMP_HUM_READING_INTERVAL){
-    if(readTempHum(false, millis)!=0){
-      //ERROR DURING TEMPERATURE AND HUMIDITY MEASUREMENT
-      int attempts = 0;
-      flag = false;
-      while(attempts<MEASUREMENT_ATTEMPTS && !flag){
-        attempts++;
-        delay(3000);
-        if(readTempHum(true, millis)==0) flag = true;
-      }
-    }
+/**
+* DHT11 request task, run every TEMP_HUM_READING_INTERVAL: starts a new
+* reading. Failed readings are retried MEASUREMENT_ATTEMPTS times,
+* MEASUREMENT_RETRY_DELAY ms apart, by the DHT library itself.
+*/
+void requestTempHum(){
+  DHT.request(1+MEASUREMENT_ATTEMPTS, MEASUREMENT_RETRY_DELAY);
+}
 
-    if(!flag){
-      //TODO Not possible temperature and humidity measurement.
-      //Suggest to reboot the device.
-      //Put the heater in safety mode
-      heaterMode = HEATER_SAFE_MODE;
-      logMessage(TEMP_HUM_SYSTEM_NAME, "Safe mode activated");
-      //Sound alarm
-      //Enter in mode alarm
-    }
+/**
+* DHT11 poll task, run every TEMP_HUM_POLL_INTERVAL: moves the reading on
+* and collects its result; none of it blocks.
+*/
+void handleTempHumSensor(){
+  switch(DHT.poll()){
+    case DHTLIB_ERROR_TIMEOUT:
+      logEvent(LOG_TEMP_HUM, EVENT_TEMP_HUM_TIMEOUT);
+      break;
+    case DHTLIB_ERROR_CHECKSUM:
+      logEvent(LOG_TEMP_HUM, EVENT_TEMP_HUM_CHECKSUM);
+      break;
+    case DHTLIB_OK:
+      tempHumValid = true;
+      temperatureChart.add(DHT.temperature);
+      updateMainScreen();
+      return;
+    default://Busy
+      return;
+  }
+
+  if(DHT.ready()){
+    //TODO Not possible temperature and humidity measurement.
+    //Suggest to reboot the device.
+    //Put the heater in safety mode, starting with the relay off
+    tempHumValid = false;
+    heaterMode = HEATER_SAFE_MODE;
+    millisSafeMode = millis();
+    turnOffHeater();
+    updateMainScreen();
+    logEvent(LOG_TEMP_HUM, EVENT_TEMP_HUM_SAFE_MODE);
+    //Sound alarm
+    //Enter in mode alarm
   }
 }
 
@@ -738,112 +960,95 @@ boolean isHeaterOn(){
   return heaterOn;
 }
 
-int getHeaterMode(){
+/**
+* Takes the heater mode from the position of the mode switch, unless in safe
+* mode. Called at start-up and whenever the scan sees the switch move.
+*/
+void readHeaterModeSwitch(){
   if(heaterMode != HEATER_SAFE_MODE){
-    if(getMuxInputState(HEATER_MODE_SWITCH_AUTO_MUX_INPUT) == LOW) heaterMode = HEATER_MODE_AUTO;
-    else if(getMuxInputState(HEATER_MODE_SWITCH_OFF_MUX_INPUT) == LOW) heaterMode = HEATER_MODE_OFF;
-    else if(getMuxInputState(HEATER_MODE_SWITCH_ON_MUX_INPUT) == LOW) heaterMode = HEATER_MODE_ON;
+    uint8_t inputs = muxScanner.state();
+    if(!bitRead(inputs, HEATER_MODE_SWITCH_AUTO_MUX_INPUT)) heaterMode = HEATER_MODE_AUTO;
+    else if(!bitRead(inputs, HEATER_MODE_SWITCH_OFF_MUX_INPUT)) heaterMode = HEATER_MODE_OFF;
+    else if(!bitRead(inputs, HEATER_MODE_SWITCH_ON_MUX_INPUT)) heaterMode = HEATER_MODE_ON;
   }
-  return heaterMode;
 }
 
-String getHeaterModeName(int heaterMode){
-  String mode = "";
-  switch(heaterMode){
-    case HEATER_MODE_AUTO:
-      mode = "AUTO";
-      break;
-    case HEATER_MODE_OFF:
-      mode = "OFF";
-      break;
-    case HEATER_MODE_ON:
-      mode = "ON";
-      break;
-  }
-
-  return mode;
+int getHeaterMode(){
+  return heaterMode;
 }
 
 void turnOnHeater(){
   if(!isHeaterOn()){
     digitalWrite(HEATER_RELAY_PIN, HIGH);
+    heaterOn = true;
     startHeaterTimeTracking();
-
-    String mode = getHeaterModeName(getHeaterMode());
-    String message = "";
-    message.concat(mode); message.concat("#");message.concat("ON#");
-    message.concat(heaterTotalSeconds);
-    logMessage(HEATER_SYSTEM_NAME, message);
+    logEvent(LOG_HEATER, EVENT_HEATER_ON, getHeaterMode(), heaterTotalSeconds);
+    updateMainScreen();
   }
 }
 
 void turnOffHeater(){
   if(isHeaterOn()){
     digitalWrite(HEATER_RELAY_PIN, LOW);
+    heaterOn = false;
     stopHeaterTimeTracking();
-
-    String mode = getHeaterModeName(getHeaterMode());
-    String message = "";
-    message.concat(mode); message.concat("#");message.concat("OFF#");
-    message.concat(heaterTotalSeconds);
-    logMessage(HEATER_SYSTEM_NAME, message);
+    logEvent(LOG_HEATER, EVENT_HEATER_OFF, getHeaterMode(), heaterTotalSeconds);
+    updateMainScreen();
   }
 }
 
+/**
+* Safe mode, with no temperature to go by: the relay is cycled on and off
+* for fixed times, longer on at night. millisSafeMode is when the current
+* on or off period started.
+*/
 void heaterSafeMode(){
   Datetime now = getDateTime();
+  unsigned long elapsed = millis() - millisSafeMode;
   if((now.hour>20 && now.minute>30) || (now.hour<8 && now.minute < 30)){
     //nighttime
     if(isHeaterOn()){
-      if(millisSafeMode > HEATER_SAFE_MODE_NIGHTTIME_ON){
-        millisSafeMode = 0;
+      if(elapsed > HEATER_SAFE_MODE_NIGHTTIME_ON){
+        millisSafeMode = millis();
         turnOffHeater();
       }
-      else{
-        millisSafeMode += (millis() - millisSafeMode);
-      }
     }
     else{
-      if(millisSafeMode > HEATER_SAFE_MODE_NIGHTTIME_OFF){
-        millisSafeMode = 0;
+      if(elapsed > HEATER_SAFE_MODE_NIGHTTIME_OFF){
+        millisSafeMode = millis();
         turnOnHeater();
       }
-      else{
-        millisSafeMode += (millis() - millisSafeMode);
-      }
     }
   }
   else{
     //daytime
     if(isHeaterOn()){
-      if(millisSafeMode > HEATER_SAFE_MODE_DAYTIME_ON){
-        millisSafeMode = 0;
+      if(elapsed > HEATER_SAFE_MODE_DAYTIME_ON){
+        millisSafeMode = millis();
         turnOffHeater();
       }
-      else{
-        millisSafeMode += (millis() - millisSafeMode);
-      }
     }
     else{
-      if(millisSafeMode > HEATER_SAFE_MODE_DAYTIME_OFF){
-        millisSafeMode = 0;
+      if(elapsed > HEATER_SAFE_MODE_DAYTIME_OFF){
+        millisSafeMode = millis();
         turnOnHeater();
       }
-      else{
-        millisSafeMode += (millis() - millisSafeMode);
-      }
     }
   }
 }
 
 void handleHeater(){
+  if(muxScanner.changes() & HEATER_MODE_SWITCH_INPUTS){
+    readHeaterModeSwitch();
+    updateMainScreen();
+  }
   switch(getHeaterMode()){
     case HEATER_MODE_AUTO:
-      if(selectedTemp > getTemperature()) turnOnHeater();
+      if(tempHumValid && selectedTemp > getTemperature()) turnOnHeater();
       else turnOffHeater();
       break;
     case HEATER_MODE_ON:
-      if(MAX_TEMP_ALLOWED > getTemperature()) turnOnHeater();
+      if(tempHumValid && MAX_TEMP_ALLOWED > getTemperature()) turnOnHeater();
       else turnOffHeater();
       break;
     case HEATER_MODE_OFF:
@@ -857,149 +1062,190 @@ void handleHeater(){
 }
 
 /**
-* ROTARY ENCODER METHODS
+* MENU METHODS
 **/
 
+int daysInMonth(int month, int year){
+  if(month == 2) return (year%4 == 0) ? 29 : 28; //2000 to 2099
+  return (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
 /**
-* Returns the previos menu item to the current (selected) menu item
-* args: none
-* return: The MenuItem previous to the current one
+* Heater on time since start-up, the current spell included.
 */
-MenuItem previousMenuItem(){
-  return mainMenu[((menuIndex-1)<0)?mainMenuDimension-1:menuIndex-1];
+uint32_t getHeatingSeconds(){
+  uint32_t seconds = heaterTotalSeconds;
+  if(millisHeater != 0) seconds += (millis()-millisHeater)/1000;
+  return seconds;
 }
 
 /**
-* Returns the current (selected) menu item
-* args: none
-* return: The current (selected) menu item
+* Menu handler: current value of a number entry.
 */
-MenuItem currentMenuItem(){
-  return mainMenu[menuIndex];
+int16_t getMenuValue(uint8_t id){
+  Datetime now = getDateTime();
+  switch(id){
+    case MENU_MIN_TEMPERATURE: return selectedTemp;
+    case MENU_LIGHT_INTENSITY: return lightIntensity;
+    case MENU_YEAR: return now.year;
+    case MENU_MONTH: return now.month;
+    case MENU_DAY: return now.day;
+    case MENU_HOUR: return now.hour;
+    case MENU_MINUTE: return now.minute;
+  }
+  return 0;
 }
 
 /**
-* Returns the next menu item to the current (selected) menu item
-* args: none
-* return: The MenuItem next to the current one
+* Menu handler: takes an edited number. Date and time fields set the clock,
+* from second 0 for the hour and minute, with the day kept in the month.
 */
-MenuItem nextMenuItem(){
-  return mainMenu[((menuIndex+1)==mainMenuDimension)?0:menuIndex+1];
+void setMenuValue(uint8_t id, int16_t value){
+  if(id == MENU_MIN_TEMPERATURE) selectedTemp = value;
+  else if(id == MENU_LIGHT_INTENSITY) lightIntensity = value;
+  else{
+    Datetime now = getDateTime();
+    switch(id){
+      case MENU_YEAR: now.year = value; break;
+      case MENU_MONTH: now.month = value; break;
+      case MENU_DAY: now.day = value; break;
+      case MENU_HOUR: now.hour = value; now.second = 0; break;
+      case MENU_MINUTE: now.minute = value; now.second = 0; break;
+    }
+    int days = daysInMonth(now.month, now.year);
+    if(now.day > days) now.day = days;
+    setDateTime(now);
+    updateScreenDate();
+  }
+  //Shown once the menu closes
+  updateMainScreen();
 }
 
 /**
-* Moves one position forward the index to the selected menu item
-* args: none
-* return: The current menu item index
+* Menu handler: lines of the heating time page, the total time on in hours,
+* minutes and seconds and the heater state, and of the lighting time page,
+* which says the light's time on is not tracked until the sketch drives it.
 */
-int moveMenuIndexForward(){
-  menuIndex = ((menuIndex+1)==mainMenuDimension)?0:menuIndex+1;
-  return menuIndex;
+boolean getMenuPage(uint8_t id, uint8_t line, char *s, uint8_t size){
+  //"Total: " and the longest time, "1193046:28:15"
+  char text[sizeof(S_MENU_PAGE_TOTAL) + TEXT_FORMAT_DIGITS + 6];
+  switch(id){
+    case MENU_HEATING_TIME:
+      if(line == 0){
+        uint32_t seconds = getHeatingSeconds();
+        strcpy_P(text, PSTR(S_MENU_PAGE_TOTAL));
+        char *end = formatUnsigned(text+strlen(text), seconds/3600, 2);
+        *end++ = C_HOUR_SEPARATOR;
+        end = formatUnsigned(end, seconds/60%60, 2);
+        *end++ = C_HOUR_SEPARATOR;
+        formatUnsigned(end, seconds%60, 2);
+      }
+      else if(line == 1) strcpy_P(text, isHeaterOn() ? PSTR(S_HISTORY_HEATER_ON) : PSTR(S_HISTORY_HEATER_OFF));
+      else return false;
+      break;
+    case MENU_LIGHTING_TIME:
+      if(line != 0) return false;
+      strcpy_P(text, PSTR(S_MENU_PAGE_NOT_TRACKED));
+      break;
+    default:
+      return false;
+  }
+  if(!size) return true;
+  strncpy(s, text, size);
+  s[size-1] = 0;
+  return true;
 }
 
 /**
-* Moves one position backward the index to the selected menu item
-* args: none
-* return: The current menu item index
+* The menu is closed and the main screen sections it covered repainted.
 */
-int moveMenuIndexBackward(){
-  menuIndex = ((menuIndex-1)<0)?mainMenuDimension-1:menuIndex-1;
-  return menuIndex;
+void closeMenu(){
+  menu.close();
+  invalidateMainScreen();
+  updateMainScreen();
 }
 
 /**
-* Enable the enconder control methods to detect the rotation of the rotary
-* encoder. This method is attached to the rotary encoder movement by the method
-* AttachInterrupt.
-* args: none
-* return: none
+* Menu handler: actions leave the menu.
+*/
+void runMenuAction(uint8_t id){
+  if(id == MENU_SHOW_HISTORY){
+    menu.close();
+    showHistoryScreen();
+  }
+  else if(id == MENU_TURN_OFF_DISPLAY){
+    closeMenu();
+    turnOffDisplay();
+  }
+}
+
+/**
+* ROTARY ENCODER METHODS
+**/
+
+/**
+* Interrupt of either encoder pin: the encoder library decodes the edge and
+* queues the detents it completes for handleRotaryEncoder.
 */
 void rotEncoder(){
-  rotating=true;
+  encoder.edge();
 }
 
 /**
-* Updates the main menu displaying the selected menu item in accordance with the
-* movement of the rotary encoder. Before and after the selected menu item are
-* also displayed the previous and next menu items.
+* Encoder task, run every ROTARY_INTERVAL: takes in the detents queued by
+* the encoder interrupts and passes them on to the display task, all those
+* read in one run as a single movement.
 * args: none
 * return: none
 */
-void updateMainMenu(){
-  //TODO update the main menu in accordance with the movement of the rotary
-  //encoder displaying the menu items.
-
-  //TEMPORARY CODE
-  Serial.println(previousMenuItem().name);
-  Serial.print("> ");
-  Serial.println(currentMenuItem().name);
-  Serial.println(nextMenuItem().name);
-  Serial.println("\n");
+void handleRotaryEncoder(){
+  int8_t detents;
+  int moved = 0;
+  while(encoder.read(&detents)) moved += detents;
+  if(moved) queueInput(INPUT_ENCODER, constrain(moved, -127, 127));
 }
 
 /**
-* This method handles the behaviour of the rotary encoder detecting the rotation
-* direction and calling for updating the main menu.
-* args: none
+* Executes what is necessary when the encoder is turned: moves the menu by
+* the detents, clockwise forward. A movement with the display off only
+* turns it on, and with the menu closed only opens it.
+* args: detents: signed detents turned
 * return: none
 */
-void handleRotaryEncoder(){
-  while(rotating){
-    delay(ROTARY_DELAY);
-    if (digitalRead(ROTARY_B_PIN) == digitalRead(ROTARY_B_PIN)){
-      if(!rotaryFlag){
-        //CW
-        rotaryFlag = true;
-
-        if(isDisplayOn()){
-          moveMenuIndexForward();
-          updateMainMenu();
-        }
-        else turnOnDisplay();
-      }
-      else rotaryFlag = false;
-    }
-    else{
-      if(!rotaryFlag){
-        //CCW
-        rotaryFlag = true;
-
-        if(isDisplayOn()){
-          moveMenuIndexBackward();
-          updateMainMenu();
-        }
-        else turnOnDisplay();
-      }
-      else rotaryFlag = false;
-    }
-    rotating=false;
+void executeEncoderMove(int8_t detents){
+  if(isDisplayOn()){
+    if(historyShown) return;
+    if(menu.shown()) menu.move(detents);
+    else menu.open();
   }
+  else turnOnDisplay();
 }
 
 /**
-* Executes what is necessary when the Enter button is pressed. It depends on
-* the state of the menu.
+* Executes what is necessary when the Enter button is pressed: opens the
+* menu, or enters its selected entry.
 * args: none
 * return: none
 */
 void executeEnterButton(){
   if(isDisplayOn()){
-    //TEMPORARY CODE
-    Serial.print("Option: ");
-    Serial.println(mainMenu[menuIndex].name);
+    if(historyShown) return;
+    if(menu.shown()) menu.enter();
+    else menu.open();
   }
   else turnOnDisplay();
 }
 
 /**
-* Executes what is necessary when the Cancel button is pressed. It depends on
-* the state of the menu.
+* Executes what is necessary when the Cancel button is pressed: leaves the
+* history screen, or goes back one step in the menu.
 * args: none
 * return: none
 */
 void executeCancelButton(){
   if(isDisplayOn()){
-    //TODO
+    if(historyShown) hideHistoryScreen();
+    else if(menu.shown() && !menu.cancel()) closeMenu();
   }
   else turnOnDisplay();
 }
@@ -1019,116 +1265,141 @@ void executeShutOffButton(){
 }
 
 /**
-* Generic method to handle the pulsation of any button. The method receives the
-* button pin and executes the proper method.
-* args: int buttonPin - The button pin which has triggered this method.
+* The ISR method for the Enter button: only queues the edge for handleButtons
+* args: none
 * return: none
 */
-void handleButton(int buttonPin){
-  if (bounceState == WATCH_BUTTON) {
-    boolean currentButtonState = digitalRead(buttonPin);
-    if (previousButtonState != currentButtonState) {
-      bounceState = IGNORE_BUTTON;
-      previousMicros = micros();
-    }
-    previousButtonState = currentButtonState;
-  }
-  if (bounceState == IGNORE_BUTTON) {
-    unsigned long currentMicros = micros();
-    if ((unsigned long)(currentMicros - previousMicros) >= BUTTON_WAIT_INTERVAL) {
-      debouncedButtonState = digitalRead(buttonPin);
-      bounceState = WATCH_BUTTON;
-
-      switch(buttonPin){
-        case ENTER_BUTTON_PIN:
-          executeEnterButton();
-          break;
-        case CANCEL_BUTTON_PIN:
-          executeCancelButton();
-          break;
-      }
-    }
-  }
+void handleEnterButton() {
+  buttons.edge(ENTER_BUTTON);
 }
 
 /**
-* The ISR method for the Enter button
+* The ISR method for the Cancel button: only queues the edge for handleButtons
 * args: none
 * return: none
 */
-void handleEnterButton() {
-  handleButton(ENTER_BUTTON_PIN);
+void handleCancelButton(){
+  buttons.edge(CANCEL_BUTTON);
 }
 
 /**
-* The ISR method for the Cancel button
+* Buttons task, run every BUTTONS_INTERVAL: reads the shut-off button behind
+* the multiplexer, debounces the edges queued by the button interrupts and
+* passes the presses on to the display task.
 * args: none
 * return: none
 */
-void handleCancelButton(){
-  handleButton(CANCEL_BUTTON_PIN);
+void handleButtons(){
+  ButtonEvent event;
+  buttons.level(SHUTOFF_BUTTON, getMuxInputState(SHUTOFF_BUTTON_MUX_INPUT));
+  buttons.tick();
+  while(buttons.read(&event)){
+    if(event.type != BUTTON_PRESS) continue;
+    switch(event.button){
+      case ENTER_BUTTON:
+        queueInput(INPUT_ENTER);
+        break;
+      case CANCEL_BUTTON:
+        queueInput(INPUT_CANCEL);
+        break;
+      case SHUTOFF_BUTTON:
+        queueInput(INPUT_SHUTOFF);
+        break;
+    }
+  }
 }
 
 /**
-* INIT MODULES
+* INPUT METHODS
 **/
 
-void initMenuItems(){
-  menuIndex = 0;
-
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Set min. temperature";
-  menuIndex++;
-
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Set light intensity";
-  menuIndex++;
-
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Set date/time";
-  menuIndex++;
-
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Show heating time";
-  menuIndex++;
+/**
+* Queues an input for the display task and starts it. Detents join an
+* encoder movement still queued last; a press that finds the queue full is
+* dropped, which the display task, started with every input, never lets
+* happen in practice.
+* args: type: INPUT_*; detents: signed detents, for INPUT_ENCODER
+* return: none
+*/
+void queueInput(uint8_t type, int8_t detents){
+  uint8_t last = (inputHead - 1) & (INPUT_QUEUE_SIZE - 1);
+  if(type == INPUT_ENCODER && inputHead != inputTail && inputQueue[last].type == INPUT_ENCODER){
+    inputQueue[last].detents = constrain(inputQueue[last].detents + detents, -127, 127);
+  }
+  else if(((inputHead + 1) & (INPUT_QUEUE_SIZE - 1)) != inputTail){
+    inputQueue[inputHead].type = type;
+    inputQueue[inputHead].detents = detents;
+    inputHead = (inputHead + 1) & (INPUT_QUEUE_SIZE - 1);
+  }
+  scheduler.start(&displayTask);
+}
 
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Show lighting time";
-  menuIndex++;
+/**
+* Display task, started by the encoder and buttons tasks: acts on the
+* inputs they queued, opening, moving and closing the menu and the history
+* screen, so the repaints run here and not in the input tasks.
+* args: none
+* return: none
+*/
+void handleDisplay(){
+  while(inputTail != inputHead){
+    InputEvent event = inputQueue[inputTail];
+    inputTail = (inputTail + 1) & (INPUT_QUEUE_SIZE - 1);
+    switch(event.type){
+      case INPUT_ENCODER:
+        executeEncoderMove(event.detents);
+        break;
+      case INPUT_ENTER:
+        executeEnterButton();
+        break;
+      case INPUT_CANCEL:
+        executeCancelButton();
+        break;
+      case INPUT_SHUTOFF:
+        executeShutOffButton();
+        break;
+    }
+  }
+}
 
-  mainMenu[menuIndex].id = menuIndex;
-  mainMenu[menuIndex].name = "Turn off display";
-  menuIndex++;
+/**
+* INIT MODULES
+**/
 
-  menuIndex = 0;
+void initMenu(){
+  menu.begin(&mainMenu, 0, TEMP_SECTION_Y, TFT_WIDTH, TFT_HEIGHT-TEMP_SECTION_Y);
 }
 
 void initEnterButton(){
-  pinMode(ENTER_BUTTON_PIN, INPUT);
+  buttons.begin(ENTER_BUTTON, ENTER_BUTTON_PIN);
   attachInterrupt(
     digitalPinToInterrupt(ENTER_BUTTON_PIN),
     handleEnterButton,
-    LOW
+    CHANGE
   );
 }
 
 void initCancelButton(){
-  pinMode(CANCEL_BUTTON_PIN, INPUT);
+  buttons.begin(CANCEL_BUTTON, CANCEL_BUTTON_PIN);
   attachInterrupt(
     digitalPinToInterrupt(CANCEL_BUTTON_PIN),
     handleCancelButton,
-    LOW
+    CHANGE
   );
 }
 
 void initRotaryEncoder(){
-  pinMode(ROTARY_A_PIN, INPUT);
-  pinMode(ROTARY_B_PIN, INPUT);
+  encoder.begin(ROTARY_A_PIN, ROTARY_B_PIN);
   attachInterrupt(
     digitalPinToInterrupt(ROTARY_A_PIN),
     rotEncoder,
     CHANGE
   );
+  attachInterrupt(
+    digitalPinToInterrupt(ROTARY_B_PIN),
+    rotEncoder,
+    CHANGE
+  );
 }
 
 void initHeater(){
@@ -1137,12 +1408,27 @@ void initHeater(){
   heaterTotalSeconds = 0;
   millisSafeMode = 0;
 
-  //TODO
-  //Read the position of the Heater mode switch and act in consequence
+  readHeaterModeSwitch();
+}
+
+void initMultiplexer(){
+  muxScanner.begin(MULTIPLEXER_S0_PIN, MULTIPLEXER_S1_PIN, MULTIPLEXER_S2_PIN, MULTIPLEXER_Z_PIN);
+  //Timer 5 (PWM on pins 44-46, unused) in CTC mode at clk/8: 2 ticks per us
+  noInterrupts();
+  TCCR5A = 0;
+  TCCR5B = _BV(WGM52) | _BV(CS51);
+  TCNT5 = 0;
+  OCR5A = MULTIPLEXER_SCAN_US * 2 - 1;
+  TIMSK5 = _BV(OCIE5A);
+  interrupts();
 }
 
 void initTempHumSensor(){
-  lastTempLectureMillis = 0;
+  DHT.begin(TEMP_HUM_DIGITAL_SENSOR_PIN);
+  //Pin 15 is PJ0 / PCINT9, which the Mega core's digitalPinToPCICR() does
+  //not map, so its pin change interrupt is enabled by hand.
+  PCMSK1 |= _BV(PCINT9);
+  PCICR |= _BV(PCIE1);
 }
 
 void initRTC(){
@@ -1150,10 +1436,10 @@ void initRTC(){
   if(!rtc.initialized()){
     rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
   }
-  Datetime now = getDateTime();
-  hh = now.hour;
-  mm = now.minute;
-  ss = now.second;
+  rtcTime.begin(CLOCK_CLKOUT_PIN);
+  //A8 is PK0 / PCINT16
+  PCMSK2 |= _BV(PCINT16);
+  PCICR |= _BV(PCIE2);
 }
 
 void initDisplay(){
@@ -1188,6 +1474,34 @@ void initDisplay(){
   tft.fillScreen(TFT_BLACK);
   tft.setTextColor(TFT_DEBUG);
   setBrightness(100);
+  temperatureChart.setRange(HISTORY_CHART_MIN_TEMP, HISTORY_CHART_MAX_TEMP);
+  clockCanvas.setFont(&FreeMonoBold24pt7bRLE);
+  clockCanvas.setTextColor(1);
+  clockCanvas.setTextWrap(false);
+}
+
+/**
+* Adds the tasks in priority order and starts them.
+*/
+void initScheduler(){
+  scheduler.add(&rotaryTask);
+  scheduler.add(&buttonsTask);
+  scheduler.add(&displayTask);
+  scheduler.add(&tempHumPollTask);
+  scheduler.add(&tempHumRequestTask);
+  scheduler.add(&heaterTask);
+  scheduler.add(&rtcTask);
+  scheduler.add(&clockTask);
+  scheduler.add(&logTask);
+
+  scheduler.start(&rotaryTask);
+  scheduler.start(&buttonsTask);
+  scheduler.start(&tempHumPollTask);
+  scheduler.start(&tempHumRequestTask);
+  scheduler.start(&heaterTask);
+  scheduler.start(&rtcTask);
+  scheduler.start(&clockTask);
+  scheduler.start(&logTask);
 }
 
 /**
@@ -1197,27 +1511,28 @@ void initDisplay(){
 void setup()
 {
   Serial.begin(9600);
-  Serial.println("INIT");
+  Serial.println(F("INIT"));
 
   initDisplay();
   //tft.setCursor(200, 10);
   //tft.print("DISPLAY: INIT DONE");
-  //initMenuItems();
+  initMenu();
   //tft.setCursor(200, 40);
   //tft.print("MENU: INIT DONE");
-  //initRotaryEncoder();
+  initMultiplexer();
+  initRotaryEncoder();
   //tft.setCursor(200, 60);
   //tft.print("ROTARY ENCODER: INIT DONE");
-  //initEnterButton();
+  initEnterButton();
   //tft.setCursor(200, 80);
   //tft.print("ENTER BUTTON: SET DONE");
-  //initCancelButton();
+  initCancelButton();
   //tft.setCursor(200, 100);
   //tft.print("CANCEL BUTTON: SET DONE");
-  //initHeater();
+  initHeater();
   //tft.setCursor(200, 120);
   //tft.print("HEATER: INIT DONE");
-  //initTempHumSensor();
+  initTempHumSensor();
   //tft.setCursor(200, 140);
   //tft.print("TEMP / HUM SENSOR: INIT DONE");
   initRTC();
@@ -1229,19 +1544,16 @@ void setup()
 
   updateScreenDate();
   updateMainScreen();
+
+  initScheduler();
 }
 
 void loop()
 {
-  //long now = millis();
-
-  //handleRotaryEncoder();
-  //handleTempHumSensor(now);
-  //handleHeater();
-  updateScreenClock();
+  scheduler.run();
 
   /*tft.drawFastVLine(104, 0, 320, 0xFFFF);
-  tft.setFont(&FreeMonoBold24pt7b);
+  tft.setFont(&FreeMonoBold24pt7bRLE);
   tft.setCursor(100, 140);
   tft.setTextColor(0xFFFF);
   tft.print("0");*/
@@ -0,0 +1,168 @@
+/*
+DomoHedgie event log decoder.
+
+Reads what the board sends on its serial port (a capture file, or stdin)
+and prints it with every EventLog frame turned back into the text line the
+sketch printed before the binary log, e.g.
+  HEATER15/1/2017 12:34:51;AUTO#ON#0.00
+Bytes outside frames (plain Serial.print output) are copied through.
+
+  ./logdecode serial.log
+  cat /dev/ttyACM0 | ./logdecode
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../lib/EventLog/EventLogFormat.h"
+#include "../src/DomoHedgie_events.h"
+
+typedef struct {
+  int year, month, day, hour, minute, second;
+} datetime;
+
+static datetime toDatetime(uint32_t t) {
+  // Days since 1970-01-01 to civil date (proleptic Gregorian)
+  datetime d;
+  long     days = t / 86400L, rem = t % 86400L;
+  d.hour   = rem / 3600;
+  d.minute = (rem / 60) % 60;
+  d.second = rem % 60;
+
+  long z = days + 719468L, era = z / 146097L;
+  long doe = z - era * 146097L;
+  long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  long mp  = (5 * doy + 2) / 153;
+  d.day    = doy - (153 * mp + 2) / 5 + 1;
+  d.month  = mp < 10 ? mp + 3 : mp - 9;
+  d.year   = yoe + era * 400 + (d.month <= 2);
+  return d;
+}
+
+// Line prefix as logMessage() built it: "<SYSTEM>d/m/yyyy h:m:s;"
+static void prefix(FILE *out, const char *system, uint32_t t) {
+  datetime d = toDatetime(t);
+  fprintf(out, "%s%d/%d/%d %d:%d:%d;", system, d.day, d.month, d.year,
+   d.hour, d.minute, d.second);
+}
+
+// As datetimeToString(): "dd/mm/yyyy hh:mm:ss"
+static void timestamp(FILE *out, uint32_t t) {
+  datetime d = toDatetime(t);
+  fprintf(out, "%02d/%02d/%d %02d:%02d:%02d", d.day, d.month, d.year,
+   d.hour, d.minute, d.second);
+}
+
+static const char *heaterMode(uint16_t mode) {
+  switch(mode) {
+    case 1: return "AUTO"; // HEATER_MODE_AUTO
+    case 2: return "OFF";  // HEATER_MODE_OFF
+    case 3: return "ON";   // HEATER_MODE_ON
+  }
+  return "";
+}
+
+static void render(FILE *out, const LogEvent *e) {
+  switch(e->system) {
+    case EVENT_LOG_SYSTEM:
+      prefix(out, "LOG", e->time);
+      if(e->code == EVENT_LOG_DROPPED) {
+        fprintf(out, "%lu events dropped", (unsigned long)e->value);
+        break;
+      }
+      fprintf(out, "event %u", e->code);
+      break;
+
+    case LOG_HEATER:
+      prefix(out, "HEATER", e->time);
+      fprintf(out, "%s#%s#%lu.00", heaterMode(e->arg),
+       e->code == EVENT_HEATER_ON ? "ON" : "OFF", (unsigned long)e->value);
+      break;
+
+    case LOG_TEMP_HUM:
+      prefix(out, "TEMP/HUM", e->time);
+      switch(e->code) {
+        case EVENT_TEMP_HUM_TIMEOUT  : fputs("Timeout error occured", out);  break;
+        case EVENT_TEMP_HUM_CHECKSUM : fputs("Checksum error occured", out); break;
+        case EVENT_TEMP_HUM_SAFE_MODE: fputs("Safe mode activated", out);    break;
+        default: fprintf(out, "event %u", e->code);
+      }
+      break;
+
+    case LOG_RTC:
+      prefix(out, "RTC", e->time);
+      if(e->code == EVENT_RTC_ADJUSTED) {
+        fputs("Date and time changed from \"", out);
+        timestamp(out, e->value);
+        fputs("\" to \"", out);
+        timestamp(out, e->time);
+        fputs("\"", out);
+        break;
+      }
+      fprintf(out, "event %u", e->code);
+      break;
+
+    default:
+      fprintf(out, "SYSTEM%u ", e->system);
+      prefix(out, "", e->time);
+      fprintf(out, "event %u %u %lu", e->code, e->arg, (unsigned long)e->value);
+  }
+  fputs("\r\n", out);
+}
+
+static uint32_t le(const uint8_t *b, int n) {
+  uint32_t v = 0;
+  while(n--) v = (v << 8) | b[n];
+  return v;
+}
+
+int main(int argc, char *argv[]) {
+  FILE   *in = stdin;
+  uint8_t buf[EVENT_LOG_FRAME_SIZE];
+  int     n = 0, c;
+
+  if(argc > 2) {
+    fprintf(stderr, "Usage: %s [capture]\n", argv[0]);
+    return 1;
+  }
+  if((argc == 2) && !(in = fopen(argv[1], "rb"))) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // Keep up to one frame's worth of bytes; whenever they can't start a
+  // frame, pass the first one through and look again from the next.
+  while((c = fgetc(in)) != EOF) {
+    buf[n++] = c;
+    for(;;) {
+      int bad = (buf[0] != EVENT_LOG_SYNC0) ||
+                ((n > 1) && (buf[1] != EVENT_LOG_SYNC1));
+      if(!bad && (n == EVENT_LOG_FRAME_SIZE)) {
+        uint8_t sum = 0;
+        for(int i=2; i<2+EVENT_LOG_RECORD_SIZE; i++) sum += buf[i];
+        if(sum == buf[EVENT_LOG_FRAME_SIZE - 1]) {
+          const uint8_t *r = buf + 2;
+          LogEvent e;
+          e.time   = le(r, 4);
+          e.system = r[4];
+          e.code   = r[5];
+          e.arg    = le(r + 6, 2);
+          e.value  = le(r + 8, 4);
+          render(stdout, &e);
+          n = 0;
+          break;
+        }
+        bad = 1;
+      }
+      if(!bad) break;
+      fputc(buf[0], stdout);
+      for(int i=1; i<n; i++) buf[i-1] = buf[i];
+      if(!--n) break;
+    }
+  }
+  fwrite(buf, 1, n, stdout);
+
+  if(in != stdin) fclose(in);
+  return 0;
+}